@@ -0,0 +1,261 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gauge/gauge.hpp>
+#include <gauge/console_printer.hpp>
+#include <gauge/python_printer.hpp>
+#include <gauge/csv_printer.hpp>
+#include <gauge/json_printer.hpp>
+
+#include <kodo/rlnc/full_rlnc_codes.hpp>
+
+#include <tables/table.hpp>
+
+/// Measures the latency of building a coder from a pool_factory,
+/// i.e. pool_factory::build() including layer::initialize(), and of
+/// releasing it again, for a mix of generation sizes. The factories
+/// are sized for the largest generation as in an application where
+/// most flows use small generations.
+template<class Encoder, class Decoder>
+struct build_latency_benchmark : public gauge::time_benchmark
+{
+
+    typedef typename Encoder::factory encoder_factory;
+    typedef typename Encoder::factory::pointer encoder_ptr;
+
+    typedef typename Decoder::factory decoder_factory;
+    typedef typename Decoder::factory::pointer decoder_ptr;
+
+    double measurement()
+    {
+        // Get the time spent per iteration
+        double time = gauge::time_benchmark::measurement();
+
+        // The time per build
+        return time / m_generations.size();
+    }
+
+    void store_run(tables::table& results)
+    {
+        if (!results.has_column("latency"))
+            results.add_column("latency");
+
+        results.set_value("latency", measurement());
+    }
+
+    std::string unit_text() const
+    {
+        return "us";
+    }
+
+    void get_options(gauge::po::variables_map& options)
+    {
+        auto symbols = options["symbols"].as<std::vector<uint32_t> >();
+        auto symbol_size = options["symbol_size"].as<std::vector<uint32_t> >();
+        auto types = options["type"].as<std::vector<std::string> >();
+
+        assert(symbols.size() > 0);
+        assert(symbol_size.size() > 0);
+        assert(types.size() > 0);
+
+        m_symbols = symbols;
+        m_builds = options["builds"].as<uint32_t>();
+        assert(m_builds > 0);
+
+        m_max_symbols = *std::max_element(symbols.begin(), symbols.end());
+
+        // Each configuration builds coders for the whole mix of
+        // generation sizes
+        for (uint32_t j = 0; j < symbol_size.size(); ++j)
+        {
+            for (uint32_t u = 0; u < types.size(); ++u)
+            {
+                gauge::config_set cs;
+                cs.set_value<uint32_t>("symbol_size", symbol_size[j]);
+                cs.set_value<std::string>("type", types[u]);
+
+                add_configuration(cs);
+            }
+        }
+    }
+
+    void setup()
+    {
+        gauge::config_set cs = get_current_configuration();
+
+        uint32_t symbol_size = cs.get_value<uint32_t>("symbol_size");
+
+        m_encoder_factory = std::make_shared<encoder_factory>(
+            m_max_symbols, symbol_size);
+
+        m_decoder_factory = std::make_shared<decoder_factory>(
+            m_max_symbols, symbol_size);
+
+        // Draw the generation sizes up front, with a fixed seed so
+        // that all the benchmarks use the same sequence
+        std::mt19937 engine(0);
+        std::uniform_int_distribution<uint32_t> pick(
+            0, (uint32_t) m_symbols.size() - 1);
+
+        m_generations.resize(m_builds);
+
+        for (auto& generation : m_generations)
+        {
+            generation = m_symbols[pick(engine)];
+        }
+    }
+
+    /// Builds and releases a coder for each generation
+    template<class Factory>
+    void build_generations(Factory& factory)
+    {
+        for (uint32_t symbols : m_generations)
+        {
+            factory.set_symbols(symbols);
+
+            auto coder = factory.build();
+            assert(coder->symbols() == symbols);
+        }
+    }
+
+    void run_benchmark()
+    {
+        gauge::config_set cs = get_current_configuration();
+
+        std::string type = cs.get_value<std::string>("type");
+
+        // Build every generation once so that the pools are filled
+        // before the clock is running
+        if (type == "encoder")
+        {
+            build_generations(*m_encoder_factory);
+
+            RUN
+            {
+                build_generations(*m_encoder_factory);
+            }
+        }
+        else if (type == "decoder")
+        {
+            build_generations(*m_decoder_factory);
+
+            RUN
+            {
+                build_generations(*m_decoder_factory);
+            }
+        }
+        else
+        {
+            assert(0);
+        }
+    }
+
+protected:
+
+    /// The generation sizes to mix
+    std::vector<uint32_t> m_symbols;
+
+    /// The number of builds per iteration
+    uint32_t m_builds;
+
+    /// The largest generation size, used as the maximum of the
+    /// factories
+    uint32_t m_max_symbols;
+
+    /// The generation size of each build
+    std::vector<uint32_t> m_generations;
+
+    /// The encoder factory
+    std::shared_ptr<encoder_factory> m_encoder_factory;
+
+    /// The decoder factory
+    std::shared_ptr<decoder_factory> m_decoder_factory;
+};
+
+/// Using this macro we may specify options. For specifying options
+/// we use the boost program options library. So you may additional
+/// details on how to do it in the manual for that library.
+BENCHMARK_OPTION(build_latency_options)
+{
+    gauge::po::options_description options;
+
+    std::vector<uint32_t> symbols;
+    symbols.push_back(16);
+    symbols.push_back(32);
+    symbols.push_back(64);
+    symbols.push_back(1024);
+
+    auto default_symbols =
+        gauge::po::value<std::vector<uint32_t> >()->default_value(
+            symbols, "")->multitoken();
+
+    std::vector<uint32_t> symbol_size;
+    symbol_size.push_back(1500);
+
+    auto default_symbol_size =
+        gauge::po::value<std::vector<uint32_t> >()->default_value(
+            symbol_size, "")->multitoken();
+
+    std::vector<std::string> types;
+    types.push_back("encoder");
+    types.push_back("decoder");
+
+    auto default_types =
+        gauge::po::value<std::vector<std::string> >()->default_value(
+            types, "")->multitoken();
+
+    options.add_options()
+        ("symbols", default_symbols,
+         "Set the generation sizes to mix, the largest is the maximum "
+         "number of symbols of the factories");
+
+    options.add_options()
+        ("symbol_size", default_symbol_size, "Set the symbol size in bytes");
+
+    options.add_options()
+        ("type", default_types, "Set type [encoder|decoder]");
+
+    options.add_options()
+        ("builds", gauge::po::value<uint32_t>()->default_value(1000),
+         "Set the number of builds per iteration");
+
+    gauge::runner::instance().register_options(options);
+}
+
+typedef build_latency_benchmark<
+    kodo::full_rlnc_encoder<fifi::binary8>,
+    kodo::full_rlnc_decoder<fifi::binary8> > setup_rlnc_build_latency8;
+
+BENCHMARK_F(setup_rlnc_build_latency8, FullRLNC, Binary8, 5)
+{
+    run_benchmark();
+}
+
+typedef build_latency_benchmark<
+    kodo::shallow_full_rlnc_encoder<fifi::binary8>,
+    kodo::shallow_full_rlnc_decoder<fifi::binary8> >
+    setup_shallow_rlnc_build_latency8;
+
+BENCHMARK_F(setup_shallow_rlnc_build_latency8, ShallowFullRLNC, Binary8, 5)
+{
+    run_benchmark();
+}
+
+int main(int argc, const char* argv[])
+{
+    srand(static_cast<uint32_t>(time(0)));
+
+    gauge::runner::add_default_printers();
+    gauge::runner::run_benchmarks(argc, argv);
+
+    return 0;
+}
@@ -92,6 +92,11 @@ public:
             results.add_column("invert(value)");
 
         results.set_value("invert(value)", m_counter.m_invert);
+
+        if(!results.has_column("bytes saved"))
+            results.add_column("bytes saved");
+
+        results.set_value("bytes saved", m_counter.m_bytes_saved);
     }
 
 
@@ -118,6 +123,9 @@ public:
         m_encoder = m_encoder_factory->build();
         m_decoder = m_decoder_factory->build();
 
+        m_decoder->set_deferred_substitution(
+            cs.get_value<bool>("deferred_substitution"));
+
         m_payload_buffer.resize(m_encoder->payload_size(), 0);
         m_encoded_data.resize(m_encoder->block_size(), 'x');
 
@@ -158,6 +166,7 @@ public:
         auto symbols = options["symbols"].as<std::vector<uint32_t> >();
         auto symbol_size = options["symbol_size"].as<std::vector<uint32_t> >();
         auto types = options["type"].as<std::vector<std::string> >();
+        auto deferred = options["deferred_substitution"].as<bool>();
 
         assert(symbols.size() > 0);
         assert(symbol_size.size() > 0);
@@ -173,6 +182,7 @@ public:
                     cs.set_value<uint32_t>("symbols", symbols[i]);
                     cs.set_value<uint32_t>("symbol_size", symbol_size[j]);
                     cs.set_value<std::string>("type", types[u]);
+                    cs.set_value<bool>("deferred_substitution", deferred);
 
                     add_configuration(cs);
                 }
@@ -252,6 +262,10 @@ BENCHMARK_OPTION(count_operations_options)
     options.add_options()
         ("type", default_types, "Set type [encoder|decoder]");
 
+    options.add_options()
+        ("deferred_substitution", gauge::po::bool_switch(),
+         "Defer the decoder symbol operations until a pivot is found");
+
     gauge::runner::instance().register_options(options);
 }
 
@@ -3,6 +3,7 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <algorithm>
 #include <ctime>
 
 #include <boost/make_shared.hpp>
@@ -16,6 +17,9 @@
 #include <kodo/has_systematic_encoder.hpp>
 #include <kodo/set_systematic_off.hpp>
 #include <kodo/rlnc/full_rlnc_codes.hpp>
+#include <kodo/rlnc/seed_rlnc_codes.hpp>
+#include <kodo/rlnc/shallow_threaded_full_rlnc_encoder.hpp>
+#include <kodo/rlnc/shallow_threaded_full_rlnc_decoder.hpp>
 
 #include <fifi/is_prime2325.hpp>
 #include <fifi/prime2325_binary_search.hpp>
@@ -128,10 +132,12 @@ struct throughput_benchmark : public gauge::time_benchmark
         auto symbols = options["symbols"].as<std::vector<uint32_t> >();
         auto symbol_size = options["symbol_size"].as<std::vector<uint32_t> >();
         auto types = options["type"].as<std::vector<std::string> >();
+        auto batch_size = options["batch_size"].as<std::vector<uint32_t> >();
 
         assert(symbols.size() > 0);
         assert(symbol_size.size() > 0);
         assert(types.size() > 0);
+        assert(batch_size.size() > 0);
 
         for (uint32_t i = 0; i < symbols.size(); ++i)
         {
@@ -139,12 +145,17 @@ struct throughput_benchmark : public gauge::time_benchmark
             {
                 for (uint32_t u = 0; u < types.size(); ++u)
                 {
-                    gauge::config_set cs;
-                    cs.set_value<uint32_t>("symbols", symbols[i]);
-                    cs.set_value<uint32_t>("symbol_size", symbol_size[j]);
-                    cs.set_value<std::string>("type", types[u]);
+                    for (uint32_t b = 0; b < batch_size.size(); ++b)
+                    {
+
+                        gauge::config_set cs;
+                        cs.set_value<uint32_t>("symbols", symbols[i]);
+                        cs.set_value<uint32_t>("symbol_size", symbol_size[j]);
+                        cs.set_value<std::string>("type", types[u]);
+                        cs.set_value<uint32_t>("batch_size", batch_size[b]);
 
-                    add_configuration(cs);
+                        add_configuration(cs);
+                    }
                 }
             }
         }
@@ -156,6 +167,8 @@ struct throughput_benchmark : public gauge::time_benchmark
 
         uint32_t symbols = cs.get_value<uint32_t>("symbols");
         uint32_t symbol_size = cs.get_value<uint32_t>("symbol_size");
+        uint32_t batch_size = cs.get_value<uint32_t>("batch_size");
+        assert(batch_size > 0);
 
         /// @todo Research the cause of this
         // Make the factories fit perfectly otherwise there seems to
@@ -192,8 +205,15 @@ struct throughput_benchmark : public gauge::time_benchmark
         // initialized by m_data_out)
         m_decoder->set_symbols(sak::storage(m_data_out));
 
-        // Create the payload buffer
-        m_temp_payload.resize(m_decoder->payload_size());
+        // Create the payload buffers, one for each payload in a batch
+        m_temp_payloads.resize(batch_size);
+        for (auto& temp_payload : m_temp_payloads)
+        {
+            temp_payload.resize(m_decoder->payload_size());
+        }
+
+        m_batch.resize(batch_size);
+        m_encode_batch.resize(batch_size);
 
         // Prepare storage to the encoded payloads
         uint32_t payload_count = symbols * m_factor;
@@ -231,10 +251,30 @@ struct throughput_benchmark : public gauge::time_benchmark
         if (kodo::has_systematic_encoder<Encoder>::value)
             kodo::set_systematic_off(m_encoder);
 
-        for (auto& payload : m_payloads)
+        uint32_t batch_size = static_cast<uint32_t>(m_batch.size());
+        uint32_t payload_count = static_cast<uint32_t>(m_payloads.size());
+
+        for (uint32_t i = 0; i < payload_count; i += batch_size)
         {
-            m_encoder->encode(payload.data());
-            ++m_encoded_symbols;
+            uint32_t count = std::min(batch_size, payload_count - i);
+
+            // A batch size of one uses the ordinary encode() so that
+            // it can be compared directly to the batched encoding
+            if (batch_size == 1)
+            {
+                m_encoder->encode(m_payloads[i].data());
+            }
+            else
+            {
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    m_encode_batch[j] = m_payloads[i + j].data();
+                }
+
+                m_encoder->encode_batch(m_encode_batch.data(), count, 0);
+            }
+
+            m_encoded_symbols += count;
         }
 
         /// @todo Revert to the original input data by re-applying the
@@ -258,23 +298,41 @@ struct throughput_benchmark : public gauge::time_benchmark
 
     void decode_payloads()
     {
-        for (const auto& payload : m_payloads)
+        uint32_t batch_size = static_cast<uint32_t>(m_temp_payloads.size());
+        uint32_t payload_count = static_cast<uint32_t>(m_payloads.size());
+
+        for (uint32_t i = 0; i < payload_count; i += batch_size)
         {
+            uint32_t count = std::min(batch_size, payload_count - i);
+
+            // A batch size of one uses the ordinary decode() so that
+            // it can be compared directly to the batched decoding. The
+            // const decode() leaves the payload unchanged, so it can
+            // be decoded again in the next iteration.
+            if (batch_size == 1)
+            {
+                const uint8_t* payload = m_payloads[i].data();
+                m_decoder->decode(payload);
+            }
+            else
+            {
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    const auto& payload = m_payloads[i + j];
 
-            /// @todo This copy would typically not be performed by an
-            /// actual application, however since the benchmark
-            /// performs several iterations decoding the same data we
-            /// have to copy the input data to avoid corrupting
-            /// it. The decoder works on data "in-place" therefore we
-            /// would corrupt the payloads if we did not copy them.
-            ///
-            /// Changing this would most likely improve the throughput
-            /// of the decoders. We are open to suggestions :)
-            std::copy_n(payload.data(), payload.size(), m_temp_payload.data());
+                    /// The decoder works on the batched payloads
+                    /// "in-place", so we copy them to avoid corrupting
+                    /// the payloads used in the next iteration.
+                    std::copy_n(payload.data(), payload.size(),
+                                m_temp_payloads[j].data());
 
-            m_decoder->decode(m_temp_payload.data());
+                    m_batch[j] = m_temp_payloads[j].data();
+                }
+
+                m_decoder->decode_batch(m_batch.data(), count);
+            }
 
-            ++m_decoded_symbols;
+            m_decoded_symbols += count;
 
             if (m_decoder->is_complete())
             {
@@ -395,7 +453,15 @@ protected:
     /// to run multiple iterations with the same encoded paylaods we
     /// have to copy them before injecting them into the decoder. This
     /// of course has a negative impact on the decoding throughput.
-    std::vector<uint8_t> m_temp_payload;
+    /// There is one buffer for each payload in a decode batch, a batch
+    /// size of one uses the const decode() instead.
+    std::vector< std::vector<uint8_t> > m_temp_payloads;
+
+    /// Pointers to the payload buffers passed to decode_batch()
+    std::vector<uint8_t*> m_batch;
+
+    /// Pointers to the payload buffers passed to encode_batch()
+    std::vector<uint8_t*> m_encode_batch;
 
     /// Storage for encoded symbols
     std::vector< std::vector<uint8_t> > m_payloads;
@@ -430,11 +496,13 @@ public:
         auto symbol_size = options["symbol_size"].as<std::vector<uint32_t> >();
         auto types = options["type"].as<std::vector<std::string> >();
         auto density = options["density"].as<std::vector<double> >();
+        auto batch_size = options["batch_size"].as<std::vector<uint32_t> >();
 
         assert(symbols.size() > 0);
         assert(symbol_size.size() > 0);
         assert(types.size() > 0);
         assert(density.size() > 0);
+        assert(batch_size.size() > 0);
 
         for (const auto& s : symbols)
         {
@@ -444,15 +512,20 @@ public:
                 {
                     for (const auto& d: density)
                     {
-                        gauge::config_set cs;
-                        cs.set_value<uint32_t>("symbols", s);
-                        cs.set_value<uint32_t>("symbol_size", p);
-                        cs.set_value<std::string>("type", t);
+                        for (uint32_t b = 0; b < batch_size.size(); ++b)
+                        {
+
+                            gauge::config_set cs;
+                            cs.set_value<uint32_t>("symbols", s);
+                            cs.set_value<uint32_t>("symbol_size", p);
+                            cs.set_value<std::string>("type", t);
+                            cs.set_value<uint32_t>("batch_size", batch_size[b]);
 
-                        // Add the calculated density easier output usage
-                        cs.set_value<double>("density", d);
+                            // Add the calculated density easier output usage
+                            cs.set_value<double>("density", d);
 
-                        Super::add_configuration(cs);
+                            Super::add_configuration(cs);
+                        }
                     }
                 }
             }
@@ -470,6 +543,142 @@ public:
 };
 
 
+/// A benchmark for the threaded encoder and decoder pairs, which adds
+/// the number of threads as a configuration option
+template<class Encoder, class Decoder>
+struct threaded_throughput_benchmark :
+    public throughput_benchmark<Encoder,Decoder>
+{
+public:
+
+    /// The type of the base benchmark
+    typedef throughput_benchmark<Encoder,Decoder> Super;
+
+    /// We need access to the factories to set the number of threads
+    using Super::m_encoder_factory;
+    using Super::m_decoder_factory;
+
+public:
+
+    void get_options(gauge::po::variables_map& options)
+    {
+        auto symbols = options["symbols"].as<std::vector<uint32_t> >();
+        auto symbol_size = options["symbol_size"].as<std::vector<uint32_t> >();
+        auto types = options["type"].as<std::vector<std::string> >();
+        auto batch_size = options["batch_size"].as<std::vector<uint32_t> >();
+        auto threads = options["threads"].as<std::vector<uint32_t> >();
+
+        assert(symbols.size() > 0);
+        assert(symbol_size.size() > 0);
+        assert(types.size() > 0);
+        assert(batch_size.size() > 0);
+        assert(threads.size() > 0);
+
+        for (const auto& s : symbols)
+        {
+            for (const auto& p : symbol_size)
+            {
+                for (const auto& t : types)
+                {
+                    for (const auto& n : threads)
+                    {
+                        for (uint32_t b = 0; b < batch_size.size(); ++b)
+                        {
+
+                            gauge::config_set cs;
+                            cs.set_value<uint32_t>("symbols", s);
+                            cs.set_value<uint32_t>("symbol_size", p);
+                            cs.set_value<std::string>("type", t);
+                            cs.set_value<uint32_t>("batch_size", batch_size[b]);
+                            cs.set_value<uint32_t>("threads", n);
+
+                            Super::add_configuration(cs);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void setup()
+    {
+        Super::setup();
+
+        gauge::config_set cs = Super::get_current_configuration();
+        uint32_t threads = cs.get_value<uint32_t>("threads");
+
+        // The coders pick up the thread pool when they are initialized
+        // at the start of every iteration
+        m_encoder_factory->set_threads(threads);
+        m_decoder_factory->set_threads(threads);
+    }
+};
+
+
+
+/// A benchmark comparing the blocked final backward substitution of
+/// the delayed decoder with the substitution of one row at a time
+template<class Encoder, class Decoder>
+struct delayed_throughput_benchmark :
+    public throughput_benchmark<Encoder,Decoder>
+{
+public:
+
+    /// The type of the base benchmark
+    typedef throughput_benchmark<Encoder,Decoder> Super;
+
+    /// We need access to the decoder to select the substitution
+    using Super::m_decoder;
+
+public:
+
+    void get_options(gauge::po::variables_map& options)
+    {
+        auto symbols = options["symbols"].as<std::vector<uint32_t> >();
+        auto symbol_size =
+            options["delayed_symbol_size"].as<std::vector<uint32_t> >();
+        auto substitution =
+            options["substitution"].as<std::vector<std::string> >();
+
+        assert(symbols.size() > 0);
+        assert(symbol_size.size() > 0);
+        assert(substitution.size() > 0);
+
+        for (const auto& s : symbols)
+        {
+            for (const auto& p : symbol_size)
+            {
+                for (const auto& b : substitution)
+                {
+                    gauge::config_set cs;
+                    cs.set_value<uint32_t>("symbols", s);
+                    cs.set_value<uint32_t>("symbol_size", p);
+                    cs.set_value<std::string>("type", "decoder");
+                    cs.set_value<uint32_t>("batch_size", 1);
+                    cs.set_value<std::string>("substitution", b);
+
+                    Super::add_configuration(cs);
+                }
+            }
+        }
+    }
+
+    void setup()
+    {
+        Super::setup();
+
+        gauge::config_set cs = Super::get_current_configuration();
+        std::string substitution = cs.get_value<std::string>("substitution");
+
+        assert(substitution == "blocked" || substitution == "rows");
+
+        // The setting is kept when the decoder is initialized at the
+        // start of every iteration
+        m_decoder->set_blocked_backward_substitution(
+            substitution == "blocked");
+    }
+};
+
 
 /// Using this macro we may specify options. For specifying options
 /// we use the boost program options library. So you may additional
@@ -511,9 +720,66 @@ BENCHMARK_OPTION(throughput_options)
     options.add_options()
         ("symbol_size", default_symbol_size, "Set the symbol size in bytes");
 
+    std::vector<uint32_t> batch_size;
+    batch_size.push_back(1);
+
+    auto default_batch_size =
+        gauge::po::value<std::vector<uint32_t> >()->default_value(
+            batch_size, "")->multitoken();
+
     options.add_options()
         ("type", default_types, "Set type [encoder|decoder]");
 
+    options.add_options()
+        ("batch_size", default_batch_size,
+         "Set the number of payloads encoded or decoded in one batch");
+
+    std::vector<uint32_t> threads;
+    threads.push_back(1);
+
+    auto default_threads =
+        gauge::po::value<std::vector<uint32_t> >()->default_value(
+            threads, "")->multitoken();
+
+    options.add_options()
+        ("threads", default_threads,
+         "Set the number of threads used by the threaded coders");
+
+    gauge::runner::instance().register_options(options);
+}
+
+BENCHMARK_OPTION(delayed_options)
+{
+    gauge::po::options_description options;
+
+    // From 1 KB to 64 KB
+    std::vector<uint32_t> symbol_size;
+    for (uint32_t size = 1024; size <= 65536; size *= 2)
+    {
+        symbol_size.push_back(size);
+    }
+
+    auto default_symbol_size =
+        gauge::po::value<std::vector<uint32_t> >()->default_value(
+            symbol_size, "")->multitoken();
+
+    std::vector<std::string> substitution;
+    substitution.push_back("blocked");
+    substitution.push_back("rows");
+
+    auto default_substitution =
+        gauge::po::value<std::vector<std::string> >()->default_value(
+            substitution, "")->multitoken();
+
+    options.add_options()
+        ("delayed_symbol_size", default_symbol_size,
+         "Set the symbol sizes in bytes used by the DelayedRLNC benchmarks");
+
+    options.add_options()
+        ("substitution", default_substitution,
+         "Set the final backward substitution of the DelayedRLNC "
+         "benchmarks [blocked|rows]");
+
     gauge::runner::instance().register_options(options);
 }
 
@@ -665,6 +931,41 @@ BENCHMARK_F(setup_delayed_rlnc_throughput2325, FullDelayedRLNC, Prime2325, 5)
    run_benchmark();
 }
 
+//------------------------------------------------------------------
+// Shallow DelayedRLNC, blocked against row by row final backward
+// substitution
+//------------------------------------------------------------------
+
+typedef delayed_throughput_benchmark<
+   kodo::shallow_full_rlnc_encoder<fifi::binary>,
+   kodo::shallow_delayed_full_rlnc_decoder<fifi::binary> >
+   setup_delayed_substitution_throughput;
+
+BENCHMARK_F(setup_delayed_substitution_throughput, DelayedRLNC, Binary, 5)
+{
+   run_benchmark();
+}
+
+typedef delayed_throughput_benchmark<
+   kodo::shallow_full_rlnc_encoder<fifi::binary8>,
+   kodo::shallow_delayed_full_rlnc_decoder<fifi::binary8> >
+   setup_delayed_substitution_throughput8;
+
+BENCHMARK_F(setup_delayed_substitution_throughput8, DelayedRLNC, Binary8, 5)
+{
+   run_benchmark();
+}
+
+typedef delayed_throughput_benchmark<
+   kodo::shallow_full_rlnc_encoder<fifi::binary16>,
+   kodo::shallow_delayed_full_rlnc_decoder<fifi::binary16> >
+   setup_delayed_substitution_throughput16;
+
+BENCHMARK_F(setup_delayed_substitution_throughput16, DelayedRLNC, Binary16, 5)
+{
+   run_benchmark();
+}
+
 //------------------------------------------------------------------
 // Shallow SparseFullRLNC
 //------------------------------------------------------------------
@@ -699,6 +1000,86 @@ BENCHMARK_F(setup_sparse_rlnc_throughput16, SparseFullRLNC, Binary16, 5)
     run_benchmark();
 }
 
+//------------------------------------------------------------------
+// SeedRLNC
+//------------------------------------------------------------------
+
+typedef throughput_benchmark<
+    kodo::seed_rlnc_encoder<fifi::binary>,
+    kodo::seed_rlnc_decoder<fifi::binary> > setup_seed_rlnc_throughput;
+
+BENCHMARK_F(setup_seed_rlnc_throughput, SeedRLNC, Binary, 5)
+{
+    run_benchmark();
+}
+
+typedef throughput_benchmark<
+    kodo::seed_rlnc_encoder<fifi::binary8>,
+    kodo::seed_rlnc_decoder<fifi::binary8> > setup_seed_rlnc_throughput8;
+
+BENCHMARK_F(setup_seed_rlnc_throughput8, SeedRLNC, Binary8, 5)
+{
+    run_benchmark();
+}
+
+//------------------------------------------------------------------
+// FastSeedRLNC
+//------------------------------------------------------------------
+
+typedef throughput_benchmark<
+    kodo::fast_seed_rlnc_encoder<fifi::binary>,
+    kodo::fast_seed_rlnc_decoder<fifi::binary> >
+    setup_fast_seed_rlnc_throughput;
+
+BENCHMARK_F(setup_fast_seed_rlnc_throughput, FastSeedRLNC, Binary, 5)
+{
+    run_benchmark();
+}
+
+typedef throughput_benchmark<
+    kodo::fast_seed_rlnc_encoder<fifi::binary8>,
+    kodo::fast_seed_rlnc_decoder<fifi::binary8> >
+    setup_fast_seed_rlnc_throughput8;
+
+BENCHMARK_F(setup_fast_seed_rlnc_throughput8, FastSeedRLNC, Binary8, 5)
+{
+    run_benchmark();
+}
+
+//------------------------------------------------------------------
+// Shallow ThreadedFullRLNC
+//------------------------------------------------------------------
+
+typedef threaded_throughput_benchmark<
+    kodo::shallow_threaded_full_rlnc_encoder<fifi::binary>,
+    kodo::shallow_threaded_full_rlnc_decoder<fifi::binary>>
+    setup_threaded_rlnc_throughput;
+
+BENCHMARK_F(setup_threaded_rlnc_throughput, ThreadedFullRLNC, Binary, 5)
+{
+    run_benchmark();
+}
+
+typedef threaded_throughput_benchmark<
+    kodo::shallow_threaded_full_rlnc_encoder<fifi::binary8>,
+    kodo::shallow_threaded_full_rlnc_decoder<fifi::binary8>>
+    setup_threaded_rlnc_throughput8;
+
+BENCHMARK_F(setup_threaded_rlnc_throughput8, ThreadedFullRLNC, Binary8, 5)
+{
+    run_benchmark();
+}
+
+typedef threaded_throughput_benchmark<
+    kodo::shallow_threaded_full_rlnc_encoder<fifi::binary16>,
+    kodo::shallow_threaded_full_rlnc_decoder<fifi::binary16>>
+    setup_threaded_rlnc_throughput16;
+
+BENCHMARK_F(setup_threaded_rlnc_throughput16, ThreadedFullRLNC, Binary16, 5)
+{
+    run_benchmark();
+}
+
 int main(int argc, const char* argv[])
 {
     srand(static_cast<uint32_t>(time(0)));
@@ -4,6 +4,7 @@
 // http://www.steinwurf.com/licensing
 
 #include <cstring>
+#include <limits>
 #include <utility>
 
 #include <kodo/object/storage_decoder.hpp>
@@ -49,7 +50,7 @@ namespace kodo
         /// @param object_size the size in bytes of the whole object
         fixed_partitioning_scheme(uint32_t max_symbols,
                                   uint32_t max_symbol_size,
-                                  uint32_t object_size)
+                                  uint64_t object_size)
             : m_max_symbols(max_symbols),
               m_max_symbol_size(max_symbol_size),
               m_object_size(object_size)
@@ -73,8 +74,12 @@ namespace kodo
 
             assert(m_symbols_per_block > 0);
 
-            m_total_blocks = m_total_symbols / m_symbols_per_block;
-            assert(m_total_blocks > 0);
+            // The blocks are indexed with 32 bits
+            uint64_t total_blocks = m_total_symbols / m_symbols_per_block;
+            assert(total_blocks > 0);
+            assert(total_blocks <= std::numeric_limits<uint32_t>::max());
+
+            m_total_blocks = (uint32_t) total_blocks;
         }
 
         /// @copydoc block_partitioning::symbols(uint32_t) const
@@ -102,14 +107,15 @@ namespace kodo
         }
 
         /// @copydoc block_partitioning::bytes_offset(uint32_t) const
-        uint32_t byte_offset(uint32_t block_id) const
+        uint64_t byte_offset(uint32_t block_id) const
         {
             assert(m_total_blocks > block_id);
 
             // We have a constant block size and since block_id starts
             // from zero we can simply multiply the block size with
-            // the block_id to get the offset
-            return block_size(block_id) * block_id;
+            // the block_id to get the offset. The product is computed
+            // in 64 bits since objects may be larger than 4 GB.
+            return (uint64_t) block_size(block_id) * block_id;
         }
 
         /// @copydoc block_partitioning::bytes_used(uint32_t) const
@@ -117,13 +123,15 @@ namespace kodo
         {
             assert(block_id < m_total_blocks);
 
-            uint32_t offset = byte_offset(block_id);
+            uint64_t offset = byte_offset(block_id);
 
             assert(offset < m_object_size);
-            uint32_t remaining =  m_object_size - offset;
+            uint64_t remaining =  m_object_size - offset;
             uint32_t the_block_size = block_size(block_id);
 
-            return std::min(remaining, the_block_size);
+            // The result fits in 32 bits since it is at most the
+            // block size
+            return (uint32_t) std::min<uint64_t>(remaining, the_block_size);
         }
 
         /// @copydoc block_partitioning::blocks() const
@@ -134,21 +142,21 @@ namespace kodo
         }
 
         /// @copydoc block_partitioning::object_size() const
-        uint32_t object_size() const
+        uint64_t object_size() const
         {
             assert(m_object_size > 0);
             return m_object_size;
         }
 
         /// @copydoc block_partitioning::total_symbols() const
-        uint32_t total_symbols() const
+        uint64_t total_symbols() const
         {
             assert(m_total_symbols > 0);
             return m_total_symbols;
         }
 
         /// @copydoc block_partitioning::total_block_size() const
-        uint32_t total_block_size() const
+        uint64_t total_block_size() const
         {
             assert(m_total_symbols > 0);
             assert(m_max_symbol_size > 0);
@@ -157,20 +165,23 @@ namespace kodo
 
     private:
 
-        /// Calculate the greatest common divisor of two numbers
-        uint32_t gcd(uint32_t u, uint32_t v)
+        /// Calculate the greatest common divisor of two numbers, the
+        /// result fits in 32 bits since it divides v
+        uint32_t gcd(uint64_t u, uint32_t v)
         {
             assert(u > 0);
             assert(v > 0);
 
-            while (v != 0)
+            uint64_t w = v;
+
+            while (w != 0)
             {
-                uint32_t r = u % v;
-                u = v;
-                v = r;
+                uint64_t r = u % w;
+                u = w;
+                w = r;
             }
 
-            return u;
+            return (uint32_t) u;
         }
 
     private:
@@ -182,10 +193,10 @@ namespace kodo
         uint32_t m_max_symbol_size;
 
         /// The size of the object to transfer in bytes
-        uint32_t m_object_size;
+        uint64_t m_object_size;
 
         /// The total number of symbols in the object
-        uint32_t m_total_symbols;
+        uint64_t m_total_symbols;
 
         /// The number of symbols per block
         uint32_t m_symbols_per_block;
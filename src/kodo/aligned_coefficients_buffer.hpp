@@ -9,7 +9,6 @@
 
 #include <boost/shared_ptr.hpp>
 
-#include <sak/aligned_allocator.hpp>
 #include <sak/is_aligned.hpp>
 
 namespace kodo
@@ -18,28 +17,58 @@ namespace kodo
     ///
     /// @brief Helper layer for layers that require a buffer for storing
     ///        symbol coefficients. The storage is uninitialized. The
-    ///        buffer is guaranteed to be aligned (on a 16 byte boundary).
+    ///        buffer is guaranteed to be aligned (on a 16 byte boundary)
+    ///        since it is allocated in the arena of the coder.
     template<class SuperCoder>
     class aligned_coefficients_buffer : public SuperCoder
     {
     public:
 
+        /// @ingroup factory_base_layers
+        /// @brief Adds the buffer to the arena of a coder
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(
+                        SuperCoder::factory_base::max_coefficient_vector_size());
+            }
+        };
+
+    public:
+
+        /// Constructor
+        aligned_coefficients_buffer()
+            : m_coefficients(0),
+              m_coefficients_size(0)
+        { }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
         {
             SuperCoder::construct(the_factory);
-            m_coefficients.resize(the_factory.max_coefficient_vector_size());
+
+            m_coefficients_size = the_factory.max_coefficient_vector_size();
+            m_coefficients = SuperCoder::arena_allocate(m_coefficients_size);
         }
 
     protected:
 
-        /// The storage type
-        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t> >
-            aligned_vector;
-
         /// Temp symbol id (with aligned memory)
-        aligned_vector m_coefficients;
+        uint8_t* m_coefficients;
+
+        /// The size of the buffer in bytes
+        uint32_t m_coefficients_size;
 
     };
 }
@@ -42,11 +42,12 @@ namespace kodo
                 uint32_t coefficients_size = Super::coefficient_vector_size();
 
                 auto src = sak::storage(coefficients, coefficients_size);
-                auto dest = sak::storage(m_coefficients);
+                auto dest = sak::storage(m_coefficients,
+                                         m_coefficients_size);
 
                 sak::copy_storage(dest, src);
 
-                Super::decode_symbol(symbol_data, &m_coefficients[0]);
+                Super::decode_symbol(symbol_data, m_coefficients);
             }
             else
             {
@@ -60,6 +61,9 @@ namespace kodo
         /// aligned_coefficients_buffer layer
         using Super::m_coefficients;
 
+        /// Access the size of the coefficients buffer
+        using Super::m_coefficients_size;
+
     };
 
 }
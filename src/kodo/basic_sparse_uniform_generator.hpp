@@ -0,0 +1,144 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#include <fifi/is_binary.hpp>
+
+namespace kodo
+{
+    /// @ingroup coefficient_generator_layers
+    /// @brief Generate uniformly distributed coefficients with a specific
+    /// density. The random values are drawn with the GeneratorPolicy,
+    /// see e.g. the mt19937_generator_policy and the
+    /// xoshiro256_generator_policy.
+    ///
+    /// The order in which the positions and values of the nonzero
+    /// coefficients are drawn is decided by the generate_sparse()
+    /// function of the policy. The mt19937_generator_policy draws them
+    /// position by position so a seed gives the same coefficients as
+    /// in earlier versions, whereas the xoshiro256_generator_policy
+    /// draws all positions first as a bit mask. For the binary field
+    /// generate() takes the mask of the policy as the coefficient
+    /// vector.
+    template<class GeneratorPolicy, class SuperCoder>
+    class basic_sparse_uniform_generator : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// The policy drawing the random values
+        typedef GeneratorPolicy generator_policy;
+
+        /// @copydoc layer::seed_type
+        typedef typename generator_policy::seed_type seed_type;
+
+    public:
+
+        /// Constructor
+        basic_sparse_uniform_generator()
+            : m_density(0.5)
+        { }
+
+        /// @copydoc layer::generate(uint8_t*)
+        void generate(uint8_t *coefficients)
+        {
+            assert(coefficients != 0);
+
+            // Since we will not set all coefficients we should ensure
+            // that the non specified ones are zero
+            std::fill_n( coefficients, SuperCoder::coefficient_vector_size(), 0);
+
+            uint32_t symbols = SuperCoder::symbols();
+
+            if (fifi::is_binary<field_type>::value)
+            {
+                m_generator.generate_mask(coefficients, symbols, m_density);
+                return;
+            }
+
+            m_generator.template generate_sparse<field_type>(
+                reinterpret_cast<value_type*>(coefficients), symbols,
+                m_density, [](uint32_t) { return true; });
+        }
+
+        /// @copydoc layer::generate(uint8_t*)
+        void generate_partial(uint8_t *coefficients)
+        {
+            assert(coefficients != 0);
+
+            // Since we will not set all coefficients we should ensure
+            // that the non specified ones are zero
+            std::fill_n( coefficients, SuperCoder::coefficient_vector_size(), 0);
+
+            m_generator.template generate_sparse<field_type>(
+                reinterpret_cast<value_type*>(coefficients),
+                SuperCoder::symbols(), m_density,
+                [this](uint32_t i) { return SuperCoder::is_symbol_pivot(i); });
+        }
+
+        /// @copydoc layer::seed(seed_type)
+        void seed(seed_type seed_value)
+        {
+            m_generator.seed(seed_value);
+        }
+
+        /// Set the density of the coefficients generated
+        /// @param density coefficients density
+        void set_density(double density)
+        {
+            assert(density > 0);
+            // If binary, the density should be below 1
+            assert(!fifi::is_binary<field_type>::value || density < 1);
+            assert(density <= 1);
+
+            m_density = density;
+        }
+
+        /// Set the average number of nonzero symbols
+        /// @param symbols the average number of nonzero symbols
+        void set_average_nonzero_symbols(double symbols)
+        {
+            // If binary, check that symbols are less than the total
+            // number of symbols. Note, that the second part of the or
+            // is only exectuted if the first part is false
+            assert(!fifi::is_binary<field_type>::value ||
+                symbols < SuperCoder::symbols());
+
+            // If not binary, check that symbols are less than or equal the
+            // total number of symbols
+            assert(fifi::is_binary<field_type>::value ||
+                symbols <= SuperCoder::symbols());
+
+            assert(symbols > 0.0);
+            set_density(symbols/SuperCoder::symbols());
+        }
+
+        /// Get the density of the coefficients generated
+        /// @return the density of the generator
+        double density() const
+        {
+            return m_density;
+        }
+
+    private:
+
+        /// The density of the coefficients
+        double m_density;
+
+        /// The random generator
+        generator_policy m_generator;
+
+    };
+}
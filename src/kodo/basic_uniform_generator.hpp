@@ -0,0 +1,89 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include <fifi/fifi_utils.hpp>
+
+namespace kodo
+{
+
+    /// @ingroup coefficient_generator_layers
+    /// @brief Generates an uniform random coefficient (from the chosen
+    /// Finite Field) for every symbol. The random values are drawn
+    /// with the GeneratorPolicy, see e.g. the mt19937_generator_policy
+    /// and the xoshiro256_generator_policy.
+    template<class GeneratorPolicy, class SuperCoder>
+    class basic_uniform_generator : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// The policy drawing the random values
+        typedef GeneratorPolicy generator_policy;
+
+        /// @copydoc layer::seed_type
+        typedef typename generator_policy::seed_type seed_type;
+
+    public:
+
+        /// @copydoc layer::generate(uint8_t*)
+        void generate(uint8_t *coefficients)
+        {
+            assert(coefficients != 0);
+
+            m_generator.generate(coefficients,
+                                 SuperCoder::coefficient_vector_size());
+        }
+
+        /// @copydoc layer::generate(uint8_t*)
+        void generate_partial(uint8_t *coefficients)
+        {
+            assert(coefficients != 0);
+
+            // Since we will not set all coefficients we should ensure
+            // that the non specified ones are zero
+            std::fill_n(coefficients, SuperCoder::coefficient_vector_size(), 0);
+
+            value_type *c = reinterpret_cast<value_type*>(coefficients);
+
+            uint32_t symbols = SuperCoder::symbols();
+
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                if(!SuperCoder::can_generate(i))
+                {
+                    continue;
+                }
+
+                value_type coefficient = m_generator.generate_value(
+                    value_type(field_type::min_value),
+                    value_type(field_type::max_value));
+
+                fifi::set_value<field_type>(c, i, coefficient);
+            }
+        }
+
+        /// @copydoc layer::seed(seed_type)
+        void seed(seed_type seed_value)
+        {
+            m_generator.seed(seed_value);
+        }
+
+    private:
+
+        /// The random generator
+        generator_policy m_generator;
+
+    };
+}
@@ -0,0 +1,46 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace kodo
+{
+    /// @ingroup payload_codec_layers
+    ///
+    /// @brief Decodes a batch of payloads as one elimination.
+    ///
+    /// The payloads are passed to layer::decode(uint8_t*) one at a
+    /// time between layer::begin_decode_batch() and
+    /// layer::end_decode_batch(). The linear block decoder therefore
+    /// only has to touch the symbol data once per batch, which is
+    /// useful for receivers which read many packets per system call.
+    template<class SuperCoder>
+    class batch_payload_decoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::decode_batch(uint8_t**, uint32_t)
+        void decode_batch(uint8_t **payloads, uint32_t count)
+        {
+            assert(payloads != 0);
+
+            SuperCoder::begin_decode_batch();
+
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                if(SuperCoder::is_complete())
+                    break;
+
+                assert(payloads[i] != 0);
+                SuperCoder::decode(payloads[i]);
+            }
+
+            SuperCoder::end_decode_batch();
+        }
+    };
+}
@@ -0,0 +1,51 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace kodo
+{
+    /// @ingroup payload_codec_layers
+    ///
+    /// @brief Encodes a batch of payloads in one pass over the source
+    ///        symbols.
+    ///
+    /// The payloads are produced by layer::encode(uint8_t*) one at a
+    /// time between layer::begin_encode_batch() and
+    /// layer::end_encode_batch(). The linear block encoder therefore
+    /// only reads the source symbols once per batch, which is useful
+    /// when several repair packets are produced for a block at once.
+    template<class SuperCoder>
+    class batch_payload_encoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::encode_batch(uint8_t**, uint32_t, uint32_t*)
+        void encode_batch(uint8_t **payloads, uint32_t count,
+                          uint32_t *bytes_used)
+        {
+            assert(payloads != 0);
+
+            SuperCoder::begin_encode_batch();
+
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                assert(payloads[i] != 0);
+
+                uint32_t used = SuperCoder::encode(payloads[i]);
+
+                if(bytes_used != 0)
+                {
+                    bytes_used[i] = used;
+                }
+            }
+
+            SuperCoder::end_encode_batch();
+        }
+    };
+}
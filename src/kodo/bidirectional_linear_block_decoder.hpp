@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <type_traits>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/noncopyable.hpp>
@@ -19,6 +22,7 @@
 
 #include <kodo/forward_linear_block_decoder_policy.hpp>
 #include <kodo/backward_linear_block_decoder_policy.hpp>
+#include <kodo/has_operations_counter.hpp>
 
 namespace kodo
 {
@@ -32,6 +36,30 @@ namespace kodo
     /// expects that an encoded symbol is described by a vector of
     /// coefficients. Using these coefficients the block decoder subtracts
     /// incoming symbols until the original data has been recreated.
+    ///
+    /// Between begin_decode_batch() and end_decode_batch() the decoder
+    /// only reduces the coefficient vectors as symbols arrive. The
+    /// matching operations on the symbol data are logged and applied
+    /// together when the batch ends, one tile of the symbols at a
+    /// time, so that every symbol tile is loaded into the cache once
+    /// per batch instead of once per received symbol.
+    ///
+    /// With deferred substitution enabled the decoder also logs the
+    /// symbol operations outside a batch while it searches for a
+    /// pivot. The operations are applied once a pivot is found, and
+    /// dropped without touching the symbol data if the symbol turns
+    /// out to be linearly dependent. If the stack contains a
+    /// finite_field_counter the bytes saved this way are counted in
+    /// its operations_counter.
+    ///
+    /// The encoding vector of a symbol added uncoded is a unit vector,
+    /// so it is not written when the symbol is stored. The elimination
+    /// treats the vectors of these symbols as unit vectors, and
+    /// coefficient_vector_values() writes the unit vector the first
+    /// time it is requested, e.g. by a recoder or when tracing. This
+    /// also holds for the const overloads, so these must not be called
+    /// concurrently. The symbols which become uncoded when the decoder
+    /// reaches full rank keep their stored vectors.
     template<class DirectionPolicy, class SuperCoder>
     class bidirectional_linear_block_decoder : public SuperCoder
     {
@@ -50,11 +78,55 @@ namespace kodo
         /// the coding coefficients
         typedef DirectionPolicy direction_policy;
 
+    public:
+
+        /// The default size in bytes of the symbol tiles used when
+        /// applying the operations logged during a decode batch
+        static const uint32_t default_batch_tile_size = 2048;
+
+    public:
+
+        /// @ingroup factory_base_layers
+        /// @brief Adds the unit vector flags and the operands of the
+        ///        fused subtractions to the arena of a coder
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                uint32_t symbols = SuperCoder::factory_base::max_symbols();
+
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(symbols) +
+                    SuperCoder::factory_base::arena_region_size(
+                        symbols * sizeof(const value_type*)) +
+                    SuperCoder::factory_base::arena_region_size(
+                        symbols * sizeof(value_type));
+            }
+        };
+
     public:
 
         /// Constructor
         bidirectional_linear_block_decoder()
-            : m_maximum_pivot(0)
+            : m_maximum_pivot(0),
+              m_batch(false),
+              m_batch_tile_size(default_batch_tile_size),
+              m_fused_sources(0),
+              m_fused_coefficients(0),
+              m_fused_capacity(0),
+              m_deferred_substitution(false),
+              m_deferring(false),
+              m_unwritten_vectors(0),
+              m_coefficient_vectors(0),
+              m_coefficient_vector_stride(0)
         { }
 
         /// @copydoc layer::construct(Factory&)
@@ -62,6 +134,19 @@ namespace kodo
         void construct(Factory &the_factory)
         {
             SuperCoder::construct(the_factory);
+
+            uint32_t symbols = the_factory.max_symbols();
+
+            m_unwritten_vectors = SuperCoder::arena_allocate(symbols);
+
+            m_fused_capacity = symbols;
+
+            m_fused_sources = reinterpret_cast<const value_type**>(
+                SuperCoder::arena_allocate(
+                    symbols * sizeof(const value_type*)));
+
+            m_fused_coefficients = reinterpret_cast<value_type*>(
+                SuperCoder::arena_allocate(symbols * sizeof(value_type)));
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -74,6 +159,17 @@ namespace kodo
             // from symbols to 0.
             m_maximum_pivot =
                 direction_policy::min(0, the_factory.symbols() - 1);
+
+            m_batch = false;
+            m_deferring = false;
+            m_symbol_operations.clear();
+
+            std::fill_n(m_unwritten_vectors, the_factory.symbols(), 0);
+
+            // The storage may have been reallocated by the layers below
+            m_coefficient_vectors = SuperCoder::coefficient_vector_data(0);
+            m_coefficient_vector_stride =
+                SuperCoder::coefficient_vector_stride();
         }
 
         /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
@@ -119,9 +215,10 @@ namespace kodo
                 // encoding vector
                 store_uncoded_symbol(symbol, symbol_index);
 
-                // Backwards substitution
+                // Backwards substitution, the unit vector of the
+                // symbol is not stored so the stale vector is passed
                 value_type *coefficients =
-                    SuperCoder::coefficient_vector_values(symbol_index);
+                    stored_coefficient_vector_values(symbol_index);
 
                 backward_substitute(symbol, coefficients, symbol_index);
 
@@ -133,6 +230,59 @@ namespace kodo
             update_symbol_status();
         }
 
+        /// @copydoc layer::begin_decode_batch()
+        void begin_decode_batch()
+        {
+            assert(!m_batch);
+            assert(m_symbol_operations.empty());
+
+            m_batch = true;
+        }
+
+        /// @copydoc layer::end_decode_batch()
+        void end_decode_batch()
+        {
+            assert(m_batch);
+
+            apply_symbol_operations(0);
+            m_batch = false;
+        }
+
+        /// @return The size in bytes of the symbol tiles used when
+        ///         ending a decode batch
+        uint32_t batch_tile_size() const
+        {
+            return m_batch_tile_size;
+        }
+
+        /// Sets the size in bytes of the symbol tiles used when ending
+        /// a decode batch. The tile should be small enough that the
+        /// tiles of all symbols touched by a batch fit in the cache.
+        /// @param tile_size The tile size in bytes
+        void set_batch_tile_size(uint32_t tile_size)
+        {
+            assert(tile_size >= sizeof(value_type));
+            m_batch_tile_size = tile_size;
+        }
+
+        /// @return True if the symbol operations needed to find the
+        ///         pivot of a coded symbol are deferred until the
+        ///         pivot is found
+        bool deferred_substitution() const
+        {
+            return m_deferred_substitution;
+        }
+
+        /// Enables or disables deferred substitution. When enabled the
+        /// symbol data of a linearly dependent coded symbol is never
+        /// processed, at the cost of logging the operations while
+        /// searching for the pivot.
+        /// @param enable True to defer the symbol operations
+        void set_deferred_substitution(bool enable)
+        {
+            m_deferred_substitution = enable;
+        }
+
         /// @copydoc layer::is_complete() const
         bool is_complete() const
         {
@@ -157,8 +307,52 @@ namespace kodo
                 SuperCoder::is_symbol_uncoded(index);
         }
 
+        /// @copydoc layer::coefficient_vector_values(uint32_t)
+        value_type* coefficient_vector_values(uint32_t index)
+        {
+            write_unit_vector(index);
+            return SuperCoder::coefficient_vector_values(index);
+        }
+
+        /// @copydoc layer::coefficient_vector_values(uint32_t) const
+        const value_type* coefficient_vector_values(uint32_t index) const
+        {
+            write_unit_vector(index);
+            return SuperCoder::coefficient_vector_values(index);
+        }
+
+        /// @copydoc layer::coefficient_vector_data(uint32_t)
+        uint8_t* coefficient_vector_data(uint32_t index)
+        {
+            write_unit_vector(index);
+            return SuperCoder::coefficient_vector_data(index);
+        }
+
+        /// @copydoc layer::coefficient_vector_data(uint32_t) const
+        const uint8_t* coefficient_vector_data(uint32_t index) const
+        {
+            write_unit_vector(index);
+            return SuperCoder::coefficient_vector_data(index);
+        }
+
     protected:
 
+        /// @return True if a decode batch is in progress
+        bool is_decode_batch() const
+        {
+            return m_batch;
+        }
+
+        /// @param index The index of a symbol
+        /// @return The encoding vector of the symbol as stored. The
+        ///         unit vector of a symbol added uncoded may not have
+        ///         been written, but the elimination functions never
+        ///         read it.
+        value_type* stored_coefficient_vector_values(uint32_t index)
+        {
+            return SuperCoder::coefficient_vector_values(index);
+        }
+
         /// Updates the symbol status to decoded if the decoder reaches full
         /// rank
         void update_symbol_status()
@@ -166,9 +360,15 @@ namespace kodo
             if(!is_complete())
                 return;
 
-            // We have finished decoding mark all symbols decoded
-            for(uint32_t i = 0; i < SuperCoder::symbols(); ++i)
+            // We have finished decoding mark all symbols decoded,
+            // only the "seen" symbols have to change
+            uint32_t symbols = SuperCoder::symbols();
+
+            for(uint32_t i = SuperCoder::next_symbol_seen(0); i < symbols;
+                i = SuperCoder::next_symbol_seen(i + 1))
+            {
                 SuperCoder::set_symbol_uncoded(i);
+            }
         }
 
         /// Decodes a symbol based on the coefficients
@@ -237,17 +437,14 @@ namespace kodo
             // Subtract the new pivot symbol
             SuperCoder::set_coefficient_value(vector_i, pivot_index, 0U);
 
-            SuperCoder::subtract(symbol_i, symbol_data,
-                                 SuperCoder::symbol_length());
+            symbol_subtract(symbol_i, symbol_data);
 
             // Now continue our new coded symbol we know that it must
             // if found it will contain a pivot id > that the current.
             decode_coefficients(symbol_i, vector_i);
 
-            // The previous vector may still be in memory
-            std::fill_n(vector_i, SuperCoder::coefficient_vector_length(), 0);
-
-            // Stores the symbol and sets the pivot in the vector
+            // Stores the symbol, the previous vector left in memory
+            // is replaced by the implicit unit vector
             store_uncoded_symbol(symbol_data, pivot_index);
 
             // No need to backwards substitute since we are
@@ -281,8 +478,7 @@ namespace kodo
             SuperCoder::multiply(symbol_id, inverted_coefficient,
                                  SuperCoder::coefficient_vector_length());
 
-            SuperCoder::multiply(symbol_data, inverted_coefficient,
-                                 SuperCoder::symbol_length());
+            symbol_multiply(symbol_data, inverted_coefficient);
         }
 
         /// Iterates the encoding vector and subtracts existing symbols
@@ -297,21 +493,36 @@ namespace kodo
             assert(symbol_id != 0);
             assert(symbol_data != 0);
 
-            uint32_t start = direction_policy::min(0, SuperCoder::symbols()-1);
-            uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t start = direction_policy::min(0, symbols - 1);
 
-            for(direction_policy p(start, end); !p.at_end(); p.advance())
-            {
-                uint32_t i = p.index();
+            // Operations logged from here on only touch symbol_data
+            std::size_t first_operation = m_symbol_operations.size();
+
+            // Inside a batch the operations are deferred anyway
+            m_deferring = m_deferred_substitution && !m_batch;
 
+            // Only the nonzero coefficients are visited. The search
+            // continues on the updated encoding vector after each
+            // subtraction.
+            for(uint32_t i = find_nonzero(symbol_id, start); i < symbols;
+                i = find_nonzero(symbol_id, step(i)))
+            {
                 value_type current_coefficient =
                     SuperCoder::coefficient_value(symbol_id, i);
 
-                if(!current_coefficient)
-                    continue;
+                assert(current_coefficient);
 
                 if(!is_symbol_pivot(i))
+                {
+                    if(m_deferring)
+                    {
+                        m_deferring = false;
+                        apply_symbol_operations(first_operation);
+                    }
+
                     return boost::optional<uint32_t>( i );
+                }
 
                 value_type *vector_i =
                     SuperCoder::coefficient_vector_values( i );
@@ -319,27 +530,30 @@ namespace kodo
                 value_type *symbol_i =
                     SuperCoder::symbol_value( i );
 
+                vector_multiply_subtract(
+                    symbol_id, vector_i, i, current_coefficient);
+
                 if(fifi::is_binary<field_type>::value)
                 {
-                    SuperCoder::subtract(symbol_id, vector_i,
-                        SuperCoder::coefficient_vector_length());
-
-                    SuperCoder::subtract(symbol_data, symbol_i,
-                        SuperCoder::symbol_length());
+                    symbol_subtract(symbol_data, symbol_i);
                 }
                 else
                 {
-                    SuperCoder::multiply_subtract(
-                        symbol_id, vector_i,
-                        current_coefficient,
-                        SuperCoder::coefficient_vector_length());
-
-                    SuperCoder::multiply_subtract(symbol_data, symbol_i,
-                        current_coefficient, SuperCoder::symbol_length());
+                    symbol_multiply_subtract(symbol_data, symbol_i,
+                        current_coefficient);
                 }
 
             }
 
+            // The symbol was linearly dependent and will be dropped,
+            // so there is no point in reducing its data
+            count_bytes_saved(
+                (m_symbol_operations.size() - first_operation) *
+                SuperCoder::symbol_size());
+
+            m_symbol_operations.resize(first_operation);
+            m_deferring = false;
+
             return boost::none;
         }
 
@@ -367,33 +581,29 @@ namespace kodo
 
             // If this pivot index was smaller than the maximum pivot
             // index we have, we might also need to backward
-            // substitute the higher pivot values into the new packet
-            uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
-
-            direction_policy p(pivot_index, end);
-
-            // Jump past the pivot_index position
-            p.advance();
-
-            for(; !p.at_end(); p.advance())
+            // substitute the higher pivot values into the new packet.
+            // Only the positions which are both a pivot and have a
+            // nonzero coefficient are visited, found by skipping
+            // alternately to the next nonzero coefficient and the
+            // next pivot.
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t i = find_nonzero(symbol_id, step(pivot_index));
+
+            while(i < symbols)
             {
-                uint32_t i = p.index();
-
-                // Do we have a non-zero value here?
-                value_type value =
-                    SuperCoder::coefficient_value(symbol_id, i);
+                uint32_t pivot = find_pivot(i);
 
-                if( !value )
+                if(pivot != i)
                 {
-                    // The coefficient is zero
+                    // The coefficient is not at a pivot position
+                    i = find_nonzero(symbol_id, pivot);
                     continue;
                 }
 
-                if( !is_symbol_pivot(i) )
-                {
-                    // We do not have a pivot here
-                    continue;
-                }
+                value_type value =
+                    SuperCoder::coefficient_value(symbol_id, i);
+
+                assert(value);
 
                 value_type *vector_i =
                     SuperCoder::coefficient_vector_values(i);
@@ -401,26 +611,18 @@ namespace kodo
                 value_type *symbol_i =
                     SuperCoder::symbol_value(i);
 
+                vector_multiply_subtract(symbol_id, vector_i, i, value);
+
                 if(fifi::is_binary<field_type>::value)
                 {
-                    SuperCoder::subtract(
-                        symbol_id, vector_i,
-                        SuperCoder::coefficient_vector_length());
-
-                    SuperCoder::subtract(
-                        symbol_data, symbol_i,
-                        SuperCoder::symbol_length());
+                    symbol_subtract(symbol_data, symbol_i);
                 }
                 else
                 {
-                    SuperCoder::multiply_subtract(
-                        symbol_id, vector_i, value,
-                        SuperCoder::coefficient_vector_length());
-
-                    SuperCoder::multiply_subtract(
-                        symbol_data, symbol_i, value,
-                        SuperCoder::symbol_length());
+                    symbol_multiply_subtract(symbol_data, symbol_i, value);
                 }
+
+                i = find_nonzero(symbol_id, step(i));
             }
         }
 
@@ -442,32 +644,26 @@ namespace kodo
             uint32_t from = direction_policy::min(0, SuperCoder::symbols()-1);
             uint32_t to = m_maximum_pivot;
 
+            // Every symbol is reduced independently, so the "seen"
+            // symbols between from and to are visited in increasing
+            // order whatever the direction. The uncoded symbols have
+            // no non-zero elements outside their pivot position and
+            // the missing symbols hold nothing to reduce.
+            uint32_t first = std::min(from, to);
+            uint32_t last = std::max(from, to);
+
             // We found a "1" that nobody else had as pivot, we now
             // substract this packet from other coded packets
             // - if they have a "1" on our pivot place
-            for(direction_policy p(from, to); !p.at_end(); p.advance())
+            for(uint32_t i = SuperCoder::next_symbol_seen(first); i <= last;
+                i = SuperCoder::next_symbol_seen(i + 1))
             {
-                uint32_t i = p.index();
-
                 if(i == pivot_index)
                 {
                     // We cannot backward substitute into our self
                     continue;
                 }
 
-                if( SuperCoder::is_symbol_uncoded(i) )
-                {
-                    // We know that we have no non-zero elements
-                    // outside the pivot position.
-                    continue;
-                }
-
-                if( SuperCoder::is_symbol_missing(i) )
-                {
-                    // We do not have a symbol yet here
-                    continue;
-                }
-
                 // The symbol must be "seen"
                 assert(SuperCoder::is_symbol_seen(i));
 
@@ -485,22 +681,17 @@ namespace kodo
 
                 value_type *symbol_i = SuperCoder::symbol_value(i);
 
+                // Update symbol and corresponding vector
+                vector_multiply_subtract(
+                    vector_i, symbol_id, pivot_index, value);
+
                 if(fifi::is_binary<field_type>::value)
                 {
-                    SuperCoder::subtract(vector_i, symbol_id,
-                        SuperCoder::coefficient_vector_length());
-
-                    SuperCoder::subtract(symbol_i, symbol_data,
-                        SuperCoder::symbol_length());
+                    symbol_subtract(symbol_i, symbol_data);
                 }
                 else
                 {
-                    // Update symbol and corresponding vector
-                    SuperCoder::multiply_subtract(vector_i, symbol_id, value,
-                        SuperCoder::coefficient_vector_length());
-
-                    SuperCoder::multiply_subtract(symbol_i, symbol_data, value,
-                        SuperCoder::symbol_length());
+                    symbol_multiply_subtract(symbol_i, symbol_data, value);
                 }
             }
         }
@@ -531,14 +722,13 @@ namespace kodo
             SuperCoder::set_coefficient_vector_data(
                 pivot_index, coefficient_storage);
 
+            m_unwritten_vectors[pivot_index] = 0;
+
             // Mark this symbol seen
             SuperCoder::set_symbol_seen(pivot_index);
 
             // Copy it into the symbol storage
-            sak::const_storage src =
-                sak::storage(symbol_data, SuperCoder::symbol_size());
-
-            SuperCoder::copy_into_symbol(pivot_index, src);
+            symbol_copy_into(pivot_index, symbol_data);
         }
 
         /// Stores an uncoded or fully decoded symbol
@@ -556,30 +746,460 @@ namespace kodo
             assert(symbol_data != 0);
             assert(pivot_index < SuperCoder::symbols());
 
-            // Update the corresponding vector
-            value_type *vector_dest =
-                SuperCoder::coefficient_vector_values( pivot_index );
-
-            // Zero out the memory first
-            std::fill_n(vector_dest, SuperCoder::coefficient_vector_length(), 0);
-
-            SuperCoder::set_coefficient_value(vector_dest, pivot_index, 1U);
+            // The unit vector is only written if it is requested
+            m_unwritten_vectors[pivot_index] = 1;
 
             // Mark this symbol decoded
             SuperCoder::set_symbol_uncoded(pivot_index);
 
             // Copy it into the symbol storage
+            symbol_copy_into(pivot_index, symbol_data);
+        }
+
+        /// Subtracts the source symbol from the destination symbol, or
+        /// logs the operation if it is deferred.
+        /// @param symbol_dest The destination symbol
+        /// @param symbol_src The source symbol
+        void symbol_subtract(value_type *symbol_dest,
+                             const value_type *symbol_src)
+        {
+            if(m_batch || m_deferring)
+            {
+                log_symbol_operation(symbol_operation::subtract,
+                                     symbol_dest, symbol_src, 0U);
+                return;
+            }
+
+            SuperCoder::subtract(symbol_dest, symbol_src,
+                                 SuperCoder::symbol_length());
+        }
+
+        /// Multiplies the source symbol by the coefficient and subtracts
+        /// it from the destination symbol, or logs the operation if it
+        /// is deferred.
+        /// @param symbol_dest The destination symbol
+        /// @param symbol_src The source symbol
+        /// @param coefficient The multiplicative constant
+        void symbol_multiply_subtract(value_type *symbol_dest,
+                                      const value_type *symbol_src,
+                                      value_type coefficient)
+        {
+            if(m_batch || m_deferring)
+            {
+                log_symbol_operation(symbol_operation::multiply_subtract,
+                                     symbol_dest, symbol_src, coefficient);
+                return;
+            }
+
+            SuperCoder::multiply_subtract(symbol_dest, symbol_src,
+                coefficient, SuperCoder::symbol_length());
+        }
+
+        /// Multiplies the symbol by the coefficient, or logs the
+        /// operation if it is deferred.
+        /// @param symbol_dest The symbol to multiply
+        /// @param coefficient The multiplicative constant
+        void symbol_multiply(value_type *symbol_dest, value_type coefficient)
+        {
+            if(m_batch || m_deferring)
+            {
+                log_symbol_operation(symbol_operation::multiply,
+                                     symbol_dest, 0, coefficient);
+                return;
+            }
+
+            SuperCoder::multiply(symbol_dest, coefficient,
+                                 SuperCoder::symbol_length());
+        }
+
+        /// Copies the symbol data into the symbol storage, or logs the
+        /// copy if it is deferred.
+        /// @param index The index of the destination symbol
+        /// @param symbol_data The data to copy
+        void symbol_copy_into(uint32_t index, const value_type *symbol_data)
+        {
+            if(m_batch || m_deferring)
+            {
+                log_symbol_operation(symbol_operation::copy,
+                                     SuperCoder::symbol_value(index),
+                                     symbol_data, 0U);
+                return;
+            }
+
             sak::const_storage src =
                 sak::storage(symbol_data, SuperCoder::symbol_size());
 
-            SuperCoder::copy_into_symbol(pivot_index, src);
+            SuperCoder::copy_into_symbol(index, src);
+        }
+
+    private:
+
+        /// Subtracts a multiple of the encoding vector of a pivot from
+        /// an encoding vector. If the unit vector of the pivot has not
+        /// been written only the coefficient at the pivot is cleared
+        /// and the stored vector is not read.
+        /// @param vector_dest The encoding vector to update
+        /// @param vector_src The encoding vector of the pivot
+        /// @param pivot_index The index of the pivot
+        /// @param coefficient The coefficient of vector_dest at the
+        ///        pivot index
+        void vector_multiply_subtract(value_type *vector_dest,
+                                      const value_type *vector_src,
+                                      uint32_t pivot_index,
+                                      value_type coefficient)
+        {
+            assert(SuperCoder::coefficient_value(vector_dest, pivot_index) ==
+                   coefficient);
+
+            if(m_unwritten_vectors[pivot_index])
+            {
+                assert(SuperCoder::is_symbol_uncoded(pivot_index));
+
+                SuperCoder::set_coefficient_value(
+                    vector_dest, pivot_index, 0U);
+                return;
+            }
+
+            if(fifi::is_binary<field_type>::value)
+            {
+                SuperCoder::subtract(vector_dest, vector_src,
+                    SuperCoder::coefficient_vector_length());
+            }
+            else
+            {
+                SuperCoder::multiply_subtract(vector_dest, vector_src,
+                    coefficient, SuperCoder::coefficient_vector_length());
+            }
+        }
+
+        /// Writes the unit vector of a symbol added uncoded if it has not
+        /// been written yet. This is const since the const coefficient
+        /// vector accessors call it, see m_unwritten_vectors.
+        /// @param index The index of a symbol
+        void write_unit_vector(uint32_t index) const
+        {
+            assert(index < SuperCoder::symbols());
+
+            if(!m_unwritten_vectors[index])
+                return;
+
+            value_type *vector = reinterpret_cast<value_type*>(
+                m_coefficient_vectors + index * m_coefficient_vector_stride);
+
+            assert(vector == SuperCoder::coefficient_vector_values(index));
+
+            std::fill_n(vector, SuperCoder::coefficient_vector_length(), 0);
+            SuperCoder::set_coefficient_value(vector, index, 1U);
+
+            m_unwritten_vectors[index] = 0;
         }
 
+        /// @param index The index of a symbol
+        /// @return The index following index in the direction of the
+        ///         direction policy, or symbols() if there is none
+        uint32_t step(uint32_t index) const
+        {
+            assert(index < SuperCoder::symbols());
+
+            if(std::is_same<direction_policy,
+                            forward_linear_block_decoder_policy>::value)
+            {
+                return index + 1;
+            }
+
+            return index == 0 ? SuperCoder::symbols() : index - 1;
+        }
+
+        /// @param index The index of a symbol or symbols()
+        /// @return The index of the first pivot from index (included)
+        ///         in the direction of the direction policy, or
+        ///         symbols() if there is none
+        uint32_t find_pivot(uint32_t index) const
+        {
+            return find_pivot(index, std::is_same<direction_policy,
+                              forward_linear_block_decoder_policy>());
+        }
+
+        /// find_pivot(uint32_t) const for the forward direction
+        uint32_t find_pivot(uint32_t index, std::true_type) const
+        {
+            return SuperCoder::next_symbol_pivot(index);
+        }
+
+        /// find_pivot(uint32_t) const for the backward direction
+        uint32_t find_pivot(uint32_t index, std::false_type) const
+        {
+            if(index >= SuperCoder::symbols())
+                return SuperCoder::symbols();
+
+            return SuperCoder::previous_symbol_pivot(index);
+        }
+
+        /// @param coefficients The encoding vector
+        /// @param index The index of a symbol or symbols()
+        /// @return The index of the first nonzero coefficient from
+        ///         index (included) in the direction of the direction
+        ///         policy, or symbols() if there is none
+        uint32_t find_nonzero(const value_type *coefficients,
+                              uint32_t index) const
+        {
+            return find_nonzero(coefficients, index,
+                std::is_same<direction_policy,
+                             forward_linear_block_decoder_policy>());
+        }
+
+        /// find_nonzero(const value_type*, uint32_t) const for the
+        /// forward direction
+        uint32_t find_nonzero(const value_type *coefficients,
+                              uint32_t index, std::true_type) const
+        {
+            return SuperCoder::first_nonzero_coefficient(
+                coefficients, index, SuperCoder::symbols());
+        }
+
+        /// find_nonzero(const value_type*, uint32_t) const for the
+        /// backward direction
+        uint32_t find_nonzero(const value_type *coefficients,
+                              uint32_t index, std::false_type) const
+        {
+            if(index >= SuperCoder::symbols())
+                return SuperCoder::symbols();
+
+            uint32_t found = SuperCoder::last_nonzero_coefficient(
+                coefficients, 0, index + 1);
+
+            return found > index ? SuperCoder::symbols() : found;
+        }
+
+    private:
+
+        /// A symbol data operation which has been deferred until the
+        /// end of a decode batch
+        struct symbol_operation
+        {
+            /// The kinds of operations which can be deferred
+            enum operation_type
+            {
+                subtract,
+                multiply_subtract,
+                multiply,
+                copy
+            };
+
+            /// The kind of operation
+            operation_type m_type;
+
+            /// The symbol which is updated
+            value_type *m_dest;
+
+            /// The source symbol, unused by multiply
+            const value_type *m_src;
+
+            /// The coefficient used by multiply and multiply_subtract
+            value_type m_coefficient;
+        };
+
+        /// Adds an operation to the log of deferred operations
+        /// @param type The kind of operation
+        /// @param symbol_dest The destination symbol
+        /// @param symbol_src The source symbol
+        /// @param coefficient The multiplicative constant
+        void log_symbol_operation(
+            typename symbol_operation::operation_type type,
+            value_type *symbol_dest, const value_type *symbol_src,
+            value_type coefficient)
+        {
+            assert(symbol_dest != 0);
+
+            symbol_operation operation;
+            operation.m_type = type;
+            operation.m_dest = symbol_dest;
+            operation.m_src = symbol_src;
+            operation.m_coefficient = coefficient;
+
+            m_symbol_operations.push_back(operation);
+        }
+
+        /// Applies the logged operations tile by tile and removes them
+        /// from the log. Every operation works element-wise, so running
+        /// the operations on one tile at a time gives the same result
+        /// as running each operation on the full symbols. Consecutive
+        /// subtractions from the same symbol are fused into a single
+        /// multiply_subtract_n() call.
+        /// @param first_operation The index of the first logged
+        ///        operation to apply
+        void apply_symbol_operations(std::size_t first_operation)
+        {
+            assert(first_operation <= m_symbol_operations.size());
+
+            auto first = m_symbol_operations.begin() + first_operation;
+            auto last = m_symbol_operations.end();
+
+            if(first == last)
+                return;
+
+            uint32_t symbol_length = SuperCoder::symbol_length();
+            uint32_t symbol_size = SuperCoder::symbol_size();
+
+            // Only a batch touches enough symbols to benefit from the
+            // tiling, operations deferred while searching for a pivot
+            // all update the same symbol
+            uint32_t tile_length = symbol_length;
+
+            if(m_batch)
+            {
+                tile_length = std::max<uint32_t>(
+                    1U, m_batch_tile_size / sizeof(value_type));
+            }
+
+            for(uint32_t offset = 0; offset < symbol_length;
+                offset += tile_length)
+            {
+                uint32_t length = std::min(tile_length, symbol_length - offset);
+
+                for(auto it = first; it != last; )
+                {
+                    const auto& operation = *it;
+
+                    value_type *dest = operation.m_dest + offset;
+
+                    if(is_subtraction(operation))
+                    {
+                        uint32_t sources = 0;
+
+                        // A longer run continues in the next fused
+                        // subtraction
+                        for(; it != last && sources < m_fused_capacity &&
+                                is_subtraction(*it) &&
+                                it->m_dest == operation.m_dest; ++it)
+                        {
+                            m_fused_sources[sources] = it->m_src + offset;
+
+                            m_fused_coefficients[sources] =
+                                it->m_type == symbol_operation::subtract ?
+                                value_type(1) : it->m_coefficient;
+
+                            ++sources;
+                        }
+
+                        SuperCoder::multiply_subtract_n(dest,
+                            m_fused_sources, m_fused_coefficients,
+                            sources, length);
+
+                        continue;
+                    }
+
+                    if(operation.m_type == symbol_operation::multiply)
+                    {
+                        SuperCoder::multiply(dest, operation.m_coefficient,
+                            length);
+                    }
+                    else if(operation.m_dest != operation.m_src)
+                    {
+                        assert(operation.m_type == symbol_operation::copy);
+
+                        const value_type *src = operation.m_src + offset;
+
+                        // The last value may only be partially used by
+                        // the symbol
+                        uint32_t offset_size = offset * sizeof(value_type);
+                        uint32_t copy_size = std::min<uint32_t>(
+                            length * sizeof(value_type),
+                            symbol_size - offset_size);
+
+                        std::copy_n(
+                            reinterpret_cast<const uint8_t*>(src),
+                            copy_size,
+                            reinterpret_cast<uint8_t*>(dest));
+                    }
+
+                    ++it;
+                }
+            }
+
+            m_symbol_operations.erase(first, last);
+        }
+
+        /// @param operation The logged operation
+        /// @return True if the operation subtracts a symbol
+        static bool is_subtraction(const symbol_operation& operation)
+        {
+            return operation.m_type == symbol_operation::subtract ||
+                operation.m_type == symbol_operation::multiply_subtract;
+        }
+
+        /// Counts bytes saved in the operations_counter if the stack
+        /// contains a finite_field_counter
+        /// @param bytes The number of symbol bytes saved
+        void count_bytes_saved(uint64_t bytes)
+        {
+            count_bytes_saved(bytes, std::integral_constant<bool,
+                has_operations_counter<SuperCoder>::value>());
+        }
+
+        /// @copydoc count_bytes_saved(uint64_t)
+        void count_bytes_saved(uint64_t bytes, std::true_type)
+        {
+            SuperCoder::count_bytes_saved(bytes);
+        }
+
+        /// Overload used when the stack does not count operations
+        void count_bytes_saved(uint64_t, std::false_type)
+        { }
+
     protected:
 
         /// Stores the current maximum pivot index
         uint32_t m_maximum_pivot;
 
+    private:
+
+        /// Tracks whether a decode batch is in progress
+        bool m_batch;
+
+        /// The size in bytes of the tiles used to apply the logged
+        /// symbol operations
+        uint32_t m_batch_tile_size;
+
+        /// The symbol operations deferred in the current decode batch
+        std::vector<symbol_operation> m_symbol_operations;
+
+        /// The source symbols of a fused subtraction, room for
+        /// m_fused_capacity pointers in the arena
+        const value_type** m_fused_sources;
+
+        /// The coefficients of a fused subtraction
+        value_type* m_fused_coefficients;
+
+        /// The number of operands of a fused subtraction
+        uint32_t m_fused_capacity;
+
+        /// Tracks whether deferred substitution is enabled
+        bool m_deferred_substitution;
+
+        /// Tracks whether the symbol operations are deferred while
+        /// searching for a pivot outside a decode batch
+        bool m_deferring;
+
+        /// Marks the symbols added uncoded whose unit vector has not been
+        /// written, one byte per symbol.
+        ///
+        /// This and the two members below are the lazy state of the
+        /// unit vectors, and they are mutable state even when reached
+        /// from a const function: the const coefficient vector
+        /// accessors write a pending unit vector and clear its flag.
+        /// This does not change the value a caller observes, but it is
+        /// a write, so the const accessors must not be called
+        /// concurrently from several threads.
+        uint8_t *m_unwritten_vectors;
+
+        /// The coefficient vector storage of the layers below, through
+        /// which the const accessors write pending unit vectors
+        uint8_t *m_coefficient_vectors;
+
+        /// The distance in bytes between two coefficient vectors
+        uint32_t m_coefficient_vector_stride;
+
     };
 
 }
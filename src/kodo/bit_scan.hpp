@@ -0,0 +1,60 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace kodo
+{
+    /// @param word The word to scan, must be non-zero
+    /// @return The index of the lowest set bit in the word
+    inline uint32_t count_trailing_zeros(uint64_t word)
+    {
+        assert(word != 0);
+
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return index;
+#elif defined(_MSC_VER)
+        unsigned long index;
+        if(_BitScanForward(&index, (uint32_t) word))
+            return index;
+
+        _BitScanForward(&index, (uint32_t) (word >> 32));
+        return index + 32;
+#else
+        return (uint32_t) __builtin_ctzll(word);
+#endif
+    }
+
+    /// @param word The word to scan, must be non-zero
+    /// @return The index of the highest set bit in the word
+    inline uint32_t highest_set_bit(uint64_t word)
+    {
+        assert(word != 0);
+
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanReverse64(&index, word);
+        return index;
+#elif defined(_MSC_VER)
+        unsigned long index;
+        if(_BitScanReverse(&index, (uint32_t) (word >> 32)))
+            return index + 32;
+
+        _BitScanReverse(&index, (uint32_t) word);
+        return index;
+#else
+        return 63U - (uint32_t) __builtin_clzll(word);
+#endif
+    }
+}
@@ -8,7 +8,6 @@
 #include <cstdint>
 #include <cassert>
 #include <iostream>
-#include <vector>
 
 #include <fifi/fifi_utils.hpp>
 
@@ -36,7 +35,8 @@ namespace kodo
     /// cached_symbol_coefficients() function.
     ///
     /// Finally the data of the symbol may be retried using the
-    /// cached_symbol_data() function.
+    /// cached_symbol_data() function. The cache is allocated in the
+    /// arena of the coder.
     ///
     /// You can check the example in use_cache_decode_symbol.cpp to see an
     /// example of how to the use cache_decode_symbol layer.
@@ -46,14 +46,47 @@ namespace kodo
     {
     public:
 
+        /// @ingroup factory_base_layers
+        /// @brief Adds the cache to the arena of a coder
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(
+                        SuperCoder::factory_base::max_symbol_size()) +
+                    SuperCoder::factory_base::arena_region_size(
+                        SuperCoder::factory_base::max_coefficient_vector_size());
+            }
+        };
+
+    public:
+
+        /// Constructor
+        cache_decode_symbol()
+            : m_data(0),
+              m_coefficients(0)
+        { }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory& the_factory)
         {
             SuperCoder::construct(the_factory);
 
-            m_data.resize(the_factory.max_symbol_size());
-            m_coefficients.resize(the_factory.max_coefficient_vector_size());
+            m_data = SuperCoder::arena_allocate(
+                the_factory.max_symbol_size());
+
+            m_coefficients = SuperCoder::arena_allocate(
+                the_factory.max_coefficient_vector_size());
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -77,8 +110,8 @@ namespace kodo
             uint32_t symbol_size = SuperCoder::symbol_size();
             uint32_t coef_size = SuperCoder::coefficient_vector_size();
 
-            auto data_dest = sak::storage(m_data);
-            auto coef_dest = sak::storage(m_coefficients);
+            auto data_dest = sak::storage(m_data, symbol_size);
+            auto coef_dest = sak::storage(m_coefficients, coef_size);
 
             auto data_src = sak::storage(symbol_data, symbol_size);
             auto coef_src = sak::storage(symbol_coefficients, coef_size);
@@ -106,7 +139,7 @@ namespace kodo
 
             uint32_t symbol_size = SuperCoder::symbol_size();
 
-            auto data_dest = sak::storage(m_data);
+            auto data_dest = sak::storage(m_data, symbol_size);
             auto data_src = sak::storage(symbol_data, symbol_size);
 
             sak::copy_storage(data_dest, data_src);
@@ -154,14 +187,14 @@ namespace kodo
         const uint8_t* cached_symbol_data() const
         {
             assert(m_valid);
-            return &m_data[0];
+            return m_data;
         }
 
         /// @copydoc cached_symbol_data() const
         uint8_t* cached_symbol_data()
         {
             assert(m_valid);
-            return &m_data[0];
+            return m_data;
         }
 
         /// @return The coding coefficients used to encode the symbol.
@@ -171,7 +204,7 @@ namespace kodo
         {
             assert(m_valid);
             assert(m_symbol_coded);
-            return &m_coefficients[0];
+            return m_coefficients;
         }
 
         /// @copydoc cached_symbol_coefficients() const
@@ -179,7 +212,7 @@ namespace kodo
         {
             assert(m_valid);
             assert(m_symbol_coded);
-            return &m_coefficients[0];
+            return m_coefficients;
         }
 
     private:
@@ -191,10 +224,10 @@ namespace kodo
         uint32_t m_symbol_index;
 
         /// Stores the data of the decoding symbol
-        std::vector<uint8_t> m_data;
+        uint8_t* m_data;
 
         /// If coded stores the coefficients of the decoding symbol
-        std::vector<uint8_t> m_coefficients;
+        uint8_t* m_coefficients;
 
         /// Marks whether the cache is valid
         bool m_valid;
@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include <cassert>
 #include <cstdint>
+#include <vector>
+
 #include <fifi/fifi_utils.hpp>
 #include <sak/storage.hpp>
 
@@ -16,6 +19,15 @@ namespace kodo
     ///
     /// @brief Provides storage and access to the coding coefficients
     ///        used during encoding and decoding.
+    ///
+    /// All the coefficient vectors are stored in one contiguous
+    /// buffer in the arena of the coder. Each vector starts on a row aligned to
+    /// factory_base::coefficient_vector_alignment() bytes, so the
+    /// vectors can be used directly by aligned SIMD kernels and
+    /// walking them touches memory in a predictable order. If the
+    /// alignment of the factory grows after the coder was constructed,
+    /// the vectors are moved to a buffer allocated with the
+    /// layer::allocator_type of the coder.
     template<class SuperCoder>
     class coefficient_storage : public SuperCoder
     {
@@ -27,36 +39,139 @@ namespace kodo
         /// @copydoc layer::value_type
         typedef typename field_type::value_type value_type;
 
+        /// @copydoc layer::allocator_type
+        typedef typename SuperCoder::allocator_type allocator_type;
+
+        /// The default alignment of the coefficient vectors in bytes
+        static const uint32_t default_alignment = 32;
+
     public:
 
+        /// @ingroup factory_base_layers
+        /// The factory_base layer associated with this coder.
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t, uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size),
+                  m_coefficient_vector_alignment(default_alignment)
+            { }
+
+            /// @copydoc layer::factory_base::coefficient_vector_alignment() const
+            uint32_t coefficient_vector_alignment() const
+            {
+                return m_coefficient_vector_alignment;
+            }
+
+            /// @copydoc layer::factory_base::set_coefficient_vector_alignment(uint32_t)
+            void set_coefficient_vector_alignment(uint32_t alignment)
+            {
+                // The alignment must be a power of two
+                assert(alignment > 0);
+                assert((alignment & (alignment - 1)) == 0);
+
+                m_coefficient_vector_alignment = alignment;
+            }
+
+            /// @copydoc layer::factory_base::coefficient_vector_stride() const
+            uint32_t coefficient_vector_stride() const
+            {
+                uint32_t size =
+                    SuperCoder::factory_base::max_coefficient_vector_size();
+
+                uint32_t alignment = m_coefficient_vector_alignment;
+                return ((size + alignment - 1) / alignment) * alignment;
+            }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                uint32_t size =
+                    SuperCoder::factory_base::max_coefficient_vectors() *
+                    coefficient_vector_stride() +
+                    m_coefficient_vector_alignment - 1;
+
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(size);
+            }
+
+        private:
+
+            /// The alignment of the coefficient vectors in bytes
+            uint32_t m_coefficient_vector_alignment;
+        };
+
+    public:
+
+        /// Constructor
+        coefficient_storage()
+            : m_arena_region(0),
+              m_arena_region_size(0),
+              m_coefficients(0),
+              m_coefficient_vectors(0),
+              m_max_coefficient_vector_size(0),
+              m_coefficient_vector_stride(0),
+              m_coefficient_vector_alignment(0)
+        { }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
         {
             SuperCoder::construct(the_factory);
 
-            m_coefficients_storage.resize(
-                the_factory.max_coefficient_vectors());
+            m_coefficient_vectors = the_factory.max_coefficient_vectors();
+            m_max_coefficient_vector_size =
+                the_factory.max_coefficient_vector_size();
+
+            uint32_t alignment = the_factory.coefficient_vector_alignment();
+
+            m_arena_region_size = m_coefficient_vectors *
+                the_factory.coefficient_vector_stride() + alignment - 1;
 
-            for(auto& storage : m_coefficients_storage)
+            m_arena_region = SuperCoder::arena_allocate(m_arena_region_size);
+
+            allocate(alignment);
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            // The alignment may have changed since a recycled coder
+            // was constructed. The coder keeps the number and size of
+            // the vectors it was constructed for, which may be less
+            // than the maximum of the factory when it was constructed
+            // for a size class by the pool_factory.
+            if(m_coefficient_vector_alignment !=
+               the_factory.coefficient_vector_alignment())
             {
-                storage.resize(the_factory.max_coefficient_vector_size());
+                allocate(the_factory.coefficient_vector_alignment());
             }
+        }
 
+        /// @copydoc layer::coefficient_vector_stride() const
+        uint32_t coefficient_vector_stride() const
+        {
+            return m_coefficient_vector_stride;
         }
 
         /// @copydoc layer::coefficient_vector_data(uint32_t)
         uint8_t* coefficient_vector_data(uint32_t index)
         {
             assert(index < SuperCoder::symbols());
-            return &(m_coefficients_storage[index])[0];
+            return m_coefficients + index * m_coefficient_vector_stride;
         }
 
         /// @copydoc layer::coefficient_vector_data(uint32_t) const
         const uint8_t* coefficient_vector_data(uint32_t index) const
         {
             assert(index < SuperCoder::symbols());
-            return &(m_coefficients_storage[index])[0];
+            return m_coefficients + index * m_coefficient_vector_stride;
         }
 
         /// @copydoc layer::coefficient_vector_value(uint32_t)
@@ -90,11 +205,66 @@ namespace kodo
 
     private:
 
-        /// Stores the encoding vectors, we do a vector of vectors
-        /// to maximize chances of proper alignment of individual
-        /// coefficient vectors. This is needed when using SSE etc.
-        /// instructions for fast computations with the coefficients
-        std::vector< std::vector<uint8_t> > m_coefficients_storage;
+        /// Allocates the buffer holding all the coefficient vectors
+        /// @param alignment The alignment of the coefficient vectors
+        void allocate(uint32_t alignment)
+        {
+            m_coefficient_vector_alignment = alignment;
+            m_coefficient_vector_stride =
+                ((m_max_coefficient_vector_size + alignment - 1) /
+                 alignment) * alignment;
+
+            assert(m_coefficient_vectors > 0);
+            assert(m_coefficient_vector_stride > 0);
+
+            // Room for moving the start to an aligned address
+            uint32_t size =
+                m_coefficient_vectors * m_coefficient_vector_stride +
+                m_coefficient_vector_alignment - 1;
+
+            // The vectors are kept in the arena unless the alignment
+            // has grown since the coder was constructed
+            uint8_t* data = m_arena_region;
+
+            if(size > m_arena_region_size)
+            {
+                m_coefficients_storage.resize(size);
+                data = m_coefficients_storage.data();
+            }
+
+            uintptr_t address = reinterpret_cast<uintptr_t>(data);
+
+            uintptr_t mask = m_coefficient_vector_alignment - 1;
+            m_coefficients = data +
+                ((m_coefficient_vector_alignment - (address & mask)) & mask);
+        }
+
+    private:
+
+        /// The region of the arena storing the coefficient vectors
+        uint8_t* m_arena_region;
+
+        /// The size of the arena region in bytes
+        uint32_t m_arena_region_size;
+
+        /// Stores the coefficient vectors if they do not fit in the
+        /// arena region, allocated like the arena
+        std::vector<uint8_t, allocator_type> m_coefficients_storage;
+
+        /// Pointer to the first aligned coefficient vector
+        uint8_t* m_coefficients;
+
+        /// The number of coefficient vectors allocated
+        uint32_t m_coefficient_vectors;
+
+        /// The size in bytes of the largest coefficient vector
+        uint32_t m_max_coefficient_vector_size;
+
+        /// The distance in bytes between two coefficient vectors
+        uint32_t m_coefficient_vector_stride;
+
+        /// The alignment of the coefficient vectors in bytes
+        uint32_t m_coefficient_vector_alignment;
 
     };
 }
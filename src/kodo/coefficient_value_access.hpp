@@ -6,8 +6,12 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 
 #include <fifi/fifi_utils.hpp>
+#include <fifi/is_binary.hpp>
+
+#include "bit_scan.hpp"
 
 namespace kodo
 {
@@ -46,6 +50,137 @@ namespace kodo
             fifi::set_value<field_type>(coefficients, index, value);
         }
 
+        /// @copydoc layer::first_nonzero_coefficient(const value_type*,
+        ///              uint32_t, uint32_t) const
+        uint32_t first_nonzero_coefficient(const value_type* coefficients,
+                                           uint32_t begin,
+                                           uint32_t end) const
+        {
+            assert(coefficients != 0);
+            assert(begin <= end);
+
+            const uint8_t* data =
+                reinterpret_cast<const uint8_t*>(coefficients);
+
+            uint32_t word_elements = coefficients_per_word();
+            uint32_t index = begin;
+
+            while(index < end)
+            {
+                // Skip whole words of zero coefficients
+                if(index % word_elements == 0 &&
+                   end - index >= word_elements)
+                {
+                    if(is_zero_word(data, index))
+                    {
+                        index += word_elements;
+                        continue;
+                    }
+                }
+
+                if(fifi::is_binary<field_type>::value)
+                {
+                    // The remaining bits of the byte
+                    uint32_t bits = data[index / 8] >> (index % 8);
+
+                    if(bits)
+                    {
+                        index += count_trailing_zeros(bits);
+                        return index < end ? index : end;
+                    }
+
+                    index += 8 - (index % 8);
+                }
+                else
+                {
+                    if(fifi::get_value<field_type>(coefficients, index))
+                        return index;
+
+                    ++index;
+                }
+            }
+
+            return end;
+        }
+
+        /// @copydoc layer::last_nonzero_coefficient(const value_type*,
+        ///              uint32_t, uint32_t) const
+        uint32_t last_nonzero_coefficient(const value_type* coefficients,
+                                          uint32_t begin,
+                                          uint32_t end) const
+        {
+            assert(coefficients != 0);
+            assert(begin <= end);
+
+            const uint8_t* data =
+                reinterpret_cast<const uint8_t*>(coefficients);
+
+            uint32_t word_elements = coefficients_per_word();
+            uint32_t index = end;
+
+            while(index > begin)
+            {
+                // Skip whole words of zero coefficients
+                if(index % word_elements == 0 &&
+                   index - begin >= word_elements)
+                {
+                    if(is_zero_word(data, index - word_elements))
+                    {
+                        index -= word_elements;
+                        continue;
+                    }
+                }
+
+                if(fifi::is_binary<field_type>::value)
+                {
+                    // The bits of the byte up to and including index - 1
+                    uint32_t last = index - 1;
+                    uint32_t bits =
+                        data[last / 8] & ((2U << (last % 8)) - 1);
+
+                    index = last - (last % 8);
+
+                    if(bits)
+                    {
+                        uint32_t found = index + highest_set_bit(bits);
+                        return found >= begin ? found : end;
+                    }
+                }
+                else
+                {
+                    --index;
+
+                    if(fifi::get_value<field_type>(coefficients, index))
+                        return index;
+                }
+            }
+
+            return end;
+        }
+
+    private:
+
+        /// @return The number of coefficients in a 64-bit word
+        static uint32_t coefficients_per_word()
+        {
+            return fifi::size_to_elements<field_type>(sizeof(uint64_t));
+        }
+
+        /// @param data The coefficients array
+        /// @param index The index of the first coefficient in the word,
+        ///        must be a multiple of coefficients_per_word()
+        /// @return true if all the coefficients in the word are zero
+        static bool is_zero_word(const uint8_t* data, uint32_t index)
+        {
+            assert(index % coefficients_per_word() == 0);
+
+            uint64_t word;
+            std::memcpy(&word, data + (index / coefficients_per_word()) *
+                        sizeof(uint64_t), sizeof(uint64_t));
+
+            return word == 0;
+        }
+
     };
 
 }
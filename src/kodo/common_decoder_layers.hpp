@@ -7,6 +7,7 @@
 
 #include "trace_linear_block_decoder.hpp"
 #include "trace_decode_symbol.hpp"
+#include "const_symbol_decoder.hpp"
 #include "aligned_coefficients_decoder.hpp"
 #include "forward_linear_block_decoder.hpp"
 #include "rank_info.hpp"
@@ -24,9 +25,10 @@ namespace kodo
     using common_decoder_layers =
                trace_decode_symbol<TraceTag,
                trace_linear_block_decoder<TraceTag,
+               const_symbol_decoder<
                aligned_coefficients_decoder<
                forward_linear_block_decoder<
                rank_info<
                symbol_decoding_status_counter<
-               symbol_decoding_status_tracker<SuperCoder> > > > > > >;
+               symbol_decoding_status_tracker<SuperCoder> > > > > > > >;
 }
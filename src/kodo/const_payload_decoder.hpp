@@ -0,0 +1,47 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace kodo
+{
+    /// @ingroup payload_codec_layers
+    ///
+    /// @brief Adds layer::decode(const uint8_t*) which leaves the
+    ///        payload unchanged.
+    ///
+    /// Unlike the copy_payload_decoder the payload is not copied up
+    /// front. Uncoded symbols are copied directly from the payload
+    /// into the decoder storage, and coded symbols are copied once
+    /// into the storage of a missing symbol by the
+    /// const_symbol_decoder layer, which must be further down the
+    /// stack. Useful for relays and others who need the payload after
+    /// decoding it.
+    template<class SuperCoder>
+    class const_payload_decoder : public SuperCoder
+    {
+    public:
+
+        /// Do not hide the decode(uint8_t*) function
+        using SuperCoder::decode;
+
+        /// @copydoc layer::decode(const uint8_t*)
+        void decode(const uint8_t *payload)
+        {
+            assert(payload != 0);
+
+            SuperCoder::begin_const_decode();
+
+            // The layers below only read the payload while in the
+            // const decode
+            SuperCoder::decode(const_cast<uint8_t*>(payload));
+
+            SuperCoder::end_const_decode();
+        }
+    };
+}
@@ -0,0 +1,148 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+
+namespace kodo
+{
+    /// @ingroup decoder_layers
+    ///
+    /// @brief Decodes symbols without modifying the symbol data and
+    ///        the coefficients passed in.
+    ///
+    /// Between layer::begin_const_decode() and
+    /// layer::end_const_decode() the coded symbols passed to
+    /// layer::decode_symbol(uint8_t*, uint8_t*) are treated as read
+    /// only. The symbol data is copied into the storage of the first
+    /// missing symbol and eliminated there, so if that symbol becomes
+    /// the pivot the decoder needs no further copy. The coefficients
+    /// are copied into an internal buffer. Uncoded symbols are only
+    /// read by the decoder and are passed on unchanged. The internal
+    /// buffers are allocated in the arena of the coder.
+    template<class SuperCoder>
+    class const_symbol_decoder : public SuperCoder
+    {
+    public:
+
+        /// @ingroup factory_base_layers
+        /// @brief Adds the buffers to the arena of a coder
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(
+                        SuperCoder::factory_base::max_symbol_size()) +
+                    SuperCoder::factory_base::arena_region_size(
+                        SuperCoder::factory_base::max_coefficient_vector_size());
+            }
+        };
+
+    public:
+
+        /// Constructor
+        const_symbol_decoder()
+            : m_const_decode(false),
+              m_symbol(0),
+              m_coefficients(0)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_symbol = SuperCoder::arena_allocate(
+                the_factory.max_symbol_size());
+
+            m_coefficients = SuperCoder::arena_allocate(
+                the_factory.max_coefficient_vector_size());
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+            m_const_decode = false;
+        }
+
+        /// @copydoc layer::begin_const_decode()
+        void begin_const_decode()
+        {
+            assert(!m_const_decode);
+            m_const_decode = true;
+        }
+
+        /// @copydoc layer::end_const_decode()
+        void end_const_decode()
+        {
+            assert(m_const_decode);
+            m_const_decode = false;
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
+        void decode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(!m_const_decode)
+            {
+                SuperCoder::decode_symbol(symbol_data, coefficients);
+                return;
+            }
+
+            // The storage of a missing symbol is unused, so the
+            // symbol can be eliminated there
+            uint32_t index = SuperCoder::next_symbol_missing(0);
+
+            uint8_t *symbol = m_symbol;
+
+            if(index < SuperCoder::symbols() &&
+               SuperCoder::is_symbol_available(index))
+            {
+                symbol = SuperCoder::symbol(index);
+            }
+
+            std::copy_n(symbol_data, SuperCoder::symbol_size(), symbol);
+            std::copy_n(coefficients, SuperCoder::coefficient_vector_size(),
+                        m_coefficients);
+
+            SuperCoder::decode_symbol(symbol, m_coefficients);
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint32_t)
+        void decode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            SuperCoder::decode_symbol(symbol_data, symbol_index);
+        }
+
+    private:
+
+        /// True between begin_const_decode() and end_const_decode()
+        bool m_const_decode;
+
+        /// Symbol buffer used when no missing symbol can be used
+        uint8_t* m_symbol;
+
+        /// Copy of the coefficients
+        uint8_t* m_coefficients;
+    };
+}
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <vector>
 
@@ -20,7 +22,9 @@ namespace kodo
     ///        buffer internally.
     ///
     /// This is useful in cases where incoming data is to be
-    /// decoded and no existing decoding buffer exist.
+    /// decoded and no existing decoding buffer exist. The buffer and
+    /// the status of the symbols are allocated in the arena of the
+    /// coder, see the final_layer.
     template<class SuperCoder>
     class deep_symbol_storage : public SuperCoder
     {
@@ -31,6 +35,42 @@ namespace kodo
 
     public:
 
+        /// @ingroup factory_base_layers
+        /// @brief Adds the symbol storage to the arena of a coder
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                uint32_t max_symbols =
+                    SuperCoder::factory_base::max_symbols();
+
+                uint32_t max_symbol_size =
+                    SuperCoder::factory_base::max_symbol_size();
+
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(
+                        max_symbols * max_symbol_size) +
+                    SuperCoder::factory_base::arena_region_size(max_symbols);
+            }
+        };
+
+    public:
+
+        /// Constructor
+        deep_symbol_storage()
+            : m_data(0),
+              m_data_size(0),
+              m_symbols(0)
+        { }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory& the_factory)
@@ -43,11 +83,17 @@ namespace kodo
             assert(max_data_needed > 0);
 
             // Construct should only be called once so
-            // m_data.size() should be zero
-            assert(m_data.size() == 0);
-            m_data.resize(max_data_needed, 0);
+            // m_data should not be allocated
+            assert(m_data == 0);
 
-            m_symbols.resize(the_factory.max_symbols(), false);
+            // The arena is cleared when it is allocated
+            m_data = SuperCoder::arena_allocate(max_data_needed);
+            m_data_size = max_data_needed;
+
+            m_symbols = SuperCoder::arena_allocate(the_factory.max_symbols());
+
+            m_dirty_size = 0;
+            m_dirty_symbols = 0;
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -59,17 +105,27 @@ namespace kodo
             /// @todo This should not be necessary - we should not
             ///       use data which has not been initialized yet
             ///       anyway
-            std::fill(m_data.begin(), m_data.end(), 0);
-            std::fill(m_symbols.begin(), m_symbols.end(), false);
+            ///
+            /// Only the part used by the previous block can have
+            /// been written, so only that part is cleared.
+            std::fill_n(m_data, m_dirty_size, 0);
+            std::fill_n(m_symbols, m_dirty_symbols, 0);
 
             m_symbols_count = 0;
+
+            m_dirty_size =
+                the_factory.symbols() * the_factory.symbol_size();
+            m_dirty_symbols = the_factory.symbols();
+
+            assert(m_dirty_size <= m_data_size);
+            assert(m_dirty_symbols <= the_factory.max_symbols());
         }
 
         /// @copydoc layer::symbol(uint32_t)
         uint8_t* symbol(uint32_t index)
         {
             assert(index < SuperCoder::symbols());
-            return &m_data[index * SuperCoder::symbol_size()];
+            return m_data + index * SuperCoder::symbol_size();
         }
 
         /// @copydoc layer::symbol_value(uint32_t)
@@ -82,7 +138,7 @@ namespace kodo
         const uint8_t* symbol(uint32_t index) const
         {
             assert(index < SuperCoder::symbols());
-            return &m_data[index * SuperCoder::symbol_size()];
+            return m_data + index * SuperCoder::symbol_size();
         }
 
         /// @copydoc layer::symbol_value(uint32_t) const
@@ -91,14 +147,20 @@ namespace kodo
             return reinterpret_cast<const value_type*>(symbol(index));
         }
 
-        /// @copydoc layer::swap_symbols(std::vector<uint8_t> &)
+        /// @copydoc layer::swap_symbols(std::vector<uint8_t>&)
         void swap_symbols(std::vector<uint8_t> &symbols)
         {
-            assert(m_data.size() == symbols.size());
-            m_data.swap(symbols);
+            assert(m_data_size == symbols.size());
+
+            // The buffer lives in the arena, so the content is
+            // exchanged instead of the buffers
+            std::swap_ranges(symbols.begin(), symbols.end(), m_data);
+
+            // The whole buffer may have been written by the user
+            m_dirty_size = m_data_size;
 
             m_symbols_count = SuperCoder::symbols();
-            std::fill(m_symbols.begin(), m_symbols.end(), true);
+            std::fill_n(m_symbols, SuperCoder::symbols(), 1);
         }
 
         /// @copydoc layer::set_symbols(const sak::const_storage&)
@@ -110,13 +172,13 @@ namespace kodo
                    SuperCoder::symbols() * SuperCoder::symbol_size());
 
             // Use the copy function
-            copy_storage(sak::storage(m_data), symbol_storage);
+            copy_storage(sak::storage(m_data, m_data_size), symbol_storage);
 
             // This will specify all symbols, also in the case
             // of partial data. If this is not desired then the
             // symbols need to be set individually.
             m_symbols_count = SuperCoder::symbols();
-            std::fill(m_symbols.begin(), m_symbols.end(), true);
+            std::fill_n(m_symbols, SuperCoder::symbols(), 1);
         }
 
         /// @copydoc layer::set_symbol(uint32_t, const sak::const_storage&)
@@ -132,20 +194,23 @@ namespace kodo
 
             assert(index < SuperCoder::symbols());
 
-            sak::mutable_storage dest_data = sak::storage(m_data);
+            sak::mutable_storage dest_data = sak::storage(m_data, m_data_size);
 
             uint32_t offset = index * SuperCoder::symbol_size();
             dest_data += offset;
 
             assert(dest_data.m_size >= SuperCoder::symbol_size());
 
-            // Copy the data
-            sak::copy_storage(dest_data, symbol);
+            // Copy the data, unless it was decoded in place
+            if(symbol.m_data != dest_data.m_data)
+            {
+                sak::copy_storage(dest_data, symbol);
+            }
 
-            if(m_symbols[index] == false)
+            if(m_symbols[index] == 0)
             {
                 ++m_symbols_count;
-                m_symbols[index] = true;
+                m_symbols[index] = 1;
             }
 
         }
@@ -161,7 +226,7 @@ namespace kodo
 
             /// Wrap our buffer in a storage object
             sak::const_storage src_storage =
-                sak::storage(&m_data[0], data_to_copy);
+                sak::storage(m_data, data_to_copy);
 
             /// Use the copy_storage() function to copy the data
             sak::copy_storage(dest_storage, src_storage);
@@ -236,19 +301,30 @@ namespace kodo
         /// @copydoc layer::is_symbol_initialized(uint32_t) const
         bool is_symbol_initialized(uint32_t symbol_index) const
         {
-            return m_symbols[symbol_index];
+            return m_symbols[symbol_index] != 0;
         }
 
     private:
 
-        /// Storage for the symbol data
-        std::vector<uint8_t> m_data;
+        /// Storage for the symbol data in the arena
+        uint8_t* m_data;
+
+        /// The size of the symbol data storage in bytes
+        uint32_t m_data_size;
 
         /// Symbols count
         uint32_t m_symbols_count;
 
-        /// Tracks which symbols have been set
-        std::vector<bool> m_symbols;
+        /// Tracks which symbols have been set, one byte per symbol
+        uint8_t* m_symbols;
+
+        /// The number of bytes at the start of the data which may
+        /// be non-zero
+        uint32_t m_dirty_size;
+
+        /// The number of symbols at the start of m_symbols which may
+        /// be marked as set
+        uint32_t m_dirty_symbols;
 
     };
 }
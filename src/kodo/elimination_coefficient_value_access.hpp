@@ -75,6 +75,32 @@ namespace kodo
             SuperCoder::set_coefficient_value(coefficients, index, value);
         }
 
+        /// @copydoc coefficient_value_access::first_nonzero_coefficient(
+        ///             const value_type*, uint32_t, uint32_t) const
+        uint32_t first_nonzero_coefficient(const value_type* coefficients,
+                                           uint32_t begin,
+                                           uint32_t end) const
+        {
+            assert(end <= SuperCoder::symbols());
+            uint32_t offset = SuperCoder::elimination_offset();
+
+            return SuperCoder::first_nonzero_coefficient(
+                coefficients, begin + offset, end + offset) - offset;
+        }
+
+        /// @copydoc coefficient_value_access::last_nonzero_coefficient(
+        ///             const value_type*, uint32_t, uint32_t) const
+        uint32_t last_nonzero_coefficient(const value_type* coefficients,
+                                          uint32_t begin,
+                                          uint32_t end) const
+        {
+            assert(end <= SuperCoder::symbols());
+            uint32_t offset = SuperCoder::elimination_offset();
+
+            return SuperCoder::last_nonzero_coefficient(
+                coefficients, begin + offset, end + offset) - offset;
+        }
+
     };
 
 }
@@ -0,0 +1,22 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "basic_sparse_uniform_generator.hpp"
+#include "xoshiro256_generator_policy.hpp"
+
+namespace kodo
+{
+    /// @ingroup coefficient_generator_layers
+    /// @brief Generate uniformly distributed coefficients with a specific
+    /// density using the xoshiro256** generator, which draws the
+    /// positions of the nonzero coefficients two at a time.
+    template<class SuperCoder>
+    class fast_sparse_uniform_generator : public
+        basic_sparse_uniform_generator<xoshiro256_generator_policy,
+                                       SuperCoder>
+    { };
+}
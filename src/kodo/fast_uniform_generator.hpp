@@ -0,0 +1,26 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "basic_uniform_generator.hpp"
+#include "xoshiro256_generator_policy.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup coefficient_generator_layers
+    /// @brief Generates an uniform random coefficient (from the chosen
+    /// Finite Field) for every symbol using the xoshiro256** generator,
+    /// which fills the coefficient vectors eight bytes at a time.
+    ///
+    /// The coefficients generated from a seed differ from the ones of
+    /// the uniform_generator, so this generator is only suitable for
+    /// codes which send the coefficients.
+    template<class SuperCoder>
+    class fast_uniform_generator : public
+        basic_uniform_generator<xoshiro256_generator_policy, SuperCoder>
+    { };
+}
@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
+#include <memory>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -18,14 +21,41 @@ namespace kodo
     ///
     /// @brief Terminates the layered coder and contains the coder
     ///        allocation policy
+    ///
+    /// The buffers of a coder are carved from a single arena, which
+    /// is allocated when the coder is constructed. Each layer using
+    /// the arena adds the size of its buffers to
+    /// layer::factory_base::arena_size() and takes them with
+    /// layer::arena_allocate(uint32_t) in its construct() after the
+    /// layers below it, so the buffers are laid out in the order of
+    /// the layers. The arena is allocated with the
+    /// layer::allocator_type of the factory and cleared by the
+    /// thread constructing the coder. Apart from the coder itself and
+    /// any nested coder, such as the recoding stack of the RLNC
+    /// decoders, this is the only allocation made when a coder of the
+    /// RLNC stacks is constructed.
     class final_layer
     {
+    public:
+
+        /// @copydoc layer::allocator_type
+        typedef std::allocator<uint8_t> allocator_type;
+
+        /// The alignment in bytes of the buffers in the arena, the
+        /// size of a cache line
+        static const uint32_t arena_alignment = 64;
+
     public:
 
         /// @ingroup factory_layers
         /// The final factory
         class factory_base
         {
+        public:
+
+            /// @copydoc layer::allocator_type
+            typedef final_layer::allocator_type allocator_type;
+
         public:
 
             /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
@@ -34,16 +64,60 @@ namespace kodo
                 (void) max_symbols;
                 (void) max_symbol_size;
             }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                return 0;
+            }
+
+            /// @copydoc layer::factory_base::arena_region_size(uint32_t)
+            static uint32_t arena_region_size(uint32_t size)
+            {
+                return ((size + arena_alignment - 1) / arena_alignment) *
+                    arena_alignment;
+            }
         };
 
     public:
 
+        /// Constructor
+        final_layer()
+            : m_arena_data(0),
+              m_arena_size(0),
+              m_arena_used(0)
+        { }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
         {
-            /// This is the final factory layer so we do nothing
-            (void) the_factory;
+            // Construct should only be called once
+            assert(!m_arena);
+
+            typedef typename Factory::allocator_type arena_allocator;
+
+            m_arena_size = the_factory.arena_size();
+            m_arena_used = 0;
+
+            if(m_arena_size == 0)
+                return;
+
+            // Room for moving the start to an aligned address
+            uint32_t allocated = m_arena_size + arena_alignment - 1;
+
+            arena_allocator allocator;
+            m_arena = arena_pointer(
+                allocator.allocate(allocated),
+                arena_deleter(&deallocate<arena_allocator>, allocated));
+
+            std::fill_n(m_arena.get(), allocated, 0);
+
+            uintptr_t address = reinterpret_cast<uintptr_t>(m_arena.get());
+            uintptr_t mask = arena_alignment - 1;
+
+            m_arena_data = m_arena.get() +
+                ((arena_alignment - (address & mask)) & mask);
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -62,5 +136,94 @@ namespace kodo
             (void) the_factory;
         }
 
+        /// @copydoc layer::arena_allocate(uint32_t)
+        uint8_t* arena_allocate(uint32_t size)
+        {
+            uint32_t region = factory_base::arena_region_size(size);
+            assert(m_arena_used + region <= m_arena_size);
+
+            uint8_t* data = m_arena_data + m_arena_used;
+            m_arena_used += region;
+
+            return data;
+        }
+
+        /// @copydoc layer::arena_size() const
+        uint32_t arena_size() const
+        {
+            return m_arena_size;
+        }
+
+        /// @copydoc layer::arena_used() const
+        uint32_t arena_used() const
+        {
+            return m_arena_used;
+        }
+
+    private:
+
+        /// Returns the arena to the allocator it was allocated with
+        struct arena_deleter
+        {
+            /// The function deallocating the arena
+            typedef void (*deallocate_function)(uint8_t*, uint32_t);
+
+            /// Constructor
+            arena_deleter()
+                : m_deallocate(0),
+                  m_size(0)
+            { }
+
+            /// Constructor
+            /// @param deallocate The function deallocating the arena
+            /// @param size The size in bytes allocated for the arena
+            arena_deleter(deallocate_function deallocate, uint32_t size)
+                : m_deallocate(deallocate),
+                  m_size(size)
+            { }
+
+            /// @param data The memory allocated for the arena
+            void operator()(uint8_t* data) const
+            {
+                assert(m_deallocate);
+                m_deallocate(data, m_size);
+            }
+
+            /// The function deallocating the arena
+            deallocate_function m_deallocate;
+
+            /// The size in bytes allocated for the arena
+            uint32_t m_size;
+        };
+
+        /// Owns the arena, unlike a shared pointer it needs no
+        /// allocation of its own
+        typedef std::unique_ptr<uint8_t, arena_deleter> arena_pointer;
+
+        /// Deallocates the arena with a new instance of the allocator
+        /// it was allocated with
+        /// @param data The memory allocated for the arena
+        /// @param size The size in bytes allocated for the arena
+        template<class Allocator>
+        static void deallocate(uint8_t* data, uint32_t size)
+        {
+            Allocator allocator;
+            allocator.deallocate(data, size);
+        }
+
+    private:
+
+        /// The memory allocated for the arena
+        arena_pointer m_arena;
+
+        /// The aligned start of the arena
+        uint8_t* m_arena_data;
+
+        /// The size of the arena in bytes
+        uint32_t m_arena_size;
+
+        /// The number of bytes handed out from the arena
+        uint32_t m_arena_used;
+
     };
 }
@@ -87,6 +87,54 @@ namespace kodo
                                  symbol_length);
         }
 
+        /// Counts one add or multiply_add for each source symbol,
+        /// matching the operation used for its coefficient
+        ///
+        /// @copydoc layer::multiply_add_n(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_add_n(value_type *symbol_dest,
+                            const value_type * const *symbol_src,
+                            const value_type *coefficients,
+                            uint32_t count, uint32_t symbol_length)
+        {
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                if(coefficients[i] == 1)
+                    ++m_counter.m_add;
+                else if(coefficients[i])
+                    ++m_counter.m_multiply_add;
+            }
+
+            SuperCoder::multiply_add_n(symbol_dest, symbol_src,
+                                       coefficients, count,
+                                       symbol_length);
+        }
+
+        /// Counts one subtract or multiply_subtract for each source
+        /// symbol, matching the operation used for its coefficient
+        ///
+        /// @copydoc layer::multiply_subtract_n(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_subtract_n(value_type *symbol_dest,
+                                 const value_type * const *symbol_src,
+                                 const value_type *coefficients,
+                                 uint32_t count, uint32_t symbol_length)
+        {
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                if(coefficients[i] == 1)
+                    ++m_counter.m_subtract;
+                else if(coefficients[i])
+                    ++m_counter.m_multiply_subtract;
+            }
+
+            SuperCoder::multiply_subtract_n(symbol_dest, symbol_src,
+                                            coefficients, count,
+                                            symbol_length);
+        }
+
         /// @copydoc layer::invert(value_type)
         value_type invert(value_type value)
         {
@@ -94,6 +142,13 @@ namespace kodo
             return SuperCoder::invert(value);
         }
 
+        /// Counts symbol bytes which a decoder skipped processing
+        /// @param bytes The number of bytes saved
+        void count_bytes_saved(uint64_t bytes)
+        {
+            m_counter.m_bytes_saved += bytes;
+        }
+
         /// @return The operation counter
         operations_counter get_operations_counter() const
         {
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <type_traits>
 
@@ -15,6 +16,12 @@ namespace kodo
 
     /// @ingroup finite_field_layers
     /// @brief Basic layer performing common finite field operation
+    ///
+    /// The fused multiply_add_n() and multiply_subtract_n() operations
+    /// combine several source symbols into the destination symbol
+    /// one tile at a time. Each destination tile therefore stays in
+    /// the cache while all the sources are applied to it, instead of
+    /// being read and written once per source symbol.
     template<class FieldImpl, class SuperCoder>
     class finite_field_math : public SuperCoder
     {
@@ -32,6 +39,10 @@ namespace kodo
         /// Pointer to the finite field implementation
         typedef std::shared_ptr<field_impl> field_pointer;
 
+        /// The size in bytes of the destination tiles used by the
+        /// fused operations
+        static const uint32_t fused_tile_size = 4096;
+
     private:
 
         /// The field type of the finite field implementation
@@ -173,6 +184,116 @@ namespace kodo
             m_field->region_subtract(symbol_dest, symbol_src, symbol_length);
         }
 
+        /// @copydoc layer::multiply_add_n(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_add_n(value_type *symbol_dest,
+                            const value_type * const *symbol_src,
+                            const value_type *coefficients,
+                            uint32_t count, uint32_t symbol_length)
+        {
+            assert(m_field);
+            assert(symbol_dest != 0);
+            assert(symbol_src != 0 || count == 0);
+            assert(coefficients != 0 || count == 0);
+            assert(symbol_length > 0);
+
+            uint32_t tile_length = fused_tile_length();
+
+            for(uint32_t offset = 0; offset < symbol_length;
+                offset += tile_length)
+            {
+                uint32_t length =
+                    std::min(tile_length, symbol_length - offset);
+
+                value_type *dest = symbol_dest + offset;
+
+                for(uint32_t i = 0; i < count; ++i)
+                {
+                    value_type coefficient = coefficients[i];
+
+                    if(!coefficient)
+                        continue;
+
+                    assert(symbol_src[i] != 0);
+                    const value_type *src = symbol_src[i] + offset;
+
+                    if(coefficient == 1)
+                    {
+                        m_field->region_add(dest, src, length);
+                    }
+                    else
+                    {
+                        coefficient =
+                            fifi::pack_constant<field_type>(coefficient);
+
+                        m_field->region_multiply_add(
+                            dest, src, coefficient, length);
+                    }
+                }
+            }
+        }
+
+        /// @copydoc layer::run_symbol_ranges(uint32_t, const Function&)
+        template<class Function>
+        void run_symbol_ranges(uint32_t symbol_length,
+                               const Function& function)
+        {
+            assert(symbol_length > 0);
+            function(0, symbol_length);
+        }
+
+        /// @copydoc layer::multiply_subtract_n(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_subtract_n(value_type *symbol_dest,
+                                 const value_type * const *symbol_src,
+                                 const value_type *coefficients,
+                                 uint32_t count, uint32_t symbol_length)
+        {
+            assert(m_field);
+            assert(symbol_dest != 0);
+            assert(symbol_src != 0 || count == 0);
+            assert(coefficients != 0 || count == 0);
+            assert(symbol_length > 0);
+
+            uint32_t tile_length = fused_tile_length();
+
+            for(uint32_t offset = 0; offset < symbol_length;
+                offset += tile_length)
+            {
+                uint32_t length =
+                    std::min(tile_length, symbol_length - offset);
+
+                value_type *dest = symbol_dest + offset;
+
+                for(uint32_t i = 0; i < count; ++i)
+                {
+                    value_type coefficient = coefficients[i];
+
+                    if(!coefficient)
+                        continue;
+
+                    assert(symbol_src[i] != 0);
+                    assert(symbol_src[i] != symbol_dest);
+                    const value_type *src = symbol_src[i] + offset;
+
+                    if(coefficient == 1)
+                    {
+                        m_field->region_subtract(dest, src, length);
+                    }
+                    else
+                    {
+                        coefficient =
+                            fifi::pack_constant<field_type>(coefficient);
+
+                        m_field->region_multiply_subtract(
+                            dest, src, coefficient, length);
+                    }
+                }
+            }
+        }
+
         /// @copydoc layer::invert(value_type)
         value_type invert(value_type value)
         {
@@ -180,6 +301,16 @@ namespace kodo
             return m_field->invert( value );
         }
 
+    private:
+
+        /// @return The length in value_type elements of the destination
+        ///         tiles used by the fused operations
+        static uint32_t fused_tile_length()
+        {
+            return std::max<uint32_t>(
+                1U, fused_tile_size / sizeof(value_type));
+        }
+
     private:
 
         /// The selected field
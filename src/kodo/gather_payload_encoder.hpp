@@ -0,0 +1,50 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace kodo
+{
+    /// @ingroup payload_codec_layers
+    ///
+    /// @brief Encodes a payload without copying uncoded source
+    ///        symbols, for use with scatter-gather I/O such as
+    ///        sendmsg().
+    ///
+    /// The payload buffer has the layout of layer::encode(uint8_t*),
+    /// but for uncoded symbols only the header is written and a
+    /// pointer to the source symbol in the encoder storage is
+    /// returned instead. With a shallow storage encoder this is the
+    /// memory of the user, so the packet can be sent as the two
+    /// buffers {symbol, payload + symbol_size()} without ever copying
+    /// the source data. Requires the symbol_reference_encoder layer
+    /// further down the stack.
+    template<class SuperCoder>
+    class gather_payload_encoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::encode_gather(uint8_t*, const uint8_t**)
+        uint32_t encode_gather(uint8_t *payload, const uint8_t **symbol)
+        {
+            assert(payload != 0);
+            assert(symbol != 0);
+
+            SuperCoder::begin_symbol_reference();
+
+            uint32_t bytes_used = SuperCoder::encode(payload);
+
+            const uint8_t* reference = SuperCoder::end_symbol_reference();
+
+            // Coded symbols are written to the payload as usual
+            *symbol = reference != 0 ? reference : payload;
+
+            return bytes_used;
+        }
+    };
+}
@@ -0,0 +1,46 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace kodo
+{
+
+    /// @ingroup type_traits
+    /// Type trait helper allows compile time detection of whether a
+    /// factory contains a layer with the member function
+    /// set_size_class()
+    ///
+    /// Example:
+    ///
+    /// typedef kodo::full_rlnc8_encoder::factory factory_t;
+    ///
+    /// if(kodo::has_set_size_class<factory_t>::value)
+    /// {
+    ///     // Do something here
+    /// }
+    ///
+    template<typename T>
+    struct has_set_size_class
+    {
+    private:
+        typedef std::true_type yes;
+        typedef std::false_type no;
+
+        template<typename U>
+        static auto test(int) ->
+            decltype(std::declval<U>().set_size_class(0, 0), yes());
+
+        template<typename> static no test(...);
+
+    public:
+
+        static const bool value = std::is_same<decltype(test<T>(0)),yes>::value;
+    };
+
+}
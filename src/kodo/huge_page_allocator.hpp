@@ -0,0 +1,164 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <sys/mman.h>
+
+namespace kodo
+{
+    /// @brief Allocator backing large buffers with huge pages.
+    ///
+    /// Decoding a large generation touches the whole symbol and
+    /// coefficient buffers for every symbol, which causes many TLB
+    /// misses with 4 KiB pages. Buffers of at least
+    /// huge_page_size bytes are therefore allocated with mmap()
+    /// rounded up to whole huge pages. The allocator first asks for
+    /// pages from the reserved huge page pool (MAP_HUGETLB) and if
+    /// the pool is empty maps ordinary pages aligned to a huge page
+    /// and marks them for transparent huge pages (MADV_HUGEPAGE).
+    /// Smaller buffers are allocated with operator new, since a
+    /// huge page for each of them would waste memory.
+    ///
+    /// The allocator is stateless and may be used in the
+    /// storage_allocator layer. On platforms without huge pages it
+    /// uses ordinary pages.
+    template<class T>
+    class huge_page_allocator
+    {
+    public:
+
+        /// The type allocated
+        typedef T value_type;
+
+        /// The size in bytes of a huge page, buffers smaller than
+        /// this are not mapped
+        static const std::size_t huge_page_size = 2U << 20;
+
+        /// Rebinds the allocator to another type
+        template<class U>
+        struct rebind
+        {
+            /// The rebound allocator
+            typedef huge_page_allocator<U> other;
+        };
+
+    public:
+
+        /// Constructor
+        huge_page_allocator()
+        { }
+
+        /// Copy constructor from an allocator of another type
+        template<class U>
+        huge_page_allocator(const huge_page_allocator<U>&)
+        { }
+
+        /// @param n The number of elements to allocate
+        /// @return The allocated memory
+        T* allocate(std::size_t n)
+        {
+            std::size_t size = n * sizeof(T);
+
+            if(size < huge_page_size)
+                return static_cast<T*>(::operator new(size));
+
+            void* data = map(mapped_size(size));
+
+            if(data == 0)
+                throw std::bad_alloc();
+
+            return static_cast<T*>(data);
+        }
+
+        /// @param data The memory to release
+        /// @param n The number of elements allocated
+        void deallocate(T* data, std::size_t n)
+        {
+            std::size_t size = n * sizeof(T);
+
+            if(size < huge_page_size)
+            {
+                ::operator delete(data);
+                return;
+            }
+
+            int result = ::munmap(data, mapped_size(size));
+            assert(result == 0);
+            (void) result;
+        }
+
+        /// @return True since all instances are interchangeable
+        bool operator==(const huge_page_allocator&) const
+        {
+            return true;
+        }
+
+        /// @return False since all instances are interchangeable
+        bool operator!=(const huge_page_allocator&) const
+        {
+            return false;
+        }
+
+    private:
+
+        /// @param size The size of a buffer in bytes
+        /// @return The size of the buffer rounded up to huge pages
+        static std::size_t mapped_size(std::size_t size)
+        {
+            return ((size + huge_page_size - 1) / huge_page_size) *
+                huge_page_size;
+        }
+
+        /// Maps memory backed by huge pages if possible
+        /// @param size The size to map, a multiple of huge_page_size
+        /// @return The mapped memory or 0 if no memory is available
+        static void* map(std::size_t size)
+        {
+#ifdef MAP_HUGETLB
+            void* hugetlb = ::mmap(0, size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+            if(hugetlb != MAP_FAILED)
+                return hugetlb;
+#endif
+
+            // Transparent huge pages are only used for the part of a
+            // mapping aligned to huge pages, so an extra huge page is
+            // mapped and the unaligned ends are unmapped again
+            std::size_t padded_size = size + huge_page_size;
+
+            void* mapped = ::mmap(0, padded_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if(mapped == MAP_FAILED)
+                return 0;
+
+            uint8_t* start = static_cast<uint8_t*>(mapped);
+            uintptr_t address = reinterpret_cast<uintptr_t>(start);
+
+            std::size_t head = (huge_page_size -
+                (address & (huge_page_size - 1))) & (huge_page_size - 1);
+            std::size_t tail = padded_size - head - size;
+
+            if(head > 0)
+                ::munmap(start, head);
+
+            if(tail > 0)
+                ::munmap(start + head + size, tail);
+
+#ifdef MADV_HUGEPAGE
+            ::madvise(start + head, size, MADV_HUGEPAGE);
+#endif
+
+            return start + head;
+        }
+    };
+}
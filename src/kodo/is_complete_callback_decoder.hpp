@@ -12,7 +12,8 @@ namespace kodo
     /// @ingroup payload_codec_layers
     ///
     /// @brief Checks whether the layer::is_complete() status changes
-    ///        after calling layer::decode(uint8_t*) if
+    ///        after calling layer::decode(uint8_t*) or
+    ///        layer::decode(const uint8_t*) if
     ///        layer::is_complete() returns true the callback will be
     ///        invoked.
     ///
@@ -53,7 +54,28 @@ namespace kodo
         void decode(uint8_t *payload)
         {
             SuperCoder::decode(payload);
+            invoke_callback();
+        }
+
+        /// @copydoc layer::decode(const uint8_t*)
+        void decode(const uint8_t *payload)
+        {
+            SuperCoder::decode(payload);
+            invoke_callback();
+        }
 
+        /// @copydoc layer::decode_batch(uint8_t**, uint32_t)
+        void decode_batch(uint8_t **payloads, uint32_t count)
+        {
+            SuperCoder::decode_batch(payloads, count);
+            invoke_callback();
+        }
+
+    private:
+
+        /// Invokes the callback the first time decoding is complete
+        void invoke_callback()
+        {
             if (!SuperCoder::is_complete())
             {
                 return;
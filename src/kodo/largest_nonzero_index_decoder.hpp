@@ -109,8 +109,9 @@ namespace kodo
             value_type *coefficients
                 = reinterpret_cast<value_type*>(symbol_coefficients);
 
-            // We inspect the coefficients from the back i.e. if we
-            // are given the following coding vector:
+            // We look for the last non-zero coefficient beyond the
+            // largest index seen so far i.e. if we are given the
+            // following coding vector:
             //
             // 23 0 44 213 0 231 0
             //                ^
@@ -118,23 +119,19 @@ namespace kodo
             //                +-----+ max position of non-zero
             //                        coefficient
             //
-            // Starting from the back will in many cases e.g. for uniform
-            // coding vectors be better, since we are looking for the last
-            // non-zero element.
-            assert(SuperCoder::symbols() > m_largest_nonzero_index);
+            // The coefficients are inspected from the back a word at
+            // a time, which is fast for both uniform coding vectors
+            // and sparse coding vectors.
+            uint32_t symbols = SuperCoder::symbols();
+            assert(symbols > m_largest_nonzero_index);
 
-            for (uint32_t i = SuperCoder::symbols();
-                 i --> m_largest_nonzero_index;)
+            uint32_t index = SuperCoder::last_nonzero_coefficient(
+                coefficients, m_largest_nonzero_index, symbols);
+
+            if (index < symbols)
             {
-                value_type current_coefficient
-                    = SuperCoder::coefficient_value(coefficients, i);
-
-                if (current_coefficient)
-                {
-                    m_nonzero_seen = true;
-                    m_largest_nonzero_index = i;
-                    break;
-                }
+                m_nonzero_seen = true;
+                m_largest_nonzero_index = index;
             }
 
             SuperCoder::decode_symbol(symbol_data, symbol_coefficients);
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 
 #include <boost/optional.hpp>
@@ -22,6 +24,14 @@ namespace kodo
     /// effect and can therefore improve the decoding throughput when
     /// decoding sparse symbols, in particular if the generation size
     /// is large.
+    ///
+    /// By default the final backward substitution is blocked: the
+    /// symbols are solved from the last pivot towards the first, each
+    /// from the symbols already solved, and the symbol operations are
+    /// applied one tile of the symbols at a time as in a decode batch.
+    /// Every tile of a symbol thereby receives all its updates while
+    /// it is in the cache, instead of the symbol memory being passed
+    /// over once for every pivot.
     template<class SuperCoder>
     class linear_block_decoder_delayed : public SuperCoder
     {
@@ -38,6 +48,11 @@ namespace kodo
 
     public:
 
+        /// Constructor
+        linear_block_decoder_delayed()
+            : m_blocked_backward_substitution(true)
+        { }
+
         /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
         void decode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
         {
@@ -88,6 +103,22 @@ namespace kodo
 
         }
 
+        /// @return True if the final backward substitution is blocked
+        bool blocked_backward_substitution() const
+        {
+            return m_blocked_backward_substitution;
+        }
+
+        /// Enables or disables the blocked final backward substitution.
+        /// When disabled every pivot is substituted into the other
+        /// symbols in turn. The size of the tiles is set with
+        /// set_batch_tile_size().
+        /// @param enable True to block the final backward substitution
+        void set_blocked_backward_substitution(bool enable)
+        {
+            m_blocked_backward_substitution = enable;
+        }
+
     protected:
 
         // Fetch the variables needed
@@ -145,6 +176,97 @@ namespace kodo
         {
             assert(SuperCoder::is_complete());
 
+            if(m_blocked_backward_substitution)
+            {
+                blocked_backward_substitute();
+            }
+            else
+            {
+                pivot_backward_substitute();
+            }
+        }
+
+    private:
+
+        /// Solves the symbols one at a time from the last pivot towards
+        /// the first. The encoding vector of a symbol only has non-zero
+        /// coefficients at its pivot and at the pivots following it in
+        /// the direction of the decoder, which are solved already. The
+        /// symbol operations are logged as a decode batch, so they are
+        /// applied tile by tile and the subtractions from each symbol
+        /// are fused.
+        void blocked_backward_substitute()
+        {
+            uint32_t symbols = SuperCoder::symbols();
+
+            uint32_t first = direction_policy::min(0, symbols - 1);
+            uint32_t last = direction_policy::max(0, symbols - 1);
+
+            // Inside a decode batch the operations are applied when the
+            // batch ends
+            bool batch = SuperCoder::is_decode_batch();
+
+            if(!batch)
+                SuperCoder::begin_decode_batch();
+
+            for(uint32_t n = 0; n < symbols; ++n)
+            {
+                uint32_t i = first < last ? last - n : last + n;
+
+                // The uncoded symbols are solved already
+                if(!SuperCoder::is_symbol_seen(i))
+                    continue;
+
+                value_type *symbol_i = SuperCoder::symbol_value(i);
+                value_type *vector_i =
+                    SuperCoder::stored_coefficient_vector_values(i);
+
+                assert(SuperCoder::coefficient_value(vector_i, i) == 1U);
+
+                if(i != last)
+                {
+                    uint32_t next = first < last ? i + 1 : i - 1;
+
+                    for(direction_policy p(next, last); !p.at_end();
+                        p.advance())
+                    {
+                        uint32_t j = p.index();
+
+                        value_type value =
+                            SuperCoder::coefficient_value(vector_i, j);
+
+                        if(!value)
+                            continue;
+
+                        const value_type *symbol_j =
+                            SuperCoder::symbol_value(j);
+
+                        if(fifi::is_binary<field_type>::value)
+                        {
+                            SuperCoder::symbol_subtract(symbol_i, symbol_j);
+                        }
+                        else
+                        {
+                            SuperCoder::symbol_multiply_subtract(
+                                symbol_i, symbol_j, value);
+                        }
+                    }
+                }
+
+                // The solved symbol has the unit vector
+                std::fill_n(vector_i,
+                    SuperCoder::coefficient_vector_length(), 0);
+
+                SuperCoder::set_coefficient_value(vector_i, i, 1U);
+            }
+
+            if(!batch)
+                SuperCoder::end_decode_batch();
+        }
+
+        /// Substitutes every pivot into the other symbols in turn
+        void pivot_backward_substitute()
+        {
             uint32_t start = direction_policy::min(0, SuperCoder::symbols()-1);
             uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
 
@@ -153,10 +275,17 @@ namespace kodo
                 uint32_t i = p.index();
 
                 value_type *symbol_i = SuperCoder::symbol_value(i);
-                value_type *vector_i = SuperCoder::coefficient_vector_values(i);
+                // The unwritten unit vectors are not read
+                value_type *vector_i =
+                    SuperCoder::stored_coefficient_vector_values(i);
 
                 SuperCoder::backward_substitute(symbol_i, vector_i, i);
             }
         }
+
+    private:
+
+        /// Tracks whether the final backward substitution is blocked
+        bool m_blocked_backward_substitution;
     };
 }
@@ -5,9 +5,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
+#include <vector>
 
-#include <fifi/is_binary.hpp>
 #include <fifi/fifi_utils.hpp>
 
 #include <sak/storage.hpp>
@@ -20,7 +22,22 @@ namespace kodo
     ///
     /// This type of encoder iterates
     /// over a coefficient vector and combines symbols according
-    /// to the coefficients selected.
+    /// to the coefficients selected. All symbols with a nonzero
+    /// coefficient are combined in a single fused multiply_add_n()
+    /// call.
+    ///
+    /// Between layer::begin_encode_batch() and
+    /// layer::end_encode_batch() the encoded symbols are only
+    /// recorded. When the batch ends all of them are produced in one
+    /// pass over the source symbols: the symbol data is processed in
+    /// tiles, and every source tile is loaded once and accumulated
+    /// into the tiles of all the encoded symbols. The tiles are
+    /// processed with layer::run_symbol_ranges(), so the
+    /// threaded_finite_field_math layer splits them across its
+    /// threads.
+    ///
+    /// The symbols and coefficients gathered for multiply_add_n() are
+    /// kept in the arena of the coder.
     template<class SuperCoder>
     class linear_block_encoder : public SuperCoder
     {
@@ -32,8 +49,62 @@ namespace kodo
         /// @copydoc layer::value_type
         typedef typename SuperCoder::value_type value_type;
 
+        /// The size in bytes of the tiles of all the encoded symbols
+        /// of a batch together
+        static const uint32_t batch_tile_size = 32768;
+
     public:
 
+        /// @ingroup factory_base_layers
+        /// @brief Adds the gathered symbols and coefficients to the
+        ///        arena of a coder
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                uint32_t symbols = SuperCoder::factory_base::max_symbols();
+
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(
+                        symbols * sizeof(const value_type*)) +
+                    SuperCoder::factory_base::arena_region_size(
+                        symbols * sizeof(value_type));
+            }
+        };
+
+    public:
+
+        /// Constructor
+        linear_block_encoder()
+            : m_sources(0),
+              m_coefficients(0),
+              m_batch(false)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            uint32_t symbols = the_factory.max_symbols();
+
+            m_sources = reinterpret_cast<const value_type**>(
+                SuperCoder::arena_allocate(
+                    symbols * sizeof(const value_type*)));
+
+            m_coefficients = reinterpret_cast<value_type*>(
+                SuperCoder::arena_allocate(symbols * sizeof(value_type)));
+        }
+
         /// @copydoc layer::encode_symbol(uint8_t*,uint32_t)
         void encode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
         {
@@ -60,14 +131,23 @@ namespace kodo
             const value_type *c =
                 reinterpret_cast<const value_type*>(coefficients);
 
-            for(uint32_t i = 0; i < SuperCoder::symbols(); ++i)
+            if(m_batch)
             {
-                value_type value = SuperCoder::coefficient_value(c, i);
+                record_symbol(symbol, c);
+                return;
+            }
 
-                if(!value)
-                {
-                    continue;
-                }
+            uint32_t sources = 0;
+            uint32_t symbols = SuperCoder::symbols();
+
+            // Only the nonzero coefficients are visited
+            for(uint32_t i = SuperCoder::first_nonzero_coefficient(
+                    c, 0, symbols);
+                i < symbols;
+                i = SuperCoder::first_nonzero_coefficient(c, i + 1, symbols))
+            {
+                value_type value = SuperCoder::coefficient_value(c, i);
+                assert(value);
 
                 const value_type *symbol_i = SuperCoder::symbol_value( i );
 
@@ -76,19 +156,186 @@ namespace kodo
 
                 assert(SuperCoder::is_symbol_pivot(i));
 
-                if(fifi::is_binary<field_type>::value)
+                m_sources[sources] = symbol_i;
+                m_coefficients[sources] = value;
+                ++sources;
+            }
+
+            if(sources == 0)
+            {
+                return;
+            }
+
+            SuperCoder::multiply_add_n(symbol, m_sources, m_coefficients,
+                sources, SuperCoder::symbol_length());
+        }
+
+        /// @copydoc layer::begin_encode_batch()
+        void begin_encode_batch()
+        {
+            assert(!m_batch);
+
+            m_batch = true;
+            m_batch_symbols.clear();
+            m_batch_coefficients.clear();
+        }
+
+        /// @copydoc layer::end_encode_batch()
+        void end_encode_batch()
+        {
+            assert(m_batch);
+
+            m_batch = false;
+
+            uint32_t count = (uint32_t) m_batch_symbols.size();
+
+            if(count == 0)
+            {
+                return;
+            }
+
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t symbol_length = SuperCoder::symbol_length();
+
+            // Order the coefficients by source symbol, so those of a
+            // source symbol for all the encoded symbols are adjacent
+            m_batch_columns.resize(symbols * count);
+
+            for(uint32_t j = 0; j < count; ++j)
+            {
+                for(uint32_t i = 0; i < symbols; ++i)
                 {
-                    SuperCoder::add(symbol, symbol_i,
-                                    SuperCoder::symbol_length());
+                    m_batch_columns[i * count + j] =
+                        m_batch_coefficients[j * symbols + i];
                 }
-                else
+            }
+
+            // The tiles of the encoded symbols and of the current
+            // source symbol stay in the cache together
+            uint32_t tile_length =
+                batch_tile_size / ((count + 1) * sizeof(value_type));
+
+            // Round to whole cache lines
+            uint32_t line_length = 64 / sizeof(value_type);
+            tile_length = std::max(line_length,
+                                   tile_length / line_length * line_length);
+
+            SuperCoder::run_symbol_ranges(symbol_length,
+                [&](uint32_t range_offset, uint32_t range_length)
+            {
+                encode_tiles(range_offset, range_length, tile_length);
+            });
+        }
+
+    private:
+
+        /// Produces a range of the encoded symbols of the current
+        /// batch one tile at a time
+        /// @param range_offset The offset of the range in value_type
+        ///        elements
+        /// @param range_length The length of the range in value_type
+        ///        elements
+        /// @param tile_length The length of a tile in value_type
+        ///        elements
+        void encode_tiles(uint32_t range_offset, uint32_t range_length,
+                          uint32_t tile_length)
+        {
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t count = (uint32_t) m_batch_symbols.size();
+
+            uint32_t range_end = range_offset + range_length;
+
+            for(uint32_t offset = range_offset; offset < range_end;
+                offset += tile_length)
+            {
+                uint32_t length = std::min(tile_length, range_end - offset);
+
+                for(uint32_t i = 0; i < symbols; ++i)
                 {
-                    SuperCoder::multiply_add(symbol, symbol_i, value,
-                        SuperCoder::symbol_length());
+                    const value_type *coefficients =
+                        &m_batch_columns[i * count];
+
+                    const value_type *source = 0;
+
+                    for(uint32_t j = 0; j < count; ++j)
+                    {
+                        value_type coefficient = coefficients[j];
+
+                        if(!coefficient)
+                            continue;
+
+                        if(source == 0)
+                        {
+                            source = SuperCoder::symbol_value(i) + offset;
+                        }
+
+                        value_type *dest = m_batch_symbols[j] + offset;
+
+                        if(coefficient == 1)
+                        {
+                            SuperCoder::add(dest, source, length);
+                        }
+                        else
+                        {
+                            SuperCoder::multiply_add(dest, source,
+                                                     coefficient, length);
+                        }
+                    }
                 }
             }
         }
 
+        /// Records an encoded symbol of the current batch
+        /// @param symbol The buffer of the encoded symbol
+        /// @param coefficients The coding coefficients, which are
+        ///        copied since the buffer is reused by the caller
+        void record_symbol(value_type *symbol, const value_type *coefficients)
+        {
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t count = (uint32_t) m_batch_symbols.size();
+
+            m_batch_coefficients.resize(symbols * (count + 1), 0);
+            value_type *row = &m_batch_coefficients[symbols * count];
+
+            for(uint32_t i = SuperCoder::first_nonzero_coefficient(
+                    coefficients, 0, symbols);
+                i < symbols;
+                i = SuperCoder::first_nonzero_coefficient(
+                    coefficients, i + 1, symbols))
+            {
+                // Did you forget to set the data on the encoder?
+                assert(SuperCoder::symbol_value(i) != 0);
+                assert(SuperCoder::is_symbol_pivot(i));
+
+                row[i] = SuperCoder::coefficient_value(coefficients, i);
+            }
+
+            m_batch_symbols.push_back(symbol);
+        }
+
+    private:
+
+        /// The symbols combined in the current encoding, room for
+        /// max_symbols() pointers in the arena
+        const value_type** m_sources;
+
+        /// The coefficients of the symbols in m_sources
+        value_type* m_coefficients;
+
+        /// True between begin_encode_batch() and end_encode_batch()
+        bool m_batch;
+
+        /// The buffers of the encoded symbols of the current batch
+        std::vector<value_type*> m_batch_symbols;
+
+        /// The coefficients of the encoded symbols of the current
+        /// batch, one row of symbols() values per encoded symbol
+        std::vector<value_type> m_batch_coefficients;
+
+        /// The coefficients of the current batch ordered by source
+        /// symbol
+        std::vector<value_type> m_batch_columns;
+
     };
 
 }
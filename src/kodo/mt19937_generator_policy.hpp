@@ -0,0 +1,150 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include <boost/random/bernoulli_distribution.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+namespace kodo
+{
+    /// @brief Random generator policy for the coefficient generators
+    ///        drawing every value from a boost::random::mt19937.
+    ///
+    /// The values are drawn exactly as the coefficient generators
+    /// have always drawn them, also in the order of generate_sparse(),
+    /// so a seed produces the same coefficients as in earlier
+    /// versions. Use this policy where the coefficients are
+    /// reproduced from a seed on the other side of the network, e.g.
+    /// in the seed codes.
+    class mt19937_generator_policy
+    {
+    public:
+
+        /// The random generator used
+        typedef boost::random::mt19937 generator_type;
+
+        /// The type of the seed
+        typedef generator_type::result_type seed_type;
+
+    public:
+
+        /// @param seed_value The seed of the random generator
+        void seed(seed_type seed_value)
+        {
+            m_random_generator.seed(seed_value);
+        }
+
+        /// Fills a buffer with uniform random bytes
+        /// @param data The buffer to fill
+        /// @param size The size of the buffer in bytes
+        void generate(uint8_t* data, uint32_t size)
+        {
+            assert(data != 0);
+
+            boost::random::uniform_int_distribution<uint8_t> distribution;
+
+            for(uint32_t i = 0; i < size; ++i)
+            {
+                data[i] = distribution(m_random_generator);
+            }
+        }
+
+        /// @param min The smallest value to generate
+        /// @param max The largest value to generate
+        /// @return A uniform random value in [min, max]
+        template<class ValueType>
+        ValueType generate_value(ValueType min, ValueType max)
+        {
+            assert(min <= max);
+
+            boost::random::uniform_int_distribution<ValueType>
+                distribution(min, max);
+
+            return distribution(m_random_generator);
+        }
+
+        /// Fills a bit mask where each bit is set with a given
+        /// probability. The bits are stored least significant bit
+        /// first, i.e. in the layout of a fifi::binary vector.
+        /// @param mask The buffer of at least (count + 7) / 8 bytes
+        /// @param count The number of bits to generate
+        /// @param density The probability that a bit is set
+        void generate_mask(uint8_t* mask, uint32_t count, double density)
+        {
+            assert(mask != 0);
+
+            std::memset(mask, 0, (count + 7) / 8);
+
+            boost::random::bernoulli_distribution<> bernoulli(density);
+
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                if(bernoulli(m_random_generator))
+                {
+                    mask[i / 8] |= 1 << (i % 8);
+                }
+            }
+        }
+
+        /// Fills a sparse coefficient vector. The positions are visited
+        /// in increasing order, and for every position accepted by the
+        /// filter a Bernoulli draw decides whether the coefficient is
+        /// nonzero, immediately followed by the draw of its value.
+        /// Positions rejected by the filter are skipped without
+        /// drawing. This is the order in which the sparse generators
+        /// have always drawn the coefficients.
+        /// @param coefficients The coefficient vector, which must be
+        ///        zero initialized
+        /// @param count The number of coefficients
+        /// @param density The probability that a coefficient is nonzero
+        /// @param filter Returns true for the index of a coefficient
+        ///        which may be nonzero
+        template<class Field, class Filter>
+        void generate_sparse(typename Field::value_type* coefficients,
+                             uint32_t count, double density,
+                             const Filter& filter)
+        {
+            typedef typename Field::value_type value_type;
+
+            assert(coefficients != 0);
+
+            boost::random::bernoulli_distribution<> bernoulli(density);
+
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                if(!filter(i) || !bernoulli(m_random_generator))
+                {
+                    continue;
+                }
+
+                if(fifi::is_binary<Field>::value)
+                {
+                    fifi::set_value<Field>(coefficients, i, 1);
+                }
+                else
+                {
+                    fifi::set_value<Field>(coefficients, i,
+                        generate_value(value_type(1),
+                                       value_type(Field::max_value)));
+                }
+            }
+        }
+
+    private:
+
+        /// The random generator
+        generator_type m_random_generator;
+
+    };
+}
@@ -79,6 +79,10 @@ namespace kodo
             assert(index < Super::symbols());
             assert(Super::is_symbol_available(index));
 
+            // A symbol received directly into its place needs no copy
+            if(src.m_data == symbol(index))
+                return;
+
             sak::mutable_storage dest =
                 sak::storage(symbol(index), Super::symbol_size());
 
@@ -5,10 +5,12 @@
 
 #pragma once
 
+#include "../gather_payload_encoder.hpp"
 #include "../payload_encoder.hpp"
 #include "../final_layer.hpp"
 #include "../finite_field_info.hpp"
 #include "../disable_trace.hpp"
+#include "../symbol_reference_encoder.hpp"
 #include "../deep_storage_layers.hpp"
 
 #include "carousel_encoder.hpp"
@@ -24,10 +26,12 @@ namespace kodo
     template<class TraceTag = kodo::disable_trace>
     class nocode_carousel_encoder : public
         // Payload Codec API
+        gather_payload_encoder<
         payload_encoder<
         // Codec Header API
         carousel_encoder<
         // Codec API
+        symbol_reference_encoder<
         nocode_encoder<
         // Symbol Storage API
         deep_storage_layers<TraceTag,
@@ -35,7 +39,7 @@ namespace kodo
         finite_field_info<fifi::binary,
         // Final Layer
         final_layer
-        > > > > >
+        > > > > > > >
     {
     public:
         using factory = pool_factory<nocode_carousel_encoder>;
@@ -0,0 +1,173 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+namespace kodo
+{
+    /// @brief Allocator placing buffers on the NUMA node of the
+    ///        allocating thread.
+    ///
+    /// Buffers of at least a page are allocated with mmap() and bound
+    /// to the node of the CPU the allocating thread runs on with a
+    /// preferred memory policy, so the pages come from that node no
+    /// matter which thread first touches them and other nodes are
+    /// only used when the node runs out of memory. Smaller buffers
+    /// are allocated with operator new.
+    ///
+    /// Used in the storage_allocator layer the buffers of a codec are
+    /// allocated on the node of the thread constructing it. Note
+    /// that the pool_factory reuses codecs, so a codec keeps the node
+    /// of the thread which first built it. Use a factory for each
+    /// worker thread, and pin the worker threads to their nodes, to
+    /// keep the buffers local to the threads using them.
+    ///
+    /// On platforms where the memory policy cannot be set the pages
+    /// are placed by the operating system, which for Linux is the
+    /// node of the thread first writing them.
+    template<class T>
+    class numa_local_allocator
+    {
+    public:
+
+        /// The type allocated
+        typedef T value_type;
+
+        /// Rebinds the allocator to another type
+        template<class U>
+        struct rebind
+        {
+            /// The rebound allocator
+            typedef numa_local_allocator<U> other;
+        };
+
+    public:
+
+        /// Constructor
+        numa_local_allocator()
+        { }
+
+        /// Copy constructor from an allocator of another type
+        template<class U>
+        numa_local_allocator(const numa_local_allocator<U>&)
+        { }
+
+        /// @param n The number of elements to allocate
+        /// @return The allocated memory
+        T* allocate(std::size_t n)
+        {
+            std::size_t size = n * sizeof(T);
+
+            if(size < page_size())
+                return static_cast<T*>(::operator new(size));
+
+            void* data = ::mmap(0, size, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if(data == MAP_FAILED)
+                throw std::bad_alloc();
+
+            bind_to_local_node(data, size);
+
+            return static_cast<T*>(data);
+        }
+
+        /// @param data The memory to release
+        /// @param n The number of elements allocated
+        void deallocate(T* data, std::size_t n)
+        {
+            std::size_t size = n * sizeof(T);
+
+            if(size < page_size())
+            {
+                ::operator delete(data);
+                return;
+            }
+
+            int result = ::munmap(data, size);
+            assert(result == 0);
+            (void) result;
+        }
+
+        /// @return True since all instances are interchangeable
+        bool operator==(const numa_local_allocator&) const
+        {
+            return true;
+        }
+
+        /// @return False since all instances are interchangeable
+        bool operator!=(const numa_local_allocator&) const
+        {
+            return false;
+        }
+
+        /// @return The NUMA node of the CPU the calling thread runs
+        ///         on, 0 if it cannot be determined
+        static uint32_t local_node()
+        {
+#if defined(__linux__) && defined(SYS_getcpu)
+            unsigned int cpu = 0;
+            unsigned int node = 0;
+
+            if(::syscall(SYS_getcpu, &cpu, &node, 0) == 0)
+                return node;
+#endif
+            return 0;
+        }
+
+    private:
+
+        /// @return The size of a page in bytes
+        static std::size_t page_size()
+        {
+            static const std::size_t size = ::sysconf(_SC_PAGESIZE);
+            return size;
+        }
+
+        /// Sets a preferred memory policy for the node of the calling
+        /// thread on a mapping, the mapping is left unchanged if the
+        /// policy cannot be set
+        /// @param data The start of the mapping
+        /// @param size The size of the mapping in bytes
+        static void bind_to_local_node(void* data, std::size_t size)
+        {
+#if defined(__linux__) && defined(SYS_mbind)
+            // The MPOL_PREFERRED policy from <numaif.h>, which is
+            // only available with libnuma
+            const int preferred_policy = 1;
+
+            const uint32_t word_bits = 8 * sizeof(unsigned long);
+            const uint32_t max_nodes = 1024;
+
+            uint32_t node = local_node();
+
+            if(node >= max_nodes)
+                return;
+
+            unsigned long node_mask[max_nodes / word_bits] = { 0 };
+            node_mask[node / word_bits] = 1UL << (node % word_bits);
+
+            // The kernel ignores the last bit of the mask
+            ::syscall(SYS_mbind, data, size, preferred_policy,
+                      node_mask, max_nodes + 1, 0);
+#else
+            (void) data;
+            (void) size;
+#endif
+        }
+    };
+}
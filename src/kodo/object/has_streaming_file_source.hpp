@@ -0,0 +1,43 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+#include "streaming_file_source.hpp"
+
+namespace kodo
+{
+namespace object
+{
+    /// @ingroup type_traits
+    ///
+    /// Type trait helper allows compile time detection of whether an
+    /// object encoder contains the streaming_file_source layer, i.e.
+    /// whether its block encoders share a bounded ring of buffers
+    ///
+    /// Example:
+    ///
+    /// typedef kodo::object::streaming_file_encoder<
+    ///     kodo::shallow_full_rlnc_encoder<fifi::binary8>> encoder_t;
+    ///
+    /// if(kodo::object::has_streaming_file_source<encoder_t>::value)
+    /// {
+    ///     // Do something here
+    /// }
+    ///
+    template<class T>
+    struct has_streaming_file_source
+    {
+        template<class U>
+        static uint8_t test(const streaming_file_source<U> *);
+
+        static uint32_t test(...);
+
+        static const bool value = sizeof(test(static_cast<T*>(0))) == 1;
+    };
+}
+}
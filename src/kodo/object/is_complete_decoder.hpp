@@ -5,9 +5,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <cassert>
-#include <vector>
+#include <memory>
 #include <cstdint>
 
 namespace kodo
@@ -24,9 +25,18 @@ namespace object
     /// callback function. This functionality will be available in
     /// stacks using the is_complete_callback_decoder.hpp layer.
     ///
+    /// The completion state is kept in atomics, so the decoders of
+    /// different blocks may complete concurrently on different
+    /// threads, e.g. when used with the parallel_object_coder.
+    ///
     template<class SuperCoder>
     class is_complete_decoder : public SuperCoder
     {
+    public:
+
+        /// The block completion callback type
+        using block_callback = std::function<void(uint32_t)>;
+
     public:
 
         /// @copydoc layer::initialize(Factory&)
@@ -35,9 +45,15 @@ namespace object
         {
             SuperCoder::initialize(the_factory);
             m_completed_count = 0;
+            m_block_callback = nullptr;
 
-            m_completed.resize(SuperCoder::blocks());
-            fill(begin(m_completed), end(m_completed), false);
+            m_block_count = SuperCoder::blocks();
+            m_completed.reset(new std::atomic<bool>[m_block_count]);
+
+            for (uint32_t i = 0; i < m_block_count; ++i)
+            {
+                m_completed[i] = false;
+            }
         }
 
         /// @param index Index of the block to build an encoder or
@@ -79,27 +95,51 @@ namespace object
             return m_completed[index];
         }
 
+        /// Sets a callback which is invoked with the index of a block
+        /// once its decoder completes. The callback is invoked on the
+        /// thread decoding the block.
+        ///
+        /// @param callback The callback, or nullptr to remove it
+        void set_block_complete_callback(const block_callback& callback)
+        {
+            m_block_callback = callback;
+        }
+
     private:
 
         /// The callback function which will be invoked by the
         /// different decoders once they complete.
         void is_complete_callback(uint32_t index)
         {
-            assert(index < m_completed.size());
-            assert(m_completed[index] == false);
+            assert(index < m_block_count);
+
+            bool completed = m_completed[index].exchange(true);
+            assert(completed == false);
+            (void) completed;
 
-            ++m_completed_count;
-            assert(m_completed_count <= m_completed.size());
-            m_completed[index] = true;
+            uint32_t count = ++m_completed_count;
+            assert(count <= m_block_count);
+            (void) count;
+
+            if(m_block_callback)
+            {
+                m_block_callback(index);
+            }
         }
 
     private:
 
         /// Keeps track of the number of completed blocks
-        uint32_t m_completed_count;
+        std::atomic<uint32_t> m_completed_count;
+
+        /// The number of blocks tracked
+        uint32_t m_block_count;
 
         /// Keeps track of which of the blocks are completed
-        std::vector<bool> m_completed;
+        std::unique_ptr<std::atomic<bool>[]> m_completed;
+
+        /// Invoked when a block completes
+        block_callback m_block_callback;
     };
 }
 }
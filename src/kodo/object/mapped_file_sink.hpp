@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <boost/iostreams/device/mapped_file.hpp>
 #include <sak/storage.hpp>
 
@@ -31,19 +33,20 @@ namespace object
 
             /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
             factory_base(uint32_t symbols, uint32_t symbol_size)
-                : SuperCoder::factory_base(symbols, symbol_size)
+                : SuperCoder::factory_base(symbols, symbol_size),
+                  m_file_size(0)
             { }
 
             /// @param file_size Set the size in bytes of the file we
             ///        want to decode
-            void set_file_size(uint32_t file_size)
+            void set_file_size(uint64_t file_size)
             {
                 assert(file_size > 0);
                 m_file_size = file_size;
             }
 
             /// @return The size in bytes of the file we want to decode
-            uint32_t file_size() const
+            uint64_t file_size() const
             {
                 assert(m_file_size > 0);
                 return m_file_size;
@@ -53,7 +56,7 @@ namespace object
 
             /// The size in bytes of the file we want to create an
             /// object decoder for
-            uint32_t m_file_size;
+            uint64_t m_file_size;
         };
 
     public:
@@ -78,8 +81,10 @@ namespace object
 
             assert(m_file.is_open());
 
+            // The size of the file may exceed the size of a storage
+            // object, so the pointer and size are passed separately
             the_factory.set_storage(
-                sak::storage(m_file.data(), m_file.size()));
+                reinterpret_cast<uint8_t*>(m_file.data()), m_file.size());
 
             SuperCoder::initialize(the_factory);
         }
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <boost/iostreams/device/mapped_file.hpp>
 #include <sak/storage.hpp>
 
@@ -37,7 +39,11 @@ namespace object
 
             assert(m_file.is_open());
 
-            the_factory.set_storage(sak::storage(m_file.data(), m_file.size()));
+            // The size of the file may exceed the size of a storage
+            // object, so the pointer and size are passed separately
+            the_factory.set_storage(
+                reinterpret_cast<const uint8_t*>(m_file.data()),
+                m_file.size());
 
             SuperCoder::initialize(the_factory);
         }
@@ -5,7 +5,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
+#include <limits>
+#include <utility>
 
 namespace kodo
 {
@@ -24,6 +28,10 @@ namespace object
     /// the layer will copy the storage object and use it to
     /// initialize the actual encoders/decoders build with the right
     /// piece of memory using the layer::set_symbols() function.
+    ///
+    /// The object size and the block offsets are 64 bit, so objects
+    /// larger than 4 GB (e.g. memory mapped files) can be used. Only
+    /// the storage handed to each block has to fit the storage type.
     template<class SuperCoder>
     class object_storage : public SuperCoder
     {
@@ -35,6 +43,10 @@ namespace object
         /// The storage type
         using storage_type = typename stack_type::storage_type;
 
+        /// The pointer type of the storage
+        using data_pointer =
+            decltype(std::declval<storage_type>().m_data);
+
     public:
 
         /// @ingroup factory_base_layers
@@ -48,38 +60,65 @@ namespace object
 
             /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
             factory_base(uint32_t symbols, uint32_t symbol_size)
-                : SuperCoder::factory_base(symbols, symbol_size)
+                : SuperCoder::factory_base(symbols, symbol_size),
+                  m_data(0),
+                  m_object_size(0)
             { }
 
             /// @param storage The object storage that should be used
             void set_storage(const storage_type& storage)
             {
-                assert(storage.m_data != 0);
-                assert(storage.m_size > 0);
+                set_storage(storage.m_data, storage.m_size);
+            }
 
-                m_storage = storage;
+            /// @param data Pointer to the object storage that should
+            ///        be used
+            /// @param size The size of the object storage in bytes
+            void set_storage(data_pointer data, uint64_t size)
+            {
+                assert(data != 0);
+                assert(size > 0);
+
+                m_data = data;
+                m_object_size = size;
             }
 
-            /// @return The stored storage object
-            const storage_type& storage() const
+            /// @return The stored storage object. Only available for
+            ///         objects which fit the storage type.
+            storage_type storage() const
             {
-                assert(m_storage.m_data != 0);
-                assert(m_storage.m_size > 0);
+                assert(m_data != 0);
+                assert(m_object_size > 0);
+                assert(m_object_size <= std::numeric_limits<
+                       decltype(storage_type().m_size)>::max());
+
+                storage_type storage;
+                storage.m_data = m_data;
+                storage.m_size = m_object_size;
+                return storage;
+            }
 
-                return m_storage;
+            /// @return Pointer to the object storage
+            data_pointer data() const
+            {
+                assert(m_data != 0);
+                return m_data;
             }
 
             /// @return The size of the object storage
-            uint32_t object_size() const
+            uint64_t object_size() const
             {
-                assert(m_storage.m_size > 0);
-                return m_storage.m_size;
+                assert(m_object_size > 0);
+                return m_object_size;
             }
 
         protected:
 
-            /// The storage of the object to encode
-            storage_type m_storage;
+            /// Pointer to the storage of the object
+            data_pointer m_data;
+
+            /// The size of the object in bytes
+            uint64_t m_object_size;
         };
 
     public:
@@ -90,7 +129,8 @@ namespace object
         {
             SuperCoder::initialize(the_factory);
 
-            m_storage = the_factory.storage();
+            m_data = the_factory.data();
+            m_object_size = the_factory.object_size();
         }
 
         /// @param index Index of the block to build an encoder or
@@ -104,35 +144,44 @@ namespace object
             auto stack = SuperCoder::build(index);
             assert(stack);
 
-            uint32_t offset = SuperCoder::byte_offset(index);
+            uint64_t offset = SuperCoder::byte_offset(index);
             uint32_t block_size = SuperCoder::block_size(index);
 
-            storage_type data = m_storage;
-            assert(data.m_data != 0);
-            assert(data.m_size > offset);
-
-            // Adjust the size of the buffer to fit this stack
-            data.m_data += offset;
-            data.m_size -= offset;
+            assert(m_data != 0);
+            assert(m_object_size > offset);
 
-            // Make sure we do not exceed the block size
-            data.m_size = std::min(block_size, data.m_size);
+            // Adjust the buffer to fit this stack and make sure we do
+            // not exceed the block size
+            storage_type data;
+            data.m_data = m_data + offset;
+            data.m_size = (uint32_t) std::min<uint64_t>(
+                block_size, m_object_size - offset);
 
             stack->set_symbols(data);
 
             return stack;
         }
 
-        /// @return the storage used for this object
-        const storage_type& storage() const
+        /// @return Pointer to the storage used for this object
+        data_pointer data() const
+        {
+            return m_data;
+        }
+
+        /// @return The size in bytes of the object
+        uint64_t object_size() const
         {
-            return m_storage;
+            return m_object_size;
         }
 
     protected:
 
-        /// Stores the storage for the object being encoded or decoded
-        storage_type m_storage;
+        /// Pointer to the storage of the object being encoded or
+        /// decoded
+        data_pointer m_data;
+
+        /// The size of the object in bytes
+        uint64_t m_object_size;
     };
 }
 }
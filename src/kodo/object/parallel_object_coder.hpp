@@ -0,0 +1,514 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "has_streaming_file_source.hpp"
+
+namespace kodo
+{
+namespace object
+{
+    /// @ingroup object_fec_stacks
+    ///
+    /// @brief Runs the block stacks of an object encoder or decoder on
+    ///        a pool of worker threads.
+    ///
+    /// Work is posted per block. The work posted for one block always
+    /// runs in the order it was posted and never on two threads at the
+    /// same time, so the stacks need no locking. Work for different
+    /// blocks runs in parallel.
+    ///
+    /// The stack of a block is built on the worker running the first
+    /// work posted for the block, one stack at a time since the stack
+    /// factory shared by the object coder is not thread-safe. Only the
+    /// blocks being worked on are therefore kept in memory, e.g. with
+    /// the streaming_file_decoder. A decoder is released once its
+    /// block is decoded. The streaming_file_encoder is not supported,
+    /// since its encoders share a small ring of block buffers and
+    /// must be used one block at a time in order.
+    ///
+    /// Every block has a home worker (the block index modulo the
+    /// number of workers) which keeps the stack of the block in its
+    /// caches. A worker without work of its own steals blocks from
+    /// the back of the other workers' queues.
+    ///
+    /// For decoders the completion of the blocks is tracked by the
+    /// is_complete_decoder layer of the object decoder, which may be
+    /// called from the workers concurrently.
+    ///
+    /// For an example of how it works see the test_parallel_object_coder
+    /// unit test.
+    ///
+    template<class ObjectCoder>
+    class parallel_object_coder : boost::noncopyable
+    {
+    public:
+
+        /// Pointer to the object encoder or decoder
+        using object_pointer = std::shared_ptr<ObjectCoder>;
+
+        /// Pointer to the stack of a block
+        using stack_pointer =
+            decltype(std::declval<ObjectCoder&>().build(0));
+
+        /// The work posted for a block, invoked with the block stack
+        using task_function = std::function<void (stack_pointer&)>;
+
+        /// The block encoders must not share buffers
+        static_assert(!has_streaming_file_source<ObjectCoder>::value,
+                      "The parallel object coder does not support the "
+                      "streaming file encoder");
+
+    public:
+
+        /// Starts the workers, the stacks are built when work is
+        /// posted for their blocks
+        /// @param object The object encoder or decoder
+        /// @param threads The number of worker threads
+        parallel_object_coder(object_pointer object, uint32_t threads)
+            : m_object(std::move(object)),
+              m_pending(0),
+              m_ready(0),
+              m_stop(false)
+        {
+            assert(m_object);
+            assert(threads > 0);
+
+            uint32_t blocks = m_object->blocks();
+
+            m_stacks.resize(blocks);
+
+            for (uint32_t i = 0; i < blocks; ++i)
+            {
+                m_blocks.emplace_back(new block_state());
+            }
+
+            for (uint32_t i = 0; i < threads; ++i)
+            {
+                m_queues.emplace_back(new worker_queue());
+            }
+
+            for (uint32_t i = 0; i < threads; ++i)
+            {
+                m_workers.emplace_back(&parallel_object_coder::worker,
+                                       this, i);
+            }
+        }
+
+        /// Waits for the posted work and joins the workers
+        ~parallel_object_coder()
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_idle.wait(lock, [this]() { return m_pending == 0; });
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+
+            m_wake.notify_all();
+
+            for (auto& worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+
+        /// @return The number of blocks in the object
+        uint32_t blocks() const
+        {
+            return (uint32_t) m_blocks.size();
+        }
+
+        /// @return The number of worker threads
+        uint32_t threads() const
+        {
+            // The queues are all created before the workers start
+            return (uint32_t) m_queues.size();
+        }
+
+        /// @return The object encoder or decoder
+        const object_pointer& object() const
+        {
+            return m_object;
+        }
+
+        /// Access to the stack of a block. The stack must only be
+        /// used while no work is pending, i.e. after wait().
+        /// @param index The index of the block
+        /// @return The stack of the block, empty if no work has been
+        ///         posted for the block or the decoder of the block was
+        ///         released when the block was decoded
+        stack_pointer& stack(uint32_t index)
+        {
+            assert(index < blocks());
+            return m_stacks[index];
+        }
+
+        /// Posts work for a block. The work runs on a worker thread
+        /// after all the work previously posted for the block. Work
+        /// for a block without a stack, i.e. a decoded block or a
+        /// block whose stack could not be built, is dropped.
+        /// @param index The index of the block
+        /// @param task The function invoked with the block stack
+        void post(uint32_t index, task_function task)
+        {
+            assert(index < blocks());
+
+            ++m_pending;
+
+            block_state& block = *m_blocks[index];
+            bool schedule = false;
+
+            {
+                std::lock_guard<std::mutex> lock(block.m_mutex);
+                block.m_tasks.push_back(std::move(task));
+
+                if (!block.m_scheduled)
+                {
+                    block.m_scheduled = true;
+                    schedule = true;
+                }
+            }
+
+            if (schedule)
+            {
+                enqueue(index, index % threads());
+            }
+        }
+
+        /// Posts a payload to the decoder of its block. The payload is
+        /// not copied, so it must stay valid and unchanged until the
+        /// work has run, i.e. until wait() returns. The decoder is
+        /// released once the block is decoded and payloads arriving
+        /// afterwards are dropped.
+        /// @param index The index of the block
+        /// @param payload The payload produced by the encoder of the
+        ///        block
+        void decode(uint32_t index, const uint8_t* payload)
+        {
+            assert(index < blocks());
+            assert(payload);
+
+            // Only captures a pointer, so the task is stored without
+            // a heap allocation
+            post(index, [payload](stack_pointer& decoder)
+            {
+                decoder->decode(payload);
+
+                if (decoder->is_complete())
+                {
+                    decoder.reset();
+                }
+            });
+        }
+
+        /// Blocks until all the posted work has run
+        ///
+        /// @throws The first exception thrown by the work or by
+        ///         building a stack since the last wait()
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idle.wait(lock, [this]() { return m_pending == 0; });
+
+            if (m_error)
+            {
+                std::exception_ptr error = m_error;
+                m_error = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+
+        /// @return true if all the blocks of the object are decoded
+        bool is_complete() const
+        {
+            return m_object->is_complete();
+        }
+
+        /// @param index The index of the block
+        /// @return true if the block is decoded
+        bool is_block_complete(uint32_t index) const
+        {
+            return m_object->is_block_complete(index);
+        }
+
+    private:
+
+        /// The work posted for a block not yet picked up by a worker
+        struct block_state
+        {
+            block_state() : m_scheduled(false), m_built(false)
+            { }
+
+            /// Protects the block state
+            std::mutex m_mutex;
+
+            /// The posted work in the order it was posted
+            std::vector<task_function> m_tasks;
+
+            /// True while the block is queued or being run, during
+            /// which the block is owned by one worker
+            bool m_scheduled;
+
+            /// The work being run, only used by the worker owning the
+            /// block. It is swapped with m_tasks so the capacity of
+            /// both is reused.
+            std::vector<task_function> m_running;
+
+            /// True once the stack of the block has been built, only
+            /// used by the worker owning the block
+            bool m_built;
+        };
+
+        /// The queue of blocks with work ready for a worker
+        struct worker_queue
+        {
+            /// Protects the queue
+            std::mutex m_mutex;
+
+            /// The indices of the blocks ready to run
+            std::deque<uint32_t> m_blocks;
+        };
+
+        /// Adds a block to the queue of a worker and wakes a worker
+        /// @param index The index of the block
+        /// @param worker The worker whose queue the block is added to
+        void enqueue(uint32_t index, uint32_t worker)
+        {
+            // Counted before it is queued, so a worker taking the
+            // block never sees the count drop below zero
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_ready;
+            }
+
+            {
+                worker_queue& queue = *m_queues[worker];
+                std::lock_guard<std::mutex> lock(queue.m_mutex);
+                queue.m_blocks.push_back(index);
+            }
+
+            m_wake.notify_one();
+        }
+
+        /// Takes a block from the front of the worker's own queue or,
+        /// if empty, from the back of another worker's queue
+        /// @param worker The worker looking for work
+        /// @param index Set to the index of the block taken
+        /// @return true if a block was taken
+        bool take(uint32_t worker, uint32_t& index)
+        {
+            uint32_t workers = threads();
+
+            for (uint32_t i = 0; i < workers; ++i)
+            {
+                worker_queue& queue = *m_queues[(worker + i) % workers];
+                std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+                if (queue.m_blocks.empty())
+                    continue;
+
+                if (i == 0)
+                {
+                    index = queue.m_blocks.front();
+                    queue.m_blocks.pop_front();
+                }
+                else
+                {
+                    index = queue.m_blocks.back();
+                    queue.m_blocks.pop_back();
+                }
+
+                return true;
+            }
+
+            return false;
+        }
+
+        /// Builds the stack of a block. A block whose stack cannot be
+        /// built is left without a stack and the error is reported by
+        /// wait().
+        /// @param index The index of the block
+        void build(uint32_t index)
+        {
+            try
+            {
+                std::lock_guard<std::mutex> lock(m_build_mutex);
+                m_stacks[index] = m_object->build(index);
+                assert(m_stacks[index]);
+            }
+            catch (...)
+            {
+                failed(std::current_exception());
+            }
+        }
+
+        /// Keeps the first error until it is reported by wait()
+        /// @param error The exception thrown
+        void failed(std::exception_ptr error)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_error)
+            {
+                m_error = error;
+            }
+        }
+
+        /// Runs the work posted for a block
+        /// @param worker The worker running the block
+        /// @param index The index of the block
+        void run(uint32_t worker, uint32_t index)
+        {
+            block_state& block = *m_blocks[index];
+
+            {
+                std::lock_guard<std::mutex> lock(block.m_mutex);
+                block.m_running.swap(block.m_tasks);
+            }
+
+            if (!block.m_built)
+            {
+                block.m_built = true;
+                build(index);
+            }
+
+            for (auto& task : block.m_running)
+            {
+                stack_pointer& stack = m_stacks[index];
+
+                if (stack)
+                {
+                    try
+                    {
+                        task(stack);
+                    }
+                    catch (...)
+                    {
+                        failed(std::current_exception());
+                    }
+                }
+
+                if (m_pending.fetch_sub(1) == 1)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_idle.notify_all();
+                }
+            }
+
+            block.m_running.clear();
+
+            bool again = false;
+
+            {
+                std::lock_guard<std::mutex> lock(block.m_mutex);
+
+                if (block.m_tasks.empty())
+                {
+                    block.m_scheduled = false;
+                }
+                else
+                {
+                    again = true;
+                }
+            }
+
+            // Work which arrived meanwhile stays with this worker
+            if (again)
+            {
+                enqueue(index, worker);
+            }
+        }
+
+        /// The loop run by each worker thread
+        /// @param worker The index of the worker
+        void worker(uint32_t worker)
+        {
+            while (true)
+            {
+                uint32_t index = 0;
+
+                if (take(worker, index))
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        assert(m_ready > 0);
+                        --m_ready;
+                    }
+
+                    run(worker, index);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this]() { return m_stop || m_ready > 0; });
+
+                if (m_stop && m_ready == 0)
+                    return;
+            }
+        }
+
+    private:
+
+        /// The object encoder or decoder
+        object_pointer m_object;
+
+        /// The stacks of the blocks, built on the workers
+        std::vector<stack_pointer> m_stacks;
+
+        /// Serializes the use of the stack factory of the object coder
+        std::mutex m_build_mutex;
+
+        /// The work posted per block
+        std::vector<std::unique_ptr<block_state>> m_blocks;
+
+        /// The queues of the workers
+        std::vector<std::unique_ptr<worker_queue>> m_queues;
+
+        /// The worker threads
+        std::vector<std::thread> m_workers;
+
+        /// The number of posted tasks which have not run yet
+        std::atomic<uint32_t> m_pending;
+
+        /// Protects m_ready, m_stop and m_error
+        std::mutex m_mutex;
+
+        /// The number of blocks in the worker queues
+        uint32_t m_ready;
+
+        /// Tells the workers to exit once the queues are empty
+        bool m_stop;
+
+        /// The first error since the last wait()
+        std::exception_ptr m_error;
+
+        /// Signals the workers that a block is ready
+        std::condition_variable m_wake;
+
+        /// Signals wait() that all the posted work has run
+        std::condition_variable m_idle;
+    };
+}
+}
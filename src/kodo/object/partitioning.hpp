@@ -105,7 +105,7 @@ namespace object
         }
 
         /// @copydoc block_partitioning::bytes_offset(uint32_t) const
-        uint32_t byte_offset(uint32_t index) const
+        uint64_t byte_offset(uint32_t index) const
         {
             return m_partitioning_scheme.byte_offset(index);
         }
@@ -0,0 +1,62 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "write_behind_file_sink.hpp"
+#include "object_filename.hpp"
+#include "is_complete_decoder.hpp"
+#include "stack_factory.hpp"
+#include "partitioning.hpp"
+
+#include "../rebind_factory.hpp"
+#include "../final_layer.hpp"
+#include "../wrap_restore_partial_symbol_decoder.hpp"
+#include "../wrap_is_complete_callback_decoder.hpp"
+#include "../has_mutable_shallow_symbol_storage.hpp"
+#include "../rfc5052_partitioning_scheme.hpp"
+
+namespace kodo
+{
+namespace object
+{
+    /// @ingroup object_fec_stacks
+    ///
+    /// @brief A file decoder which writes each block to the file
+    ///        once it is decoded instead of memory mapping the file
+    ///
+    /// Works like the file_decoder, but only the blocks being decoded
+    /// are kept in memory, see the write_behind_file_sink layer. A
+    /// decoder must not be used once its block is complete. Use it
+    /// for files larger than the available memory.
+    template
+    <
+        class Stack,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class streaming_file_decoder : public
+        write_behind_file_sink<
+        object_filename<
+        is_complete_decoder<
+        stack_factory<
+            wrap_is_complete_callback_decoder<
+            wrap_restore_partial_symbol_decoder<Stack>>,
+        partitioning<BlockPartitioning,
+        final_layer>>>>>
+    {
+    public:
+
+        /// We will use the same factory as the stack
+        using factory = rebind_factory<Stack, streaming_file_decoder>;
+
+        /// The decoders decode directly into the block buffers, so
+        /// the stack must use shallow storage
+        static_assert(
+            has_mutable_shallow_symbol_storage<Stack>::value,
+            "The streaming file decoder only works with decoders using"
+            "shallow storage");
+    };
+}
+}
@@ -0,0 +1,49 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "streaming_file_source.hpp"
+#include "object_filename.hpp"
+#include "stack_factory.hpp"
+#include "partitioning.hpp"
+
+#include "../rebind_factory.hpp"
+#include "../final_layer.hpp"
+#include "../rfc5052_partitioning_scheme.hpp"
+
+namespace kodo
+{
+namespace object
+{
+    /// @ingroup object_fec_stacks
+    ///
+    /// @brief A file encoder which reads the file block by block
+    ///        instead of memory mapping it
+    ///
+    /// Works like the file_encoder, but only a small ring of blocks
+    /// is kept in memory, see the streaming_file_source layer. The
+    /// encoders should therefore be built for one block at a time in
+    /// the order of the blocks. Use it for files larger than the
+    /// available memory.
+    template
+    <
+        class Stack,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class streaming_file_encoder : public
+        streaming_file_source<
+        object_filename<
+        stack_factory<Stack,
+        partitioning<BlockPartitioning,
+        final_layer>>>>
+    {
+    public:
+
+        /// We will use the same factory as the stack
+        using factory = rebind_factory<Stack, streaming_file_encoder>;
+    };
+}
+}
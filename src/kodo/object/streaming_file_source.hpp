@@ -0,0 +1,387 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sak/aligned_allocator.hpp>
+
+namespace kodo
+{
+namespace object
+{
+    /// @ingroup object_layers
+    ///
+    /// @brief Layer which reads a file block by block into a bounded
+    ///        ring of block buffers.
+    ///
+    /// Unlike the mapped_file_source the file is never mapped. When
+    /// the encoder for a block is built the block is read with pread()
+    /// into the buffer of the ring, and the following block is read
+    /// in the background while the block is encoded. The pages of the
+    /// file cache are dropped once a block has been read, so the
+    /// resident memory is bounded by the ring regardless of the file
+    /// size.
+    ///
+    /// The encoder of a block uses the ring buffer, so it must not be
+    /// used once the encoders for the next buffered_blocks() - 1
+    /// blocks have been built. With the default two buffers this
+    /// means that the blocks are encoded one at a time in order.
+    ///
+    /// The layer throws a std::system_error if the file cannot be
+    /// opened, and build() throws one if the block cannot be read.
+    /// This includes the file ending before the block, since the file
+    /// must not shrink while it is encoded.
+    template<class SuperCoder>
+    class streaming_file_source : public SuperCoder
+    {
+    public:
+
+        /// The stack used
+        using stack_type = typename SuperCoder::stack_type;
+
+        /// The storage type
+        using storage_type = typename stack_type::storage_type;
+
+    public:
+
+        /// @ingroup factory_base_layers
+        ///
+        /// @brief The factory layer allows a user to specify the
+        ///        number of block buffers.
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// The default number of block buffers
+            static const uint32_t default_buffered_blocks = 2;
+
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size),
+                  m_buffered_blocks(default_buffered_blocks),
+                  m_object_size(0)
+            { }
+
+            /// @param blocks The number of block buffers in the ring,
+            ///        with one buffer no blocks are read ahead
+            void set_buffered_blocks(uint32_t blocks)
+            {
+                assert(blocks > 0);
+                m_buffered_blocks = blocks;
+            }
+
+            /// @return The number of block buffers in the ring
+            uint32_t buffered_blocks() const
+            {
+                return m_buffered_blocks;
+            }
+
+            /// @param size The size of the file being encoded
+            void set_object_size(uint64_t size)
+            {
+                assert(size > 0);
+                m_object_size = size;
+            }
+
+            /// @return The size of the file being encoded
+            uint64_t object_size() const
+            {
+                assert(m_object_size > 0);
+                return m_object_size;
+            }
+
+        protected:
+
+            /// The number of block buffers in the ring
+            uint32_t m_buffered_blocks;
+
+            /// The size of the file being encoded
+            uint64_t m_object_size;
+        };
+
+    public:
+
+        /// Constructor
+        streaming_file_source()
+            : m_file(-1),
+              m_object_size(0)
+        { }
+
+        /// Destructor
+        ~streaming_file_source()
+        {
+            close_file();
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            // As in the mapped_file_source the file is opened before
+            // initializing the lower layers, since the partitioning
+            // needs the size of the file
+            close_file();
+
+            do
+            {
+                m_file = ::open(the_factory.file_name().c_str(), O_RDONLY);
+            }
+            while(m_file < 0 && errno == EINTR);
+
+            if(m_file < 0)
+            {
+                throw std::system_error(errno, std::generic_category(),
+                                        "open");
+            }
+
+            struct stat file_status;
+
+            if(::fstat(m_file, &file_status) != 0)
+            {
+                int error = errno;
+                close_file();
+
+                throw std::system_error(error, std::generic_category(),
+                                        "fstat");
+            }
+
+            the_factory.set_object_size(file_status.st_size);
+
+#ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(m_file, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+            SuperCoder::initialize(the_factory);
+
+            m_object_size = the_factory.object_size();
+
+            uint32_t max_block_size =
+                the_factory.max_symbols() * the_factory.max_symbol_size();
+
+            m_buffers.resize(the_factory.buffered_blocks());
+
+            for(auto& buffer : m_buffers)
+            {
+                buffer.resize(max_block_size);
+            }
+
+            m_buffer_block.assign(m_buffers.size(), uint32_t(no_block));
+        }
+
+        /// @copydoc layer::deinitialize(Factory&)
+        template<class Factory>
+        void deinitialize(Factory& the_factory)
+        {
+            SuperCoder::deinitialize(the_factory);
+            close_file();
+        }
+
+        /// @param index Index of the block to build an encoder for
+        ///
+        /// @return the newly built encoder initialized with the block
+        ///         buffer through the set_symbols function
+        auto build(uint32_t index) ->
+            decltype(std::declval<SuperCoder>().build(0))
+        {
+            auto stack = SuperCoder::build(index);
+            assert(stack);
+
+            uint32_t buffer = load_block(index);
+
+            storage_type data;
+            data.m_data = m_buffers[buffer].data();
+            data.m_size = block_bytes(index);
+
+            stack->set_symbols(data);
+
+            // Read the next block while this one is encoded
+            if(m_buffers.size() > 1 && index + 1 < SuperCoder::blocks())
+            {
+                prefetch_block(index + 1);
+            }
+
+            return stack;
+        }
+
+        /// @return The size in bytes of the object
+        uint64_t object_size() const
+        {
+            return m_object_size;
+        }
+
+        /// @return The number of block buffers in the ring
+        uint32_t buffered_blocks() const
+        {
+            return (uint32_t) m_buffers.size();
+        }
+
+    private:
+
+        /// @param index The index of a block
+        /// @return The number of bytes of the file in the block
+        uint32_t block_bytes(uint32_t index) const
+        {
+            uint64_t offset = SuperCoder::byte_offset(index);
+            assert(m_object_size > offset);
+
+            return (uint32_t) std::min<uint64_t>(
+                SuperCoder::block_size(index), m_object_size - offset);
+        }
+
+        /// Makes sure that a block is in its buffer
+        /// @param index The index of the block
+        /// @return The buffer holding the block
+        uint32_t load_block(uint32_t index)
+        {
+            wait_prefetch();
+
+            uint32_t buffer = index % m_buffers.size();
+
+            if(m_buffer_block[buffer] != index)
+            {
+                read_block(index, buffer);
+            }
+
+            return buffer;
+        }
+
+        /// Starts reading a block into its buffer in the background
+        /// @param index The index of the block
+        void prefetch_block(uint32_t index)
+        {
+            assert(!m_prefetch.valid());
+
+            uint32_t buffer = index % m_buffers.size();
+
+            if(m_buffer_block[buffer] == index)
+                return;
+
+            m_prefetch = std::async(std::launch::async,
+                [this, index, buffer] { read_block(index, buffer); });
+        }
+
+        /// Waits until the block being read in the background is read
+        void wait_prefetch()
+        {
+            if(!m_prefetch.valid())
+                return;
+
+            try
+            {
+                m_prefetch.get();
+            }
+            catch(const std::system_error&)
+            {
+                // The buffer holds no block after a failed read, so the
+                // block is read again and the error reported if its
+                // encoder is built
+            }
+        }
+
+        /// Reads a block into a buffer and drops the pages of the block
+        /// from the file cache
+        /// @param index The index of the block
+        /// @param buffer The buffer to read the block into
+        /// @throws std::system_error if the block could not be read
+        void read_block(uint32_t index, uint32_t buffer)
+        {
+            uint64_t offset = SuperCoder::byte_offset(index);
+            uint32_t size = block_bytes(index);
+
+            uint8_t* data = m_buffers[buffer].data();
+
+            // The buffer is overwritten, so it holds no block until
+            // the read completes
+            m_buffer_block[buffer] = no_block;
+
+            uint32_t bytes_read = 0;
+
+            while(bytes_read < size)
+            {
+                ssize_t result = ::pread(m_file, data + bytes_read,
+                                         size - bytes_read,
+                                         offset + bytes_read);
+
+                if(result < 0 && errno == EINTR)
+                    continue;
+
+                if(result < 0)
+                {
+                    throw std::system_error(errno, std::generic_category(),
+                                            "pread");
+                }
+
+                // The file must not shrink while it is encoded
+                if(result == 0)
+                {
+                    throw std::system_error(EIO, std::generic_category(),
+                                            "pread: unexpected end of file");
+                }
+
+                bytes_read += (uint32_t) result;
+            }
+
+#ifdef POSIX_FADV_DONTNEED
+            ::posix_fadvise(m_file, offset, size, POSIX_FADV_DONTNEED);
+#endif
+
+            m_buffer_block[buffer] = index;
+        }
+
+        /// Waits for the background read and closes the file
+        void close_file()
+        {
+            wait_prefetch();
+
+            if(m_file >= 0)
+            {
+                ::close(m_file);
+                m_file = -1;
+            }
+        }
+
+    private:
+
+        /// Marks a buffer which holds no block
+        static const uint32_t no_block =
+            std::numeric_limits<uint32_t>::max();
+
+        /// The storage type of a block buffer
+        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t> >
+            aligned_vector;
+
+        /// The file descriptor of the file being encoded
+        int m_file;
+
+        /// The size of the object in bytes
+        uint64_t m_object_size;
+
+        /// The ring of block buffers, block i is read into buffer
+        /// i % buffered_blocks()
+        std::vector<aligned_vector> m_buffers;
+
+        /// The block held by each buffer
+        std::vector<uint32_t> m_buffer_block;
+
+        /// The block being read in the background
+        std::future<void> m_prefetch;
+    };
+}
+}
@@ -0,0 +1,545 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sak/aligned_allocator.hpp>
+
+namespace kodo
+{
+namespace object
+{
+    /// @ingroup object_layers
+    ///
+    /// @brief Layer which decodes the blocks of a file into block
+    ///        buffers and writes each block to the file once it is
+    ///        decoded.
+    ///
+    /// Unlike the mapped_file_sink the file is never mapped. The file
+    /// is created with its final size and the space is preallocated.
+    /// When the decoder for a block is built it gets a block buffer,
+    /// and once the is_complete_decoder reports the block as complete
+    /// the buffer is handed to a writer thread. The writer thread
+    /// writes the block with pwrite(), starts the write back of the
+    /// block and drops its pages from the file cache before the
+    /// buffer is reused for another block. The memory used is
+    /// therefore bounded by the number of blocks being decoded
+    /// regardless of the file size.
+    ///
+    /// Since the buffer of a block is released once the block is
+    /// complete, the decoder of a block must not be used after it
+    /// has completed. Use flush() to wait until the completed blocks
+    /// have been written.
+    ///
+    /// Like the mapped_file_sink, the layer throws a std::system_error
+    /// if the file cannot be created. A block which the writer thread
+    /// fails to write is reported by the next call to flush() or
+    /// close(). Errors which have not been reported when the layer is
+    /// destroyed are lost, so call close() to know that the whole file
+    /// has been written.
+    ///
+    /// The layer must be placed above the is_complete_decoder layer.
+    template<class SuperCoder>
+    class write_behind_file_sink : public SuperCoder
+    {
+    public:
+
+        /// The stack used
+        using stack_type = typename SuperCoder::stack_type;
+
+        /// The storage type
+        using storage_type = typename stack_type::storage_type;
+
+    public:
+
+        /// @ingroup factory_base_layers
+        ///
+        /// @brief The factory layer allows a user to specify the
+        ///        size of the file being decoded.
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size),
+                  m_file_size(0)
+            { }
+
+            /// @param file_size Set the size in bytes of the file we
+            ///        want to decode
+            void set_file_size(uint64_t file_size)
+            {
+                assert(file_size > 0);
+                m_file_size = file_size;
+            }
+
+            /// @return The size in bytes of the file we want to decode
+            uint64_t file_size() const
+            {
+                assert(m_file_size > 0);
+                return m_file_size;
+            }
+
+            /// @return The size in bytes of the object, which is the
+            ///         size of the file
+            uint64_t object_size() const
+            {
+                return file_size();
+            }
+
+        protected:
+
+            /// The size in bytes of the file we want to decode
+            uint64_t m_file_size;
+        };
+
+    public:
+
+        /// Constructor
+        write_behind_file_sink()
+            : m_file(-1),
+              m_object_size(0),
+              m_max_block_size(0),
+              m_writing(false),
+              m_stop(false)
+        { }
+
+        /// Destructor, errors which have not been reported are
+        /// discarded
+        ~write_behind_file_sink()
+        {
+            close_file();
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            close_file();
+
+            m_object_size = the_factory.file_size();
+
+            do
+            {
+                m_file = ::open(the_factory.file_name().c_str(),
+                                O_WRONLY | O_CREAT, 0644);
+            }
+            while(m_file < 0 && errno == EINTR);
+
+            if(m_file < 0)
+            {
+                throw std::system_error(errno, std::generic_category(),
+                                        "open");
+            }
+
+            // Give the file its final size, this also removes any
+            // data beyond the end of the file if it already existed
+            int result;
+
+            do
+            {
+                result = ::ftruncate(m_file, m_object_size);
+            }
+            while(result != 0 && errno == EINTR);
+
+            if(result != 0)
+            {
+                close_and_throw(errno, "ftruncate");
+            }
+
+            // Reserve the space of the file so the writes of the
+            // blocks do not fail or fragment the file. Not all file
+            // systems support this, in which case the blocks are
+            // allocated as they are written. posix_fallocate()
+            // returns the error instead of setting errno.
+            do
+            {
+                result = ::posix_fallocate(m_file, 0, m_object_size);
+            }
+            while(result == EINTR);
+
+            if(result != 0 && result != EOPNOTSUPP && result != EINVAL)
+            {
+                close_and_throw(result, "posix_fallocate");
+            }
+
+            SuperCoder::initialize(the_factory);
+
+            m_max_block_size =
+                the_factory.max_symbols() * the_factory.max_symbol_size();
+
+            m_block_buffers.clear();
+            m_block_buffers.resize(SuperCoder::blocks());
+
+            SuperCoder::set_block_complete_callback(
+                std::bind(&write_behind_file_sink::block_complete,
+                          this, std::placeholders::_1));
+
+            m_stop = false;
+            m_writer = std::thread(&write_behind_file_sink::write_blocks,
+                                   this);
+        }
+
+        /// @copydoc layer::deinitialize(Factory&)
+        template<class Factory>
+        void deinitialize(Factory& the_factory)
+        {
+            close_file();
+            SuperCoder::deinitialize(the_factory);
+        }
+
+        /// @param index Index of the block to build a decoder for
+        ///
+        /// @return the newly built decoder initialized with a block
+        ///         buffer through the set_symbols function
+        auto build(uint32_t index) ->
+            decltype(std::declval<SuperCoder>().build(0))
+        {
+            auto stack = SuperCoder::build(index);
+            assert(stack);
+
+            storage_type data;
+            data.m_data = block_buffer(index);
+            data.m_size = block_bytes(index);
+
+            stack->set_symbols(data);
+
+            return stack;
+        }
+
+        /// Waits until the blocks completed so far have been written
+        /// to the file
+        ///
+        /// @throws std::system_error if the writer thread failed to
+        ///         write a block since the last flush()
+        void flush()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_written.wait(lock, [this]
+                { return m_queue.empty() && !m_writing; });
+
+            if(m_error)
+            {
+                std::exception_ptr error = m_error;
+                m_error = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+
+        /// Writes the completed blocks and closes the file. The
+        /// decoders must not be used afterwards.
+        ///
+        /// @throws std::system_error if the writer thread failed to
+        ///         write a block since the last flush(), or if the
+        ///         file could not be closed
+        void close()
+        {
+            std::exception_ptr error = close_file();
+
+            if(error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        /// @return The size in bytes of the object
+        uint64_t object_size() const
+        {
+            return m_object_size;
+        }
+
+        /// @return The number of block buffers allocated, i.e. the
+        ///         largest number of blocks decoded or written at
+        ///         the same time
+        uint32_t allocated_buffers() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            uint32_t buffers = (uint32_t) m_free_buffers.size() +
+                (uint32_t) m_queue.size() + (m_writing ? 1 : 0);
+
+            for(const auto& buffer : m_block_buffers)
+            {
+                if(buffer)
+                    ++buffers;
+            }
+
+            return buffers;
+        }
+
+    private:
+
+        /// The storage type of a block buffer
+        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t> >
+            aligned_vector;
+
+        /// Pointer owning a block buffer
+        typedef std::unique_ptr<aligned_vector> buffer_pointer;
+
+    private:
+
+        /// @param index The index of a block
+        /// @return The number of bytes of the file in the block
+        uint32_t block_bytes(uint32_t index) const
+        {
+            uint64_t offset = SuperCoder::byte_offset(index);
+            assert(m_object_size > offset);
+
+            return (uint32_t) std::min<uint64_t>(
+                SuperCoder::block_size(index), m_object_size - offset);
+        }
+
+        /// Returns the buffer of a block, a decoder built again for a
+        /// block which is not yet complete uses the same buffer
+        /// @param index The index of the block
+        /// @return The buffer of the block
+        uint8_t* block_buffer(uint32_t index)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            buffer_pointer& buffer = m_block_buffers[index];
+
+            if(buffer)
+                return buffer->data();
+
+            if(m_free_buffers.empty())
+            {
+                buffer.reset(new aligned_vector(m_max_block_size));
+            }
+            else
+            {
+                buffer = std::move(m_free_buffers.back());
+                m_free_buffers.pop_back();
+            }
+
+            return buffer->data();
+        }
+
+        /// Invoked by the is_complete_decoder when a block is complete,
+        /// hands the buffer of the block to the writer thread
+        /// @param index The index of the block
+        void block_complete(uint32_t index)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            assert(m_writer.joinable() && "The file has been closed");
+            assert(m_block_buffers[index]);
+
+            m_queue.emplace_back(index, std::move(m_block_buffers[index]));
+            m_wake.notify_one();
+        }
+
+        /// The writer thread, writes the completed blocks until
+        /// stopped
+        void write_blocks()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            while(true)
+            {
+                m_wake.wait(lock, [this]
+                    { return m_stop || !m_queue.empty(); });
+
+                if(m_queue.empty())
+                    break;
+
+                uint32_t index = m_queue.front().first;
+                buffer_pointer buffer = std::move(m_queue.front().second);
+                m_queue.pop_front();
+                m_writing = true;
+
+                lock.unlock();
+
+                std::exception_ptr error;
+
+                try
+                {
+                    write_block(index, buffer->data());
+                }
+                catch(...)
+                {
+                    error = std::current_exception();
+                }
+
+                lock.lock();
+
+                // Only the first error is kept until it is reported
+                if(error && !m_error)
+                {
+                    m_error = error;
+                }
+
+                m_free_buffers.push_back(std::move(buffer));
+                m_writing = false;
+                m_written.notify_all();
+            }
+        }
+
+        /// Writes a block to the file and drops its pages from the
+        /// file cache
+        /// @param index The index of the block
+        /// @param data The decoded data of the block
+        /// @throws std::system_error if the block could not be written
+        void write_block(uint32_t index, const uint8_t* data)
+        {
+            uint64_t offset = SuperCoder::byte_offset(index);
+            uint32_t size = block_bytes(index);
+
+            uint32_t bytes_written = 0;
+
+            // A write may be interrupted or write only part of the
+            // block, in which case the rest is written again
+            while(bytes_written < size)
+            {
+                ssize_t result = ::pwrite(m_file, data + bytes_written,
+                                          size - bytes_written,
+                                          offset + bytes_written);
+
+                if(result < 0 && errno == EINTR)
+                    continue;
+
+                if(result < 0)
+                {
+                    throw std::system_error(errno, std::generic_category(),
+                                            "pwrite");
+                }
+
+                // Nothing written without an error, e.g. since the
+                // device is full, retrying would not make progress
+                if(result == 0)
+                {
+                    throw std::system_error(ENOSPC, std::generic_category(),
+                                            "pwrite");
+                }
+
+                bytes_written += (uint32_t) result;
+            }
+
+            // Dirty pages cannot be dropped, so the write back of the
+            // block is started first where this is supported
+#ifdef SYNC_FILE_RANGE_WRITE
+            ::sync_file_range(m_file, offset, size, SYNC_FILE_RANGE_WRITE);
+#endif
+
+#ifdef POSIX_FADV_DONTNEED
+            ::posix_fadvise(m_file, offset, size, POSIX_FADV_DONTNEED);
+#endif
+        }
+
+        /// Writes the completed blocks, stops the writer thread and
+        /// closes the file
+        /// @return The first error which has not been reported, or
+        ///         nullptr if there is none
+        std::exception_ptr close_file()
+        {
+            if(m_writer.joinable())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stop = true;
+                }
+
+                m_wake.notify_one();
+                m_writer.join();
+            }
+
+            std::exception_ptr error = m_error;
+            m_error = nullptr;
+
+            if(m_file >= 0)
+            {
+                // The file is closed even if close() is interrupted,
+                // so it must not be called again
+                int result = ::close(m_file);
+                m_file = -1;
+
+                if(result != 0 && errno != EINTR && !error)
+                {
+                    error = std::make_exception_ptr(std::system_error(
+                        errno, std::generic_category(), "close"));
+                }
+            }
+
+            return error;
+        }
+
+        /// Closes the file and throws the error of a failed system
+        /// call
+        /// @param error The error number of the system call
+        /// @param what The name of the system call
+        void close_and_throw(int error, const char* what)
+        {
+            ::close(m_file);
+            m_file = -1;
+
+            throw std::system_error(error, std::generic_category(), what);
+        }
+
+    private:
+
+        /// The file descriptor of the file being decoded
+        int m_file;
+
+        /// The size of the object in bytes
+        uint64_t m_object_size;
+
+        /// The size of a block buffer
+        uint32_t m_max_block_size;
+
+        /// The buffer of each block being decoded, empty for the
+        /// blocks not built or already complete
+        std::vector<buffer_pointer> m_block_buffers;
+
+        /// The buffers not in use
+        std::vector<buffer_pointer> m_free_buffers;
+
+        /// The completed blocks waiting to be written
+        std::deque<std::pair<uint32_t, buffer_pointer> > m_queue;
+
+        /// True while the writer thread writes a block
+        bool m_writing;
+
+        /// True when the writer thread should stop once the queue
+        /// is empty
+        bool m_stop;
+
+        /// The first error of the writer thread which has not been
+        /// reported yet
+        std::exception_ptr m_error;
+
+        /// Protects the buffers, the queue and the writer state
+        mutable std::mutex m_mutex;
+
+        /// Wakes the writer thread
+        std::condition_variable m_wake;
+
+        /// Signals that the writer thread has written a block
+        std::condition_variable m_written;
+
+        /// The writer thread
+        std::thread m_writer;
+    };
+}
+}
@@ -88,6 +88,30 @@ namespace kodo
             Super::set_coefficient_value(coefficients, index, value);
         }
 
+        /// @copydoc coefficient_value_access::first_nonzero_coefficient(
+        ///             const value_type*, uint32_t, uint32_t) const
+        uint32_t first_nonzero_coefficient(const value_type* coefficients,
+                                           uint32_t begin,
+                                           uint32_t end) const
+        {
+            assert(end + m_offset <= SuperCoder::coefficients_elements());
+
+            return Super::first_nonzero_coefficient(
+                coefficients, begin + m_offset, end + m_offset) - m_offset;
+        }
+
+        /// @copydoc coefficient_value_access::last_nonzero_coefficient(
+        ///             const value_type*, uint32_t, uint32_t) const
+        uint32_t last_nonzero_coefficient(const value_type* coefficients,
+                                          uint32_t begin,
+                                          uint32_t end) const
+        {
+            assert(end + m_offset <= SuperCoder::coefficients_elements());
+
+            return Super::last_nonzero_coefficient(
+                coefficients, begin + m_offset, end + m_offset) - m_offset;
+        }
+
         /// Sets the coefficient offset which will be added when accessing
         /// coefficient values
         /// @param offset The offset to add
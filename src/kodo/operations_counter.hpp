@@ -23,7 +23,8 @@ namespace kodo
               m_add(0),
               m_multiply_subtract(0),
               m_subtract(0),
-              m_invert(0)
+              m_invert(0),
+              m_bytes_saved(0)
             { }
 
         /// Counter for dest[i] = dest[i] * constant
@@ -44,6 +45,11 @@ namespace kodo
         /// Counter for invert(value)
         uint32_t m_invert;
 
+        /// Counter for the symbol bytes a decoder did not have to
+        /// process, because the operations were dropped together with
+        /// a linearly dependent symbol
+        uint64_t m_bytes_saved;
+
     };
 
     /// Subtract two operations counters ala. a - b
@@ -74,6 +80,10 @@ namespace kodo
 
         assert(a.m_invert >= b.m_invert);
         res.m_invert = a.m_invert - b.m_invert;
+
+        assert(a.m_bytes_saved >= b.m_bytes_saved);
+        res.m_bytes_saved = a.m_bytes_saved - b.m_bytes_saved;
+
         return res;
     }
 
@@ -106,6 +116,9 @@ namespace kodo
         res.m_invert = a.m_invert + b.m_invert;
         assert(res.m_invert >= a.m_invert);
 
+        res.m_bytes_saved = a.m_bytes_saved + b.m_bytes_saved;
+        assert(res.m_bytes_saved >= a.m_bytes_saved);
+
         return res;
     }
 
@@ -139,6 +152,10 @@ namespace kodo
             return true;
         if(a.m_invert < b.m_invert)
             return false;
+        if(a.m_bytes_saved >= b.m_bytes_saved)
+            return true;
+        if(a.m_bytes_saved < b.m_bytes_saved)
+            return false;
 
         return false;
     }
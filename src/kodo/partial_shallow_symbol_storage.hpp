@@ -40,6 +40,8 @@ namespace kodo
     /// internal buffer to make sure this is copied to the user's
     /// buffer once decoding is complete you can use the
     /// restore_partial_symbol function.
+    ///
+    /// The internal symbol buffer is kept in the arena of the coder.
     template<class SuperCoder>
     class partial_shallow_symbol_storage : public SuperCoder
     {
@@ -50,6 +52,36 @@ namespace kodo
 
     public:
 
+        /// @ingroup factory_base_layers
+        /// @brief Adds the internal symbol buffer to the arena of a
+        ///        coder
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(
+                        SuperCoder::factory_base::max_symbol_size());
+            }
+        };
+
+    public:
+
+        /// Constructor
+        partial_shallow_symbol_storage()
+            : m_internal_symbol(0),
+              m_internal_symbol_size(0),
+              m_has_partial_symbol(false)
+        { }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
@@ -57,7 +89,8 @@ namespace kodo
             SuperCoder::construct(the_factory);
 
             assert(the_factory.max_symbol_size() > 0);
-            m_internal_symbol.reserve(the_factory.max_symbol_size());
+            m_internal_symbol =
+                SuperCoder::arena_allocate(the_factory.max_symbol_size());
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -66,7 +99,7 @@ namespace kodo
         {
             SuperCoder::initialize(the_factory);
 
-            m_internal_symbol.resize(the_factory.symbol_size());
+            m_internal_symbol_size = the_factory.symbol_size();
             m_has_partial_symbol = false;
         }
 
@@ -98,7 +131,8 @@ namespace kodo
 
             if(last_symbol.m_size < symbol_size)
             {
-                const auto& internal_symbol = sak::storage(m_internal_symbol);
+                const auto& internal_symbol =
+                    sak::storage(m_internal_symbol, m_internal_symbol_size);
 
                 /// @todo This copy step is not needed on decoders and
                 ///       could potentially be removed if we has a
@@ -131,7 +165,8 @@ namespace kodo
         /// restore_partial_symbol_decoder layers.
         void restore_partial_symbol() const
         {
-            auto internal_symbol = sak::storage(m_internal_symbol);
+            auto internal_symbol =
+                sak::storage(m_internal_symbol, m_internal_symbol_size);
 
             // Adjust the size of the internal symbol so that we only
             // copy the amount needed by the partial symbol
@@ -142,8 +177,12 @@ namespace kodo
 
     protected:
 
-        /// The internal symbol buffer
-        std::vector<uint8_t> m_internal_symbol;
+        /// The internal symbol buffer, max_symbol_size() bytes in the
+        /// arena
+        uint8_t* m_internal_symbol;
+
+        /// The size in bytes of the symbols of the current block
+        uint32_t m_internal_symbol_size;
 
         /// Keeps track of whether the "partial symbol" buffer is in use
         bool m_has_partial_symbol;
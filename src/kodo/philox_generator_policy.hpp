@@ -0,0 +1,232 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+namespace kodo
+{
+    /// @brief Random generator policy for the coefficient generators
+    ///        using the counter based Philox4x32-10 generator.
+    ///
+    /// The random stream of a seed is the sequence of 32-bit words
+    /// produced by encrypting the block counters 0, 1, 2, ... with
+    /// the seed as the key. Seeding therefore only sets the key and
+    /// resets the counter, and any word of the stream can be
+    /// computed directly with word(uint64_t). This makes the policy
+    /// well suited for the seed codes, where the decoder seeds the
+    /// generator for every received packet.
+    ///
+    /// The bytes are produced in little endian order, so a seed gives
+    /// the same coefficients on all platforms.
+    class philox_generator_policy
+    {
+    public:
+
+        /// The type of the seed
+        typedef uint32_t seed_type;
+
+    public:
+
+        /// Constructor
+        philox_generator_policy()
+        {
+            seed(0);
+        }
+
+        /// @param seed_value The seed of the random generator
+        void seed(seed_type seed_value)
+        {
+            m_key = seed_value;
+            m_position = 0;
+        }
+
+        /// @param index The index of a word in the random stream of
+        ///        the current seed
+        /// @return The word
+        uint32_t word(uint64_t index) const
+        {
+            uint32_t block[4];
+            generate_block(index / 4, block);
+
+            return block[index % 4];
+        }
+
+        /// Fills a buffer with uniform random bytes. The buffer is
+        /// filled from the next block of the stream.
+        /// @param data The buffer to fill
+        /// @param size The size of the buffer in bytes
+        void generate(uint8_t* data, uint32_t size)
+        {
+            assert(data != 0);
+
+            // Start at a block boundary
+            uint64_t counter = (m_position + 3) / 4;
+            uint32_t block[4];
+
+            for(uint32_t i = 0; i < size; i += 16, ++counter)
+            {
+                generate_block(counter, block);
+
+                uint32_t bytes = size - i < 16 ? size - i : 16;
+
+                for(uint32_t j = 0; j < bytes; ++j)
+                {
+                    data[i + j] = (uint8_t) (block[j / 4] >> (8 * (j % 4)));
+                }
+            }
+
+            m_position = counter * 4;
+        }
+
+        /// @param min The smallest value to generate
+        /// @param max The largest value to generate
+        /// @return A uniform random value in [min, max]
+        template<class ValueType>
+        ValueType generate_value(ValueType min, ValueType max)
+        {
+            static_assert(sizeof(ValueType) <= sizeof(uint32_t),
+                          "Only values up to 32 bit are supported");
+            assert(min <= max);
+
+            uint64_t range = uint64_t(max) - uint64_t(min) + 1;
+
+            if(range > std::numeric_limits<uint32_t>::max())
+            {
+                return (ValueType) (min + next_word());
+            }
+
+            // Lemire's multiply and shift method, the rejection makes
+            // the values unbiased for ranges which are not a power of
+            // two
+            uint64_t product = next_word() * range;
+            uint32_t low = (uint32_t) product;
+
+            if(low < range)
+            {
+                uint32_t threshold = (uint32_t) ((0x100000000ULL - range) %
+                                                 range);
+
+                while(low < threshold)
+                {
+                    product = next_word() * range;
+                    low = (uint32_t) product;
+                }
+            }
+
+            return (ValueType) (min + (product >> 32));
+        }
+
+        /// Fills a bit mask where each bit is set with a given
+        /// probability. The bits are stored least significant bit
+        /// first, i.e. in the layout of a fifi::binary vector.
+        /// @param mask The buffer of at least (count + 7) / 8 bytes
+        /// @param count The number of bits to generate
+        /// @param density The probability that a bit is set
+        void generate_mask(uint8_t* mask, uint32_t count, double density)
+        {
+            assert(mask != 0);
+            assert(density >= 0.0 && density <= 1.0);
+
+            uint32_t size = (count + 7) / 8;
+
+            if(density == 0.5)
+            {
+                // Every random bit is a mask bit
+                generate(mask, size);
+            }
+            else
+            {
+                // A bit is set if a random word is below the threshold
+                uint64_t threshold = (uint64_t) (density * 4294967296.0);
+
+                for(uint32_t i = 0; i < size; ++i)
+                {
+                    uint32_t bits = 0;
+
+                    for(uint32_t j = 0; j < 8; ++j)
+                    {
+                        bits |= uint32_t(next_word() < threshold) << j;
+                    }
+
+                    mask[i] = (uint8_t) bits;
+                }
+            }
+
+            // Clear the bits after the last one
+            if(count % 8 != 0)
+            {
+                mask[size - 1] &= (uint8_t) ((1U << (count % 8)) - 1);
+            }
+        }
+
+        /// Applies the ten rounds of the Philox4x32 bijection
+        /// @param block The counter which is replaced by the output
+        /// @param key0 The first word of the key
+        /// @param key1 The second word of the key
+        static void philox4x32(uint32_t block[4], uint32_t key0,
+                               uint32_t key1)
+        {
+            for(uint32_t round = 0; round < 10; ++round)
+            {
+                uint64_t product0 = uint64_t(0xD2511F53U) * block[0];
+                uint64_t product1 = uint64_t(0xCD9E8D57U) * block[2];
+
+                uint32_t x0 = uint32_t(product1 >> 32) ^ block[1] ^ key0;
+                uint32_t x1 = uint32_t(product1);
+                uint32_t x2 = uint32_t(product0 >> 32) ^ block[3] ^ key1;
+                uint32_t x3 = uint32_t(product0);
+
+                block[0] = x0;
+                block[1] = x1;
+                block[2] = x2;
+                block[3] = x3;
+
+                key0 += 0x9E3779B9U;
+                key1 += 0xBB67AE85U;
+            }
+        }
+
+    private:
+
+        /// @param counter The index of a block in the random stream
+        /// @param block The four words of the block
+        void generate_block(uint64_t counter, uint32_t block[4]) const
+        {
+            block[0] = (uint32_t) counter;
+            block[1] = (uint32_t) (counter >> 32);
+            block[2] = 0;
+            block[3] = 0;
+
+            philox4x32(block, m_key, 0);
+        }
+
+        /// @return The next word of the random stream
+        uint32_t next_word()
+        {
+            if(m_position % 4 == 0)
+            {
+                generate_block(m_position / 4, m_block);
+            }
+
+            return m_block[m_position++ % 4];
+        }
+
+    private:
+
+        /// The key, i.e. the seed
+        uint32_t m_key;
+
+        /// The index of the next word in the random stream
+        uint64_t m_position;
+
+        /// The block holding the word at m_position - 1
+        uint32_t m_block[4];
+
+    };
+}
@@ -0,0 +1,26 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "basic_uniform_generator.hpp"
+#include "philox_generator_policy.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup coefficient_generator_layers
+    /// @brief Generates an uniform random coefficient (from the chosen
+    /// Finite Field) for every symbol using the counter based Philox
+    /// generator, which can be seeded at no cost.
+    ///
+    /// The coefficients generated from a seed differ from the ones of
+    /// the uniform_generator, so the encoder and decoder of a seed code
+    /// must both use this generator.
+    template<class SuperCoder>
+    class philox_uniform_generator : public
+        basic_uniform_generator<philox_generator_policy, SuperCoder>
+    { };
+}
@@ -5,10 +5,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <boost/dynamic_bitset.hpp>
 
 #include <sak/ceil_division.hpp>
 
@@ -20,6 +21,11 @@ namespace kodo
     /// @brief The pivot status bitset provides a building block for
     ///        layers that wish to use a bitset to keep track of
     ///        (partially) decoded symbols.
+    ///
+    /// The bitset is kept in the arena of the coder. Bit i is bit
+    /// i % 8 of byte i / 8, which is also the format of the pivot
+    /// status written and read by the pivot_status_writer and the
+    /// pivot_status_reader.
     template<class SuperCoder>
     class pivot_status_bitset : public SuperCoder
     {
@@ -48,17 +54,36 @@ namespace kodo
                 return sak::ceil_division(
                     SuperCoder::factory_base::max_symbols(), 8);
             }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(
+                        max_pivot_status_size());
+            }
         };
 
     public:
 
+        /// Constructor
+        pivot_status_bitset()
+            : m_pivot_status(0),
+              m_pivot_status_symbols(0)
+        { }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory& the_factory)
         {
             SuperCoder::construct(the_factory);
 
-            m_pivot_status.resize(the_factory.max_symbols(), false);
+            static_assert(sizeof(status_block_type) == 1,
+                          "We assume that the block type is 1 byte in the "
+                          "calculation here");
+
+            m_pivot_status = SuperCoder::arena_allocate(
+                the_factory.max_pivot_status_size());
 
             assert(pivot_status_size() <= the_factory.max_pivot_status_size());
         }
@@ -69,8 +94,8 @@ namespace kodo
         {
             SuperCoder::initialize(the_factory);
 
-            m_pivot_status.resize(the_factory.symbols());
-            m_pivot_status.reset();
+            m_pivot_status_symbols = the_factory.symbols();
+            std::fill_n(m_pivot_status, pivot_status_size(), 0);
 
             assert(pivot_status_size() <= the_factory.max_pivot_status_size());
         }
@@ -78,20 +103,44 @@ namespace kodo
         /// @return The size in bytes of decoder status vector
         uint32_t pivot_status_size() const
         {
-            static_assert(sizeof(status_block_type) == 1,
-                          "We assume that the block type is 1 byte in the "
-                          "calculation here");
+            return sak::ceil_division(m_pivot_status_symbols, 8);
+        }
 
-            assert(std::numeric_limits<uint32_t>::max() >=
-                   m_pivot_status.num_blocks());
+    protected:
 
-            return (uint32_t) m_pivot_status.num_blocks();
+        /// @param index The index of a symbol
+        /// @return true if the bit of the symbol is set
+        bool test_pivot_status(uint32_t index) const
+        {
+            assert(index < m_pivot_status_symbols);
+            return (m_pivot_status[index / 8] >> (index % 8)) & 1;
+        }
+
+        /// Sets the bit of a symbol
+        /// @param index The index of a symbol
+        void set_pivot_status(uint32_t index)
+        {
+            assert(index < m_pivot_status_symbols);
+            m_pivot_status[index / 8] |= status_block_type(1 << (index % 8));
+        }
+
+        /// Clears the bit of a symbol
+        /// @param index The index of a symbol
+        void reset_pivot_status(uint32_t index)
+        {
+            assert(index < m_pivot_status_symbols);
+            m_pivot_status[index / 8] &=
+                status_block_type(~(1 << (index % 8)));
         }
 
     protected:
 
-        /// Tracks the symbols which have been marked as pivot
-        boost::dynamic_bitset<status_block_type> m_pivot_status;
+        /// Tracks the symbols which have been marked as pivot,
+        /// pivot_status_size() bytes in the arena
+        status_block_type* m_pivot_status;
+
+        /// The number of symbols tracked in the bitset
+        uint32_t m_pivot_status_symbols;
 
     };
 
@@ -5,9 +5,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <limits>
 
 #include "pivot_status_bitset.hpp"
 
@@ -33,6 +35,7 @@ namespace kodo
 
         /// Access the bitset
         using Super::m_pivot_status;
+        using Super::m_pivot_status_symbols;
 
     public:
 
@@ -56,10 +59,22 @@ namespace kodo
         {
             assert(buffer);
 
-            const uint8_t* last = buffer + Super::pivot_status_size();
-            boost::from_block_range(buffer, last, m_pivot_status);
+            uint32_t size = Super::pivot_status_size();
+            assert(size > 0);
+
+            std::copy_n(buffer, size, m_pivot_status);
+
+            // Bits beyond the last symbol are ignored
+            uint32_t unused = size * 8 - m_pivot_status_symbols;
+            m_pivot_status[size - 1] &= uint8_t(0xff >> unused);
+
+            uint32_t count = 0;
+
+            for(uint32_t i = 0; i < size; ++i)
+            {
+                count += count_bits(m_pivot_status[i]);
+            }
 
-            auto count = m_pivot_status.count();
             assert(count <= std::numeric_limits<rank_type>::max());
 
             m_remote_rank = (rank_type) count;
@@ -74,8 +89,24 @@ namespace kodo
         /// @copydoc layer::remote_is_symbol_pivot(uint32_t) const
         bool remote_is_symbol_pivot(uint32_t index) const
         {
-            assert(index < m_pivot_status.size());
-            return m_pivot_status.test(index);
+            assert(index < m_pivot_status_symbols);
+            return Super::test_pivot_status(index);
+        }
+
+    private:
+
+        /// @param byte A byte of the bitset
+        /// @return The number of bits set in the byte
+        static uint32_t count_bits(uint8_t byte)
+        {
+            uint32_t count = 0;
+
+            for(; byte != 0; byte &= uint8_t(byte - 1))
+            {
+                ++count;
+            }
+
+            return count;
         }
 
     protected:
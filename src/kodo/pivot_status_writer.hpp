@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -30,31 +31,32 @@ namespace kodo
 
         /// Access the bitset
         using Super::m_pivot_status;
+        using Super::m_pivot_status_symbols;
 
     public:
 
         /// @copydoc layer::set_symbol_missing(uint32_t)
         void set_symbol_missing(uint32_t index)
         {
-            assert(index < m_pivot_status.size());
+            assert(index < m_pivot_status_symbols);
             Super::set_symbol_missing(index);
-            m_pivot_status.reset(index);
+            Super::reset_pivot_status(index);
         }
 
         /// @copydoc layer::set_symbol_seen(uint32_t)
         void set_symbol_seen(uint32_t index)
         {
-            assert(index < m_pivot_status.size());
+            assert(index < m_pivot_status_symbols);
             Super::set_symbol_seen(index);
-            m_pivot_status.set(index);
+            Super::set_pivot_status(index);
         }
 
         /// @copydoc layer::set_symbol_uncoded(uint32_t)
         void set_symbol_uncoded(uint32_t index)
         {
-            assert(index < m_pivot_status.size());
+            assert(index < m_pivot_status_symbols);
             Super::set_symbol_uncoded(index);
-            m_pivot_status.set(index);
+            Super::set_pivot_status(index);
         }
 
         /// Writes the pivot status to the provided buffer. The pivot status
@@ -69,7 +71,7 @@ namespace kodo
         void write_pivot_status(uint8_t *buffer) const
         {
             assert(buffer);
-            boost::to_block_range(m_pivot_status, buffer);
+            std::copy_n(m_pivot_status, Super::pivot_status_size(), buffer);
         }
 
     };
@@ -5,8 +5,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -16,6 +22,7 @@
 #include "construct.hpp"
 #include "initialize.hpp"
 #include "deinitialize.hpp"
+#include "has_set_size_class.hpp"
 
 namespace kodo
 {
@@ -27,6 +34,14 @@ namespace kodo
     ///         thread-safe and therefore should not be used in
     ///         multi-threaded environments.
     ///
+    /// If the factory supports layer::factory_base::set_size_class()
+    /// the codecs are pooled by size class. The size class of a build
+    /// is the number of symbols and the symbol size of the factory
+    /// rounded up to a power of two, limited by the maximum values.
+    /// A codec is constructed with buffers for its size class only,
+    /// so building a small generation from a factory sized for the
+    /// worst case does not allocate memory for the worst case.
+    ///
     /// For further descriptions of the factory pattern use in Kodo
     /// can be found in basic_factory.hpp
     template<class Codec>
@@ -37,20 +52,50 @@ namespace kodo
         /// Pointer type to the constructed coder
         using pointer = typename sak::resource_pool<Codec>::value_ptr;
 
+        /// The number of symbols and the symbol size of a size class
+        using size_class_type = std::pair<uint32_t, uint32_t>;
+
+        /// The occupancy of the pool of a size class
+        struct size_class_occupancy
+        {
+            /// The number of symbols of the size class
+            uint32_t m_symbols;
+
+            /// The symbol size of the size class
+            uint32_t m_symbol_size;
+
+            /// The number of codecs constructed for the size class
+            uint32_t m_total_resources;
+
+            /// The number of codecs of the size class not in use
+            uint32_t m_unused_resources;
+        };
+
     public:
 
         /// @copydoc layer::factory_base::factory(uint32_t,uint32_t)
         pool_factory(uint32_t max_symbols, uint32_t max_symbol_size) :
             Codec::factory_base(max_symbols, max_symbol_size),
-            m_pool(std::bind(&pool_factory::make_codec, this),
-                   std::bind(&pool_factory::recycle_codec,
-                                 std::placeholders::_1, this))
-        { }
+            m_max_size_class(max_symbols, max_symbol_size)
+        {
+            add_pool(m_max_size_class);
+        }
 
         /// @copydoc factory::build()
         pointer build()
         {
-            auto codec = m_pool.allocate();
+            size_class_type size_class = build_size_class(
+                std::integral_constant<bool, has_set_size_class<
+                    typename Codec::factory_base>::value>());
+
+            auto it = m_pools.find(size_class);
+
+            if (it == m_pools.end())
+            {
+                it = add_pool(size_class);
+            }
+
+            auto codec = it->second.allocate();
 
             if (kodo::has_initialize<Codec>::value)
             {
@@ -60,16 +105,38 @@ namespace kodo
             return codec;
         }
 
-        /// @return A reference to the internal resource pool
+        /// @return A reference to the resource pool of the codecs
+        ///         constructed for the maximum values
         const sak::resource_pool<Codec>& pool() const
         {
-            return m_pool;
+            return m_pools.find(m_max_size_class)->second;
         }
 
-        /// @return A reference to the internal resource pool
+        /// @return A reference to the resource pool of the codecs
+        ///         constructed for the maximum values
         sak::resource_pool<Codec>& pool()
         {
-            return m_pool;
+            return m_pools.find(m_max_size_class)->second;
+        }
+
+        /// @return The occupancy of the pool of each size class used
+        ///         so far, ordered by size class
+        std::vector<size_class_occupancy> occupancy() const
+        {
+            std::vector<size_class_occupancy> result;
+
+            for (const auto& pool : m_pools)
+            {
+                size_class_occupancy occupancy;
+                occupancy.m_symbols = pool.first.first;
+                occupancy.m_symbol_size = pool.first.second;
+                occupancy.m_total_resources = pool.second.total_resources();
+                occupancy.m_unused_resources = pool.second.unused_resources();
+
+                result.push_back(occupancy);
+            }
+
+            return result;
         }
 
     public:
@@ -88,10 +155,81 @@ namespace kodo
 
     private:
 
+        /// Adds the resource pool of a size class
+        /// @param size_class The size class
+        /// @return Iterator to the added pool
+        typename std::map<size_class_type, sak::resource_pool<Codec>>::iterator
+        add_pool(const size_class_type& size_class)
+        {
+            auto result = m_pools.emplace(std::piecewise_construct,
+                std::forward_as_tuple(size_class),
+                std::forward_as_tuple(
+                    std::bind(&pool_factory::make_codec, this, size_class),
+                    std::bind(&pool_factory::recycle_codec,
+                              std::placeholders::_1, this)));
+
+            assert(result.second);
+            return result.first;
+        }
+
+        /// @return The size class fitting the number of symbols and
+        ///         the symbol size of the factory
+        size_class_type build_size_class(std::true_type) const
+        {
+            return size_class_type(
+                round_up(Codec::factory_base::symbols(),
+                         m_max_size_class.first),
+                round_up(Codec::factory_base::symbol_size(),
+                         m_max_size_class.second));
+        }
+
+        /// @return The size class of the maximum values, used when the
+        ///         factory does not support size classes
+        size_class_type build_size_class(std::false_type) const
+        {
+            return m_max_size_class;
+        }
+
+        /// @param value The value to round up
+        /// @param max The largest value allowed
+        /// @return The value rounded up to a power of two, limited by
+        ///         the largest value allowed
+        static uint32_t round_up(uint32_t value, uint32_t max)
+        {
+            assert(value > 0);
+            assert(value <= max);
+
+            uint32_t rounded = 1;
+
+            while (rounded < value && rounded < max)
+            {
+                rounded <<= 1;
+            }
+
+            return std::min(rounded, max);
+        }
+
+        /// Lets the factory report the size class as the maximum
+        /// values while a codec is constructed
+        /// @param size_class The size class
+        void use_size_class(const size_class_type& size_class,
+                            std::true_type)
+        {
+            Codec::factory_base::set_size_class(
+                size_class.first, size_class.second);
+        }
+
+        /// Does nothing when the factory does not support size
+        /// classes, in which case only the maximum size class is used
+        void use_size_class(const size_class_type&, std::false_type)
+        { }
+
         /// Factory function used by the resource pool to
         /// build new codecs if needed.
         /// @param factory Pointer to the factory object
-        static pointer make_codec(pool_factory *factory)
+        /// @param size_class The size class to construct the codec for
+        static pointer make_codec(pool_factory *factory,
+                                  size_class_type size_class)
         {
             assert(factory);
 
@@ -99,7 +237,12 @@ namespace kodo
 
             if (kodo::has_construct<Codec>::value)
             {
+                std::integral_constant<bool, has_set_size_class<
+                    typename Codec::factory_base>::value> supported;
+
+                factory->use_size_class(size_class, supported);
                 kodo::construct(*codec, *factory);
+                factory->use_size_class(factory->m_max_size_class, supported);
             }
 
             return codec;
@@ -117,7 +260,10 @@ namespace kodo
 
     private:
 
-        /// Resource pool for the codecs
-        sak::resource_pool<Codec> m_pool;
+        /// The size class of the maximum values
+        size_class_type m_max_size_class;
+
+        /// Resource pool for the codecs of each size class
+        std::map<size_class_type, sak::resource_pool<Codec>> m_pools;
     };
 }
@@ -46,6 +46,9 @@ namespace kodo
         /// @copydoc layer::value_type
         typedef typename MainStack::value_type value_type;
 
+        /// @copydoc layer::allocator_type
+        typedef typename MainStack::allocator_type allocator_type;
+
         /// The type of the main stack
         typedef MainStack main_stack_type;
 
@@ -59,6 +62,11 @@ namespace kodo
         /// Forwarding factory_base for the parallel proxy stack
         class factory_base : public SuperCoder::factory_base
         {
+        public:
+
+            /// The proxy stack uses the allocator of the main stack
+            typedef typename MainStack::allocator_type allocator_type;
+
         public:
 
             /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
@@ -435,6 +443,42 @@ namespace kodo
             m_main_stack->subtract(symbol_dest, symbol_src, symbol_length);
         }
 
+        /// @copydoc layer::multiply_add_n(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_add_n(
+            value_type *symbol_dest, const value_type * const *symbol_src,
+            const value_type *coefficients, uint32_t count,
+            uint32_t symbol_length)
+        {
+            assert(m_main_stack);
+            m_main_stack->multiply_add_n(symbol_dest, symbol_src,
+                                         coefficients, count, symbol_length);
+        }
+
+        /// @copydoc layer::multiply_subtract_n(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_subtract_n(
+            value_type *symbol_dest, const value_type * const *symbol_src,
+            const value_type *coefficients, uint32_t count,
+            uint32_t symbol_length)
+        {
+            assert(m_main_stack);
+            m_main_stack->multiply_subtract_n(symbol_dest, symbol_src,
+                                              coefficients, count,
+                                              symbol_length);
+        }
+
+        /// @copydoc layer::run_symbol_ranges(uint32_t, const Function&)
+        template<class Function>
+        void run_symbol_ranges(uint32_t symbol_length,
+                               const Function& function)
+        {
+            assert(m_main_stack);
+            m_main_stack->run_symbol_ranges(symbol_length, function);
+        }
+
         /// @copydoc layer::invert(value_type)
         value_type invert(value_type value)
         {
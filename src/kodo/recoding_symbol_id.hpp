@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 
 #include <boost/random/mersenne_twister.hpp>
@@ -18,6 +19,9 @@ namespace kodo
     /// @ingroup symbol_id_layers
     /// @brief Randomly recombines existing coding coefficients to
     ///        allow a decoder to produce recoded packets.
+    ///
+    /// The buffers for the recoding coefficients and the recoded id
+    /// are allocated in the arena of the coder.
     template<class SuperCoder>
     class recoding_symbol_id : public SuperCoder
     {
@@ -48,18 +52,36 @@ namespace kodo
                 return SuperCoder::factory_base::max_coefficient_vector_size();
             }
 
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                return SuperCoder::factory_base::arena_size() +
+                    2 * SuperCoder::factory_base::arena_region_size(
+                        max_id_size());
+            }
+
         };
 
     public:
 
+        /// Constructor
+        recoding_symbol_id()
+            : m_id_size(0),
+              m_coefficients(0),
+              m_recode_id(0)
+        { }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory& the_factory)
         {
             SuperCoder::construct(the_factory);
 
-            m_coefficients.resize(the_factory.max_coefficient_vector_size());
-            m_recode_id.resize(the_factory.max_coefficient_vector_size());
+            m_coefficients = SuperCoder::arena_allocate(
+                the_factory.max_coefficient_vector_size());
+
+            m_recode_id = SuperCoder::arena_allocate(
+                the_factory.max_coefficient_vector_size());
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -84,7 +106,7 @@ namespace kodo
             assert(coefficients != 0);
 
             // Zero the symbol id
-            std::fill_n(m_recode_id.begin(), m_id_size, 0);
+            std::fill_n(m_recode_id, m_id_size, 0);
 
             // Prepare the symbol id storage
             sak::mutable_storage id_storage =
@@ -99,25 +121,25 @@ namespace kodo
                 // symbol coefficients and id
                 *coefficients = symbol_id;
                 sak::copy_storage(
-                    id_storage, sak::storage(&m_recode_id[0], m_id_size));
+                    id_storage, sak::storage(m_recode_id, m_id_size));
 
                 return m_id_size;
             }
             else if(symbol_count < SuperCoder::symbols())
             {
-                SuperCoder::generate_partial(&m_coefficients[0]);
+                SuperCoder::generate_partial(m_coefficients);
             }
             else
             {
-                SuperCoder::generate(&m_coefficients[0]);
+                SuperCoder::generate(m_coefficients);
             }
 
             // Create the recoded symbol id
             value_type *recode_id
-                = reinterpret_cast<value_type*>(&m_recode_id[0]);
+                = reinterpret_cast<value_type*>(m_recode_id);
 
             value_type *recode_coefficients
-                = reinterpret_cast<value_type*>(&m_coefficients[0]);
+                = reinterpret_cast<value_type*>(m_coefficients);
 
             for(uint32_t i = 0; i < SuperCoder::symbols(); ++i)
             {
@@ -148,9 +170,9 @@ namespace kodo
             }
 
 
-            *coefficients = &m_coefficients[0];
+            *coefficients = m_coefficients;
             sak::copy_storage(
-                id_storage, sak::storage(&m_recode_id[0], m_id_size));
+                id_storage, sak::storage(m_recode_id, m_id_size));
 
             return m_id_size;
         }
@@ -168,17 +190,14 @@ namespace kodo
         /// coding coefficients
         uint32_t m_id_size;
 
-        /// The storage type - we use aligned storage for both buffers
-        /// since if the coefficients are multibyte data types was have
-        /// to ensure the de-referencing the pointers are safe.
-        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t> >
-        aligned_vector;
-
-        /// Buffer for the recoding coefficients
-        aligned_vector m_coefficients;
+        /// Buffer for the recoding coefficients. The buffers in the
+        /// arena are aligned to a cache line, so de-referencing the
+        /// pointers is safe if the coefficients are multibyte data
+        /// types.
+        uint8_t* m_coefficients;
 
         /// Buffer for the recoded id
-        aligned_vector m_recode_id;
+        uint8_t* m_recode_id;
     };
 
 }
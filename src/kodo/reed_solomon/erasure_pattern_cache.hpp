@@ -0,0 +1,150 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace kodo
+{
+    /// @brief Least recently used cache of the decoding matrices
+    ///        built by the erasure_pattern_decoder.
+    ///
+    /// An erasure pattern is identified by the number of symbols, the
+    /// indices of the missing symbols and the generator matrix rows
+    /// of the repair symbols used to recover them. The cache is
+    /// shared by the decoders built from one factory and, like the
+    /// factory, is not thread-safe.
+    class erasure_pattern_cache
+    {
+    public:
+
+        /// The key identifying an erasure pattern
+        typedef std::vector<uint32_t> key_type;
+
+        /// The cached decoding matrix
+        typedef std::vector<uint8_t> matrix_type;
+
+        /// Pointer to a cached decoding matrix
+        typedef std::shared_ptr<const matrix_type> matrix_pointer;
+
+    public:
+
+        /// @param capacity The maximum number of cached patterns
+        erasure_pattern_cache(uint32_t capacity)
+            : m_capacity(capacity),
+              m_hits(0),
+              m_misses(0)
+        { }
+
+        /// Looks up a pattern and marks it as the most recently used
+        /// @param key The erasure pattern
+        /// @return The decoding matrix or an empty pointer if the
+        ///         pattern is not cached
+        matrix_pointer find(const key_type& key)
+        {
+            auto it = m_index.find(key);
+
+            if(it == m_index.end())
+            {
+                ++m_misses;
+                return matrix_pointer();
+            }
+
+            ++m_hits;
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+            return it->second->second;
+        }
+
+        /// Adds a pattern, evicting the least recently used pattern if
+        /// the cache is full
+        /// @param key The erasure pattern, which must not be cached
+        /// @param matrix The decoding matrix of the pattern
+        void insert(const key_type& key, const matrix_pointer& matrix)
+        {
+            assert(matrix);
+            assert(m_index.find(key) == m_index.end());
+
+            if(m_capacity == 0)
+                return;
+
+            m_entries.emplace_front(key, matrix);
+            m_index[key] = m_entries.begin();
+
+            shrink();
+        }
+
+        /// @return The maximum number of cached patterns
+        uint32_t capacity() const
+        {
+            return m_capacity;
+        }
+
+        /// @param capacity The maximum number of cached patterns,
+        ///        zero disables the cache
+        void set_capacity(uint32_t capacity)
+        {
+            m_capacity = capacity;
+            shrink();
+        }
+
+        /// @return The number of cached patterns
+        uint32_t size() const
+        {
+            return (uint32_t) m_entries.size();
+        }
+
+        /// @return The number of lookups which found the pattern
+        uint32_t hits() const
+        {
+            return m_hits;
+        }
+
+        /// @return The number of lookups which did not find the pattern
+        uint32_t misses() const
+        {
+            return m_misses;
+        }
+
+    private:
+
+        /// Evicts the least recently used patterns above the capacity
+        void shrink()
+        {
+            while(m_entries.size() > m_capacity)
+            {
+                m_index.erase(m_entries.back().first);
+                m_entries.pop_back();
+            }
+        }
+
+    private:
+
+        /// A cached pattern
+        typedef std::pair<key_type, matrix_pointer> entry_type;
+
+        /// The maximum number of cached patterns
+        uint32_t m_capacity;
+
+        /// The cached patterns, most recently used first
+        std::list<entry_type> m_entries;
+
+        /// Finds the cached patterns by key
+        std::map<key_type, std::list<entry_type>::iterator> m_index;
+
+        /// The number of lookups which found the pattern
+        uint32_t m_hits;
+
+        /// The number of lookups which did not find the pattern
+        uint32_t m_misses;
+    };
+}
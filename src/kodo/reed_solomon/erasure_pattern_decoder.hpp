@@ -0,0 +1,470 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <fifi/fifi_utils.hpp>
+#include <sak/convert_endian.hpp>
+#include <sak/storage.hpp>
+
+#include "erasure_pattern_cache.hpp"
+
+namespace kodo
+{
+    /// @ingroup codec_header_layers
+    ///
+    /// @brief Decodes a systematic Reed-Solomon code by inverting only
+    ///        the part of the generator matrix covering the erased
+    ///        symbols.
+    ///
+    /// Systematic symbols are stored directly. Repair symbols are
+    /// buffered until together with the systematic symbols k symbols
+    /// have been received. The decoder then inverts the sub-matrix of
+    /// the repair rows restricted to the missing columns, and
+    /// rebuilds every missing symbol with a single pass over the k
+    /// received symbols.
+    ///
+    /// The resulting decoding matrix only depends on the erasure
+    /// pattern, i.e. the missing symbols and the repair rows used, so
+    /// it is kept in an erasure_pattern_cache shared by all decoders
+    /// built from the same factory. A repeated loss pattern then
+    /// skips the inversion altogether.
+    ///
+    /// The layer replaces the symbol_id_decoder and the linear block
+    /// decoder in the Reed-Solomon decoder, and reads the row index
+    /// of the repair symbols from the symbol id.
+    template<class SuperCoder>
+    class erasure_pattern_decoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// @copydoc layer::rank_type
+        typedef typename SuperCoder::rank_type rank_type;
+
+        /// The default number of erasure patterns kept in the cache
+        static const uint32_t default_cache_capacity = 32;
+
+    public:
+
+        /// @ingroup factory_base_layers
+        /// The factory_base layer associated with this coder. Owns the
+        /// cache of decoding matrices shared by the decoders.
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size),
+                  m_cache(std::make_shared<erasure_pattern_cache>(
+                              uint32_t(default_cache_capacity)))
+            { }
+
+            /// @copydoc layer::factory_base::max_header_size() const
+            uint32_t max_header_size() const
+            {
+                return SuperCoder::factory_base::max_id_size();
+            }
+
+            /// @return The maximum number of erasure patterns cached
+            uint32_t cache_capacity() const
+            {
+                return m_cache->capacity();
+            }
+
+            /// @param capacity The maximum number of erasure patterns
+            ///        cached, zero disables the cache
+            void set_cache_capacity(uint32_t capacity)
+            {
+                m_cache->set_capacity(capacity);
+            }
+
+            /// @return The cache of decoding matrices
+            const std::shared_ptr<erasure_pattern_cache>& pattern_cache()
+            {
+                return m_cache;
+            }
+
+        private:
+
+            /// The cache of decoding matrices
+            std::shared_ptr<erasure_pattern_cache> m_cache;
+        };
+
+    public:
+
+        /// Constructor
+        erasure_pattern_decoder()
+            : m_repair_count(0)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_cache = the_factory.pattern_cache();
+            assert(m_cache);
+
+            m_repair_rows.resize(the_factory.max_symbols());
+            m_repairs.resize(the_factory.max_symbols());
+            m_sources.resize(the_factory.max_symbols());
+            m_coefficients.resize(the_factory.max_symbols());
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            m_repair_count = 0;
+        }
+
+        /// Stores a systematic symbol or buffers a repair symbol
+        /// @copydoc layer::decode(uint8_t*, uint8_t*)
+        void decode(uint8_t *symbol_data, uint8_t *symbol_header)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_header != 0);
+
+            value_type row = sak::big_endian::get<value_type>(symbol_header);
+
+            assert(m_matrix);
+            assert(row < m_matrix->rows());
+
+            // The first rows of the systematic generator matrix are
+            // the unit vectors
+            if(row < SuperCoder::symbols())
+            {
+                decode_symbol(symbol_data, row);
+                return;
+            }
+
+            // Only as many repair symbols as missing symbols are used
+            if(m_repair_count >= SuperCoder::symbols_missing())
+                return;
+
+            // The repairs are kept sorted by row, so the same set of
+            // repair symbols gives the same erasure pattern
+            uint32_t position = 0;
+
+            while(position < m_repair_count && m_repair_rows[position] < row)
+                ++position;
+
+            if(position < m_repair_count && m_repair_rows[position] == row)
+                return;
+
+            std::vector<uint8_t>& repair = m_repairs[m_repair_count];
+            repair.assign(symbol_data, symbol_data + SuperCoder::symbol_size());
+
+            for(uint32_t i = m_repair_count; i > position; --i)
+            {
+                m_repair_rows[i] = m_repair_rows[i - 1];
+                m_repairs[i].swap(m_repairs[i - 1]);
+            }
+
+            m_repair_rows[position] = row;
+            ++m_repair_count;
+
+            recover();
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint32_t)
+        void decode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_index < SuperCoder::symbols());
+
+            if(SuperCoder::is_symbol_uncoded(symbol_index))
+                return;
+
+            sak::const_storage src =
+                sak::storage(symbol_data, SuperCoder::symbol_size());
+
+            SuperCoder::copy_into_symbol(symbol_index, src);
+            SuperCoder::set_symbol_uncoded(symbol_index);
+
+            recover();
+        }
+
+        /// @copydoc layer::header_size() const
+        uint32_t header_size() const
+        {
+            return SuperCoder::id_size();
+        }
+
+        /// @copydoc layer::is_complete() const
+        bool is_complete() const
+        {
+            return SuperCoder::symbols_uncoded() == SuperCoder::symbols();
+        }
+
+        /// @copydoc layer::rank() const
+        rank_type rank() const
+        {
+            return SuperCoder::symbols_uncoded();
+        }
+
+        /// @copydoc layer::is_symbol_pivot(uint32_t) const
+        bool is_symbol_pivot(uint32_t index) const
+        {
+            return SuperCoder::is_symbol_uncoded(index);
+        }
+
+        /// @return The number of repair symbols buffered
+        uint32_t repair_symbols() const
+        {
+            return m_repair_count;
+        }
+
+    protected:
+
+        /// Rebuilds the missing symbols once enough repair symbols have
+        /// been received
+        void recover()
+        {
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t missing = SuperCoder::symbols_missing();
+
+            if(missing == 0 || m_repair_count < missing)
+                return;
+
+            // The erasure pattern, the repairs received in excess of
+            // the missing symbols are not used
+            m_key.clear();
+            m_key.push_back(symbols);
+
+            for(uint32_t i = SuperCoder::next_symbol_missing(0); i < symbols;
+                i = SuperCoder::next_symbol_missing(i + 1))
+            {
+                m_key.push_back(i);
+            }
+
+            assert(m_key.size() == missing + 1);
+
+            m_key.insert(m_key.end(), m_repair_rows.begin(),
+                         m_repair_rows.begin() + missing);
+
+            erasure_pattern_cache::matrix_pointer matrix =
+                m_cache->find(m_key);
+
+            if(!matrix)
+            {
+                matrix = build_decoding_matrix(missing);
+                m_cache->insert(m_key, matrix);
+            }
+
+            // Column j of the decoding matrix refers to symbol j if
+            // it was received, or to the repair symbol used in its
+            // place
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                m_sources[i] = SuperCoder::symbol_value(i);
+            }
+
+            for(uint32_t i = 0; i < missing; ++i)
+            {
+                m_sources[m_key[1 + i]] =
+                    reinterpret_cast<const value_type*>(m_repairs[i].data());
+            }
+
+            uint32_t vector_size = SuperCoder::coefficient_vector_size();
+            uint32_t symbol_length = SuperCoder::symbol_length();
+
+            for(uint32_t i = 0; i < missing; ++i)
+            {
+                const value_type* coefficients =
+                    reinterpret_cast<const value_type*>(
+                        &(*matrix)[i * vector_size]);
+
+                for(uint32_t j = 0; j < symbols; ++j)
+                {
+                    m_coefficients[j] =
+                        fifi::get_value<field_type>(coefficients, j);
+                }
+
+                uint32_t index = m_key[1 + i];
+                value_type* symbol = SuperCoder::symbol_value(index);
+
+                std::fill_n(symbol, symbol_length, 0);
+
+                SuperCoder::multiply_add_n(symbol, &m_sources[0],
+                                           &m_coefficients[0], symbols,
+                                           symbol_length);
+            }
+
+            for(uint32_t i = 0; i < missing; ++i)
+            {
+                SuperCoder::set_symbol_uncoded(m_key[1 + i]);
+            }
+
+            m_repair_count = 0;
+        }
+
+        /// Builds the decoding matrix of the erasure pattern in m_key.
+        /// Row i holds the coefficients rebuilding the i'th missing
+        /// symbol from the received symbols.
+        /// @param missing The number of missing symbols
+        /// @return The decoding matrix
+        erasure_pattern_cache::matrix_pointer
+        build_decoding_matrix(uint32_t missing)
+        {
+            const uint32_t* missing_symbols = &m_key[1];
+            const uint32_t* repair_rows = &m_key[1 + missing];
+
+            // Invert the repair rows restricted to the missing columns
+            // with Gauss-Jordan elimination on [A | I]
+            uint32_t length = fifi::elements_to_length<field_type>(2 * missing);
+
+            std::vector<std::vector<value_type> > system(
+                missing, std::vector<value_type>(length, 0));
+
+            for(uint32_t i = 0; i < missing; ++i)
+            {
+                value_type* row = &system[i][0];
+
+                for(uint32_t j = 0; j < missing; ++j)
+                {
+                    fifi::set_value<field_type>(row, j,
+                        m_matrix->element(repair_rows[i], missing_symbols[j]));
+                }
+
+                fifi::set_value<field_type>(row, missing + i, 1);
+            }
+
+            for(uint32_t i = 0; i < missing; ++i)
+            {
+                uint32_t pivot = i;
+
+                while(fifi::get_value<field_type>(&system[pivot][0], i) == 0)
+                {
+                    ++pivot;
+
+                    // Any square sub-matrix of an MDS code is invertible
+                    assert(pivot < missing);
+                }
+
+                system[i].swap(system[pivot]);
+
+                value_type* row = &system[i][0];
+                value_type value = fifi::get_value<field_type>(row, i);
+
+                if(value != 1)
+                {
+                    SuperCoder::multiply(row, SuperCoder::invert(value), length);
+                }
+
+                for(uint32_t j = 0; j < missing; ++j)
+                {
+                    if(j == i)
+                        continue;
+
+                    value_type factor =
+                        fifi::get_value<field_type>(&system[j][0], i);
+
+                    if(factor != 0)
+                    {
+                        SuperCoder::multiply_subtract(&system[j][0], row,
+                                                      factor, length);
+                    }
+                }
+            }
+
+            // Repair i equals the sum of its coefficients times the
+            // symbols, so the i'th missing symbol contributes the
+            // repair minus the received symbols it covers
+            uint32_t vector_size = SuperCoder::coefficient_vector_size();
+            uint32_t vector_length = SuperCoder::coefficient_vector_length();
+
+            std::vector<value_type> covered(vector_length);
+            std::vector<std::vector<value_type> > contributions(
+                missing, std::vector<value_type>(vector_length, 0));
+
+            for(uint32_t i = 0; i < missing; ++i)
+            {
+                std::copy_n(m_matrix->row_value(repair_rows[i]),
+                            vector_length, covered.begin());
+
+                for(uint32_t j = 0; j < missing; ++j)
+                {
+                    fifi::set_value<field_type>(&covered[0],
+                                                missing_symbols[j], 0);
+                }
+
+                value_type* contribution = &contributions[i][0];
+
+                SuperCoder::subtract(contribution, &covered[0],
+                                     vector_length);
+
+                fifi::set_value<field_type>(contribution,
+                                            missing_symbols[i], 1);
+            }
+
+            auto matrix = std::make_shared<erasure_pattern_cache::matrix_type>(
+                missing * vector_size, 0);
+
+            for(uint32_t i = 0; i < missing; ++i)
+            {
+                value_type* row =
+                    reinterpret_cast<value_type*>(&(*matrix)[i * vector_size]);
+
+                for(uint32_t j = 0; j < missing; ++j)
+                {
+                    value_type coefficient =
+                        fifi::get_value<field_type>(&system[i][0], missing + j);
+
+                    if(coefficient != 0)
+                    {
+                        SuperCoder::multiply_add(row, &contributions[j][0],
+                                                 coefficient, vector_length);
+                    }
+                }
+            }
+
+            return matrix;
+        }
+
+    protected:
+
+        /// Access the generator matrix
+        using SuperCoder::m_matrix;
+
+        /// The cache of decoding matrices shared through the factory
+        std::shared_ptr<erasure_pattern_cache> m_cache;
+
+        /// The number of repair symbols buffered
+        uint32_t m_repair_count;
+
+        /// The generator matrix rows of the buffered repair symbols
+        /// in increasing order
+        std::vector<uint32_t> m_repair_rows;
+
+        /// The buffered repair symbols
+        std::vector<std::vector<uint8_t> > m_repairs;
+
+        /// The erasure pattern being decoded
+        erasure_pattern_cache::key_type m_key;
+
+        /// The symbols combined when rebuilding a missing symbol
+        std::vector<const value_type*> m_sources;
+
+        /// The coefficients used when rebuilding a missing symbol
+        std::vector<value_type> m_coefficients;
+    };
+}
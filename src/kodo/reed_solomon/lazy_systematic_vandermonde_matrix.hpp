@@ -0,0 +1,301 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <fifi/fifi_utils.hpp>
+
+namespace kodo
+{
+    /// @brief The transposed systematic Vandermonde generator matrix
+    ///        with rows computed on first use.
+    ///
+    /// Holds the same values as the matrix built by the
+    /// systematic_vandermonde_matrix layer, i.e. row r is the encoding
+    /// vector of encoded symbol r and the first rows are the unit
+    /// vectors. Instead of eliminating the full symbols x (2^m - 1)
+    /// Vandermonde matrix, row r is computed directly as the Lagrange
+    /// basis polynomials of the points a^0, ..., a^(k-1) evaluated in
+    /// a^r, where a is the primitive element. The systematic
+    /// Vandermonde matrix maps every column of the Vandermonde matrix
+    /// to these values, since the Lagrange basis reproduces the
+    /// powers 1, x, ..., x^(k-1).
+    ///
+    /// Building the matrix only computes the Lagrange denominators in
+    /// O(k^2), and each row is computed in O(k) the first time it is
+    /// requested. Rows are published atomically, so the matrix may be
+    /// read from several threads. Use shared() to get the process
+    /// wide instance for a number of symbols.
+    template<class FieldImpl>
+    class lazy_systematic_vandermonde_matrix : boost::noncopyable
+    {
+    public:
+
+        /// The finite field implementation
+        typedef FieldImpl field_impl;
+
+        /// The finite field type used
+        typedef typename field_impl::field_type field_type;
+
+        /// The value type used in the finite field
+        typedef typename field_type::value_type value_type;
+
+    public:
+
+        /// Constructor
+        /// @param columns The number of source symbols
+        lazy_systematic_vandermonde_matrix(uint32_t columns)
+            : m_rows(field_type::order - 1),
+              m_columns(columns),
+              m_row_table(new std::atomic<value_type*>[m_rows]()),
+              m_built_rows(0)
+        {
+            // A Reed-Solomon code cannot support more symbols
+            // than 2^m - 1 where m is the size of the finite
+            // field
+            assert(m_columns > 0);
+            assert(m_columns < field_type::order);
+
+            m_row_size = fifi::elements_to_size<field_type>(m_columns);
+            m_row_length = fifi::size_to_length<field_type>(m_row_size);
+
+            // The points a^i and the inverted Lagrange denominators
+            // prod_{j != i} (a^i - a^j)
+            m_points.resize(m_columns);
+            m_inverse_denominators.resize(m_columns);
+
+            value_type point = 1U;
+
+            for(uint32_t i = 0; i < m_columns; ++i)
+            {
+                m_points[i] = point;
+
+                // Multiplying with 2U corresponds to multiplying
+                // with x
+                point = m_field.multiply(point, 2U);
+            }
+
+            for(uint32_t i = 0; i < m_columns; ++i)
+            {
+                value_type denominator = 1U;
+
+                for(uint32_t j = 0; j < m_columns; ++j)
+                {
+                    if(j == i)
+                        continue;
+
+                    denominator = m_field.multiply(denominator,
+                        m_field.subtract(m_points[i], m_points[j]));
+                }
+
+                m_inverse_denominators[i] = m_field.invert(denominator);
+            }
+        }
+
+        /// Destructor
+        ~lazy_systematic_vandermonde_matrix()
+        {
+            for(uint32_t i = 0; i < m_rows; ++i)
+            {
+                delete[] m_row_table[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        /// Returns the matrix for a number of symbols shared by the
+        /// whole process. The matrix is built on first use.
+        /// @param columns The number of source symbols
+        /// @return The shared matrix
+        static std::shared_ptr<lazy_systematic_vandermonde_matrix>
+        shared(uint32_t columns)
+        {
+            static std::mutex mutex;
+            static std::map<uint32_t,
+                std::shared_ptr<lazy_systematic_vandermonde_matrix> > cache;
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto& matrix = cache[columns];
+
+            if(!matrix)
+            {
+                matrix = std::make_shared<lazy_systematic_vandermonde_matrix>(
+                    columns);
+            }
+
+            return matrix;
+        }
+
+        /// Returns the element at the specific row and column in
+        /// the matrix.
+        /// @param row The row index
+        /// @param column The column index
+        /// @return The element stored.
+        value_type element(uint32_t row, uint32_t column) const
+        {
+            assert(row < m_rows);
+            assert(column < m_columns);
+
+            return fifi::get_value<field_type>(row_value(row), column);
+        }
+
+        /// @return The size of a row in bytes
+        uint32_t row_size() const
+        {
+            return m_row_size;
+        }
+
+        /// @return The length of a row in the field's value_type
+        uint32_t row_length() const
+        {
+            return m_row_length;
+        }
+
+        /// Return the bytes of a row at a specific index
+        /// @param index The index of the row to return
+        /// @return The byte corresponding to the selected row.
+        const uint8_t* row(uint32_t index) const
+        {
+            return reinterpret_cast<const uint8_t*>(row_value(index));
+        }
+
+        /// Return a value_type pointer to a row at a specific index,
+        /// the row is computed if it is requested for the first time
+        /// @param index The index of the row to return
+        /// @return The value_type pointer corresponding to the selected row.
+        const value_type* row_value(uint32_t index) const
+        {
+            assert(index < m_rows);
+
+            value_type* row =
+                m_row_table[index].load(std::memory_order_acquire);
+
+            if(row != 0)
+                return row;
+
+            value_type* built = build_row(index);
+
+            // Another thread may have built the row meanwhile, in
+            // which case its row is used
+            if(m_row_table[index].compare_exchange_strong(
+                   row, built, std::memory_order_acq_rel,
+                   std::memory_order_acquire))
+            {
+                ++m_built_rows;
+                return built;
+            }
+
+            delete[] built;
+            return row;
+        }
+
+        /// @return The number of rows
+        uint32_t rows() const
+        {
+            return m_rows;
+        }
+
+        /// @return The number of columns
+        uint32_t columns() const
+        {
+            return m_columns;
+        }
+
+        /// @return The number of rows computed so far
+        uint32_t built_rows() const
+        {
+            return m_built_rows;
+        }
+
+    private:
+
+        /// Computes a row of the matrix
+        /// @param index The index of the row
+        /// @return The row allocated with new[]
+        value_type* build_row(uint32_t index) const
+        {
+            value_type* row = new value_type[m_row_length]();
+
+            if(index < m_columns)
+            {
+                fifi::set_value<field_type>(row, index, 1U);
+                return row;
+            }
+
+            // The point a^index, which differs from all the points
+            // a^0, ..., a^(k-1) since k < 2^m - 1
+            value_type point = 1U;
+            value_type generator = 2U;
+
+            for(uint32_t e = index; e > 0; e >>= 1)
+            {
+                if(e & 1)
+                    point = m_field.multiply(point, generator);
+
+                generator = m_field.multiply(generator, generator);
+            }
+
+            // L_i(point) = prod_{j} (point - a^j) /
+            //              ((point - a^i) * prod_{j != i} (a^i - a^j))
+            value_type product = 1U;
+
+            for(uint32_t i = 0; i < m_columns; ++i)
+            {
+                product = m_field.multiply(product,
+                    m_field.subtract(point, m_points[i]));
+            }
+
+            for(uint32_t i = 0; i < m_columns; ++i)
+            {
+                value_type value = m_field.divide(product,
+                    m_field.subtract(point, m_points[i]));
+
+                value = m_field.multiply(value, m_inverse_denominators[i]);
+
+                fifi::set_value<field_type>(row, i, value);
+            }
+
+            return row;
+        }
+
+    private:
+
+        /// The finite field implementation
+        field_impl m_field;
+
+        /// The number of rows
+        uint32_t m_rows;
+
+        /// The number of columns
+        uint32_t m_columns;
+
+        /// The size of a row in bytes
+        uint32_t m_row_size;
+
+        /// The length of a row in value_type elements
+        uint32_t m_row_length;
+
+        /// The points a^i of the columns
+        std::vector<value_type> m_points;
+
+        /// The inverted Lagrange denominators of the columns
+        std::vector<value_type> m_inverse_denominators;
+
+        /// The rows built so far, null for the rows not yet requested
+        std::unique_ptr<std::atomic<value_type*>[]> m_row_table;
+
+        /// The number of rows built so far
+        mutable std::atomic<uint32_t> m_built_rows;
+    };
+}
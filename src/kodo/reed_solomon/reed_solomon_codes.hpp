@@ -7,3 +7,4 @@
 
 #include "reed_solomon_encoder.hpp"
 #include "reed_solomon_decoder.hpp"
+#include "reed_solomon_erasure_decoder.hpp"
@@ -15,7 +15,7 @@
 #include "../finite_field_layers.hpp"
 
 #include "reed_solomon_symbol_id_reader.hpp"
-#include "systematic_vandermonde_matrix.hpp"
+#include "shared_systematic_vandermonde_matrix.hpp"
 
 namespace kodo
 {
@@ -35,7 +35,7 @@ namespace kodo
         symbol_id_decoder<
         // Symbol ID API
         reed_solomon_symbol_id_reader<
-        systematic_vandermonde_matrix<
+        shared_systematic_vandermonde_matrix<
         // Decoder API
         common_decoder_layers<TraceTag,
         // Coefficient Storage API
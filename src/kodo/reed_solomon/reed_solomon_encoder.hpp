@@ -8,19 +8,22 @@
 #include "../final_layer.hpp"
 #include "../zero_symbol_encoder.hpp"
 #include "../default_on_systematic_encoder.hpp"
+#include "../gather_payload_encoder.hpp"
+#include "../batch_payload_encoder.hpp"
 #include "../payload_encoder.hpp"
 #include "../symbol_id_encoder.hpp"
 #include "../coefficient_info.hpp"
 #include "../coefficient_value_access.hpp"
 #include "../storage_aware_encoder.hpp"
 #include "../encode_symbol_tracker.hpp"
+#include "../symbol_reference_encoder.hpp"
 #include "../linear_block_encoder.hpp"
 #include "../deep_storage_layers.hpp"
 #include "../finite_field_layers.hpp"
 
 #include "reed_solomon_symbol_id_writer.hpp"
 #include "reed_solomon_symbol_id_reader.hpp"
-#include "systematic_vandermonde_matrix.hpp"
+#include "shared_systematic_vandermonde_matrix.hpp"
 
 namespace kodo
 {
@@ -36,16 +39,19 @@ namespace kodo
     template<class Field, class TraceTag = kodo::disable_trace>
     class reed_solomon_encoder : public
         // Payload API
+        gather_payload_encoder<
+        batch_payload_encoder<
         payload_encoder<
         // Codec Header API
         default_on_systematic_encoder<
         symbol_id_encoder<
         // Symbol ID API
         reed_solomon_symbol_id_writer<
-        systematic_vandermonde_matrix<
+        shared_systematic_vandermonde_matrix<
         // Encoder API
         encode_symbol_tracker<
         zero_symbol_encoder<
+        symbol_reference_encoder<
         linear_block_encoder<
         storage_aware_encoder<
         // Coefficient Storage API
@@ -57,7 +63,7 @@ namespace kodo
         finite_field_layers<Field,
         // Final Layer
         final_layer
-        > > > > > > > > > > > > >
+        > > > > > > > > > > > > > > > >
     {
     public:
         using factory = pool_factory<reed_solomon_encoder>;
@@ -0,0 +1,62 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "../final_layer.hpp"
+#include "../systematic_decoder.hpp"
+#include "../payload_decoder.hpp"
+#include "../rank_info.hpp"
+#include "../symbol_decoding_status_counter.hpp"
+#include "../symbol_decoding_status_tracker.hpp"
+#include "../coefficient_info.hpp"
+#include "../deep_storage_layers.hpp"
+#include "../finite_field_layers.hpp"
+#include "../pool_factory.hpp"
+
+#include "erasure_pattern_decoder.hpp"
+#include "reed_solomon_symbol_id.hpp"
+#include "shared_systematic_vandermonde_matrix.hpp"
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    ///
+    /// @brief Implementation of a RS decoder which only inverts the
+    ///        part of the generator matrix covering the erased symbols
+    ///
+    /// Decodes the packets of the reed_solomon_encoder. Instead of
+    /// Gauss-Jordan elimination on every received symbol the decoder
+    /// collects k symbols and rebuilds the missing systematic symbols
+    /// in one pass, caching the decoding matrix of each erasure
+    /// pattern in the factory (see erasure_pattern_decoder).
+    template<class Field, class TraceTag = kodo::disable_trace>
+    class reed_solomon_erasure_decoder : public
+        // Payload API
+        payload_decoder<
+        // Codec Header API
+        systematic_decoder<
+        erasure_pattern_decoder<
+        // Symbol ID API
+        reed_solomon_symbol_id<
+        shared_systematic_vandermonde_matrix<
+        // Decoder API
+        rank_info<
+        symbol_decoding_status_counter<
+        symbol_decoding_status_tracker<
+        // Coefficient Storage API
+        coefficient_info<
+        // Storage API
+        deep_storage_layers<TraceTag,
+        // Finite Field API
+        finite_field_layers<Field,
+        // Final Layer
+        final_layer
+        > > > > > > > > > > >
+    {
+    public:
+        using factory = pool_factory<reed_solomon_erasure_decoder>;
+    };
+}
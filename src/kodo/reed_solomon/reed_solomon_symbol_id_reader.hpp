@@ -47,11 +47,11 @@ namespace kodo
                              m_matrix->row_size());
 
             sak::mutable_storage dest =
-                sak::storage(m_coefficients);
+                sak::storage(m_coefficients, m_coefficients_size);
 
             sak::copy_storage(dest, src);
 
-            *symbol_coefficients = &m_coefficients[0];
+            *symbol_coefficients = m_coefficients;
         }
 
     private:
@@ -63,6 +63,10 @@ namespace kodo
         /// layer used by the reed_solomon_symbol_id layer
         using SuperCoder::m_coefficients;
 
+        /// Access the size of the buffer in the coefficients buffer
+        /// layer
+        using SuperCoder::m_coefficients_size;
+
     };
 
     /// @copydoc reed_solomon_symbol_id_reader_base
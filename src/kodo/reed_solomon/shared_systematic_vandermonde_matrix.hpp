@@ -0,0 +1,70 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+
+#include "lazy_systematic_vandermonde_matrix.hpp"
+
+namespace kodo
+{
+    /// @brief Provides the systematic Vandermonde generator matrix
+    ///        from a process wide cache.
+    ///
+    /// Gives the same matrix as the systematic_vandermonde_matrix
+    /// layer, but the matrix is a lazy_systematic_vandermonde_matrix
+    /// shared by all the factories using the same field
+    /// implementation and number of symbols. Only the rows of the
+    /// encoded symbols actually produced or received are computed.
+    template<class SuperCoder>
+    class shared_systematic_vandermonde_matrix : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// The generator matrix type
+        typedef lazy_systematic_vandermonde_matrix<
+            typename SuperCoder::field_impl> generator_matrix;
+
+    public:
+
+        /// The factory layer associated with this coder. Gives access
+        /// to the shared generator matrices.
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t, uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            {
+                // A Reed-Solomon code cannot support more symbols
+                // than 2^m - 1 where m is the size of the finite
+                // field
+                assert(max_symbols < field_type::order);
+            }
+
+            /// Returns the shared systematic Vandermonde matrix
+            /// @param symbols The number of source symbols to encode
+            /// @return The Vandermonde matrix
+            std::shared_ptr<generator_matrix> construct_matrix(
+                uint32_t symbols)
+            {
+                assert(symbols > 0);
+                return generator_matrix::shared(symbols);
+            }
+
+        };
+
+    };
+}
@@ -49,7 +49,29 @@ namespace kodo
         void decode(uint8_t *payload)
         {
             SuperCoder::decode(payload);
+            restore();
+        }
+
+        /// @copydoc layer::decode(const uint8_t*)
+        void decode(const uint8_t *payload)
+        {
+            SuperCoder::decode(payload);
+            restore();
+        }
 
+        /// @copydoc layer::decode_batch(uint8_t**, uint32_t)
+        void decode_batch(uint8_t **payloads, uint32_t count)
+        {
+            SuperCoder::decode_batch(payloads, count);
+            restore();
+        }
+
+    private:
+
+        /// Invokes the restore function the first time decoding is
+        /// complete
+        void restore()
+        {
             if (!SuperCoder::is_complete())
                 return;
 
@@ -5,8 +5,10 @@
 
 #pragma once
 
+#include <cassert>
 #include <cstdint>
 #include <algorithm>
+#include <limits>
 
 namespace kodo
 {
@@ -31,7 +33,7 @@ namespace kodo
         /// @param object_size the size in bytes of the whole object
         rfc5052_partitioning_scheme(uint32_t max_symbols,
                                     uint32_t max_symbol_size,
-                                    uint32_t object_size);
+                                    uint64_t object_size);
 
         /// @copydoc block_partitioning::symbols(uint32_t) const
         uint32_t symbols(uint32_t block_id) const;
@@ -43,7 +45,7 @@ namespace kodo
         uint32_t block_size(uint32_t block_id) const;
 
         /// @copydoc block_partitioning::bytes_offset(uint32_t) const
-        uint32_t byte_offset(uint32_t block_id) const;
+        uint64_t byte_offset(uint32_t block_id) const;
 
         /// @copydoc block_partitioning::bytes_used(uint32_t) const
         uint32_t bytes_used(uint32_t block_id) const;
@@ -52,13 +54,13 @@ namespace kodo
         uint32_t blocks() const;
 
         /// @copydoc block_partitioning::object_size() const
-        uint32_t object_size() const;
+        uint64_t object_size() const;
 
         /// @copydoc block_partitioning::total_symbols() const
-        uint32_t total_symbols() const;
+        uint64_t total_symbols() const;
 
         /// @copydoc block_partitioning::total_block_size() const
-        uint32_t total_block_size() const;
+        uint64_t total_block_size() const;
 
     private:
 
@@ -69,10 +71,10 @@ namespace kodo
         uint32_t m_max_symbol_size;
 
         /// The size of the object to transfer in bytes
-        uint32_t m_object_size;
+        uint64_t m_object_size;
 
         /// The total number of symbols in the object
-        uint32_t m_total_symbols;
+        uint64_t m_total_symbols;
 
         /// The total number of blocks in the object
         uint32_t m_total_blocks;
@@ -105,7 +107,7 @@ namespace kodo
     inline rfc5052_partitioning_scheme::rfc5052_partitioning_scheme(
         uint32_t max_symbols,
         uint32_t max_symbol_size,
-        uint32_t object_size)
+        uint64_t object_size)
         : m_max_symbols(max_symbols),
           m_max_symbol_size(max_symbol_size),
           m_object_size(object_size)
@@ -116,13 +118,20 @@ namespace kodo
 
         // ceil(x/y) = ((x - 1) / y) + 1
         m_total_symbols = ((m_object_size - 1) / m_max_symbol_size) + 1;
-        m_total_blocks  = ((m_total_symbols - 1) / m_max_symbols) + 1;
 
-        m_large_block_symbols = ((m_total_symbols - 1) / m_total_blocks) + 1;
-        m_small_block_symbols = m_total_symbols / m_total_blocks;
+        uint64_t total_blocks = ((m_total_symbols - 1) / m_max_symbols) + 1;
 
-        m_large_blocks = m_total_symbols -
-            (m_small_block_symbols * m_total_blocks);
+        // The blocks are indexed with 32 bit integers
+        assert(total_blocks <= std::numeric_limits<uint32_t>::max());
+        m_total_blocks = (uint32_t) total_blocks;
+
+        m_large_block_symbols =
+            (uint32_t) (((m_total_symbols - 1) / m_total_blocks) + 1);
+        m_small_block_symbols =
+            (uint32_t) (m_total_symbols / m_total_blocks);
+
+        m_large_blocks = (uint32_t) (m_total_symbols -
+            (uint64_t) m_small_block_symbols * m_total_blocks);
 
         m_small_blocks = m_total_blocks - m_large_blocks;
     }
@@ -148,22 +157,23 @@ namespace kodo
         return symbols(block_id) * symbol_size(block_id);
     }
 
-    inline uint32_t
+    inline uint64_t
     rfc5052_partitioning_scheme::byte_offset(uint32_t block_id) const
     {
         assert(block_id < m_total_blocks);
 
         if(block_id < m_large_blocks)
         {
-            return block_id * m_large_block_symbols * m_max_symbol_size;
+            return (uint64_t) block_id * m_large_block_symbols *
+                m_max_symbol_size;
         }
 
         // Calculating the largeblock offset
-        uint32_t offset =
-            m_large_blocks * m_large_block_symbols * m_max_symbol_size;
+        uint64_t offset = (uint64_t) m_large_blocks *
+            m_large_block_symbols * m_max_symbol_size;
 
         // Calculating the smallblock offset
-        offset += (block_id - m_large_blocks) *
+        offset += (uint64_t) (block_id - m_large_blocks) *
             m_small_block_symbols * m_max_symbol_size;
 
         return offset;
@@ -174,13 +184,13 @@ namespace kodo
     {
         assert(block_id < m_total_blocks);
 
-        uint32_t offset = byte_offset(block_id);
+        uint64_t offset = byte_offset(block_id);
 
         assert(offset < m_object_size);
-        uint32_t remaining =  m_object_size - offset;
+        uint64_t remaining =  m_object_size - offset;
         uint32_t the_block_size = block_size(block_id);
 
-        return std::min(remaining, the_block_size);
+        return (uint32_t) std::min<uint64_t>(remaining, the_block_size);
     }
 
     inline uint32_t
@@ -190,21 +200,21 @@ namespace kodo
         return m_total_blocks;
     }
 
-    inline uint32_t
+    inline uint64_t
     rfc5052_partitioning_scheme::object_size() const
     {
         assert(m_object_size > 0);
         return m_object_size;
     }
 
-    inline uint32_t
+    inline uint64_t
     rfc5052_partitioning_scheme::total_symbols() const
     {
         assert(m_total_symbols > 0);
         return m_total_symbols;
     }
 
-    inline uint32_t
+    inline uint64_t
     rfc5052_partitioning_scheme::total_block_size() const
     {
         return m_total_symbols * m_max_symbol_size;
@@ -0,0 +1,59 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "../const_payload_decoder.hpp"
+#include "../batch_payload_decoder.hpp"
+#include "../payload_decoder.hpp"
+#include "../systematic_decoder.hpp"
+#include "../symbol_id_decoder.hpp"
+#include "../seed_symbol_id_reader.hpp"
+#include "../common_decoder_layers.hpp"
+#include "../coefficient_storage_layers.hpp"
+#include "../deep_storage_layers.hpp"
+#include "../finite_field_layers.hpp"
+#include "../philox_uniform_generator.hpp"
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    ///
+    /// @brief Implementation of a seed based RLNC decoder using the
+    ///        counter based Philox generator, see the
+    ///        fast_seed_rlnc_encoder.
+    ///
+    /// Adds the following features (including those described for
+    /// the encoder):
+    /// - Linear block decoder using Gauss-Jordan elimination.
+    template<class Field, class TraceTag = kodo::disable_trace>
+    class fast_seed_rlnc_decoder : public
+        // Payload API
+        const_payload_decoder<
+        batch_payload_decoder<
+        payload_decoder<
+        // Codec Header API
+        systematic_decoder<
+        symbol_id_decoder<
+        // Symbol ID API
+        seed_symbol_id_reader<
+        // Coefficient Generator API
+        philox_uniform_generator<
+        // Decoder API
+        common_decoder_layers<TraceTag,
+        // Coefficient Storage API
+        coefficient_storage_layers<
+        // Storage API
+        deep_storage_layers<TraceTag,
+        // Finite Field Math API
+        finite_field_layers<Field,
+        // Final Layer
+        final_layer
+        > > > > > > > > > > >
+    {
+    public:
+        using factory = pool_factory<fast_seed_rlnc_decoder>;
+    };
+}
@@ -6,10 +6,13 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 
 #include "../final_layer.hpp"
 #include "../systematic_decoder.hpp"
 #include "../payload_decoder.hpp"
+#include "../const_payload_decoder.hpp"
+#include "../batch_payload_decoder.hpp"
 #include "../symbol_id_decoder.hpp"
 #include "../plain_symbol_id_reader.hpp"
 #include "../proxy_stack.hpp"
@@ -18,6 +21,7 @@
 #include "../coefficient_storage_layers.hpp"
 #include "../deep_storage_layers.hpp"
 #include "../finite_field_layers.hpp"
+#include "../storage_allocator.hpp"
 
 #include "full_rlnc_recoding_stack.hpp"
 
@@ -31,11 +35,20 @@ namespace kodo
     /// described for the encoder):
     /// - Recoding using the recoding_stack
     /// - Linear block decoder using Gauss-Jordan elimination.
-    template<class Field, class TraceTag = kodo::disable_trace>
+    /// - The symbol and coefficient buffers are allocated with the
+    ///   Allocator, see the storage_allocator layer.
+    template
+    <
+        class Field,
+        class TraceTag = kodo::disable_trace,
+        class Allocator = std::allocator<uint8_t>
+    >
     class full_rlnc_decoder : public
         // Payload API
         nested_payload_recoder<
         proxy_stack<proxy_args<>, full_rlnc_recoding_stack,
+        const_payload_decoder<
+        batch_payload_decoder<
         payload_decoder<
         // Codec Header API
         systematic_decoder<
@@ -50,9 +63,11 @@ namespace kodo
         deep_storage_layers<TraceTag,
         // Finite Field API
         finite_field_layers<Field,
+        // Allocator API
+        storage_allocator<Allocator,
         // Final Layer
         final_layer
-        > > > > > > > > > >
+        > > > > > > > > > > > > >
     {
     public:
         using factory = pool_factory<full_rlnc_decoder>;
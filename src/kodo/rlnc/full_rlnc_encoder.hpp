@@ -6,22 +6,27 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 
 #include "../final_layer.hpp"
 #include "../zero_symbol_encoder.hpp"
 #include "../default_on_systematic_encoder.hpp"
+#include "../gather_payload_encoder.hpp"
+#include "../batch_payload_encoder.hpp"
 #include "../payload_encoder.hpp"
 #include "../symbol_id_encoder.hpp"
 #include "../coefficient_storage.hpp"
 #include "../coefficient_info.hpp"
 #include "../plain_symbol_id_writer.hpp"
-#include "../uniform_generator.hpp"
+#include "../fast_uniform_generator.hpp"
 #include "../storage_aware_encoder.hpp"
 #include "../encode_symbol_tracker.hpp"
+#include "../symbol_reference_encoder.hpp"
 #include "../linear_block_encoder.hpp"
 #include "../coefficient_value_access.hpp"
 #include "../deep_storage_layers.hpp"
 #include "../finite_field_layers.hpp"
+#include "../storage_allocator.hpp"
 
 namespace kodo
 {
@@ -36,9 +41,18 @@ namespace kodo
     ///   Encoding vectors are generated using a random uniform generator.
     /// - Deep symbol storage which makes the encoder allocate its own
     ///   internal memory.
-    template<class Field, class TraceTag = kodo::disable_trace>
+    /// - The symbol and coefficient buffers are allocated with the
+    ///   Allocator, see the storage_allocator layer.
+    template
+    <
+        class Field,
+        class TraceTag = kodo::disable_trace,
+        class Allocator = std::allocator<uint8_t>
+    >
     class full_rlnc_encoder : public
         // Payload Codec API
+        gather_payload_encoder<
+        batch_payload_encoder<
         payload_encoder<
         // Codec Header API
         default_on_systematic_encoder<
@@ -46,10 +60,11 @@ namespace kodo
         // Symbol ID API
         plain_symbol_id_writer<
         // Coefficient Generator API
-        uniform_generator<
+        fast_uniform_generator<
         // Codec API
         encode_symbol_tracker<
         zero_symbol_encoder<
+        symbol_reference_encoder<
         linear_block_encoder<
         storage_aware_encoder<
         // Coefficient Storage API
@@ -59,9 +74,11 @@ namespace kodo
         deep_storage_layers<TraceTag,
         // Finite Field API
         finite_field_layers<Field,
+        // Allocator API
+        storage_allocator<Allocator,
         // Final Layer
         final_layer
-        > > > > > > > > > > > > >
+        > > > > > > > > > > > > > > > > >
     {
     public:
         using factory = pool_factory<full_rlnc_encoder>;
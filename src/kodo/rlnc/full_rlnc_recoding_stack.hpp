@@ -8,7 +8,7 @@
 #include "../zero_symbol_encoder.hpp"
 #include "../default_off_systematic_encoder.hpp"
 #include "../payload_encoder.hpp"
-#include "../uniform_generator.hpp"
+#include "../fast_uniform_generator.hpp"
 #include "../recoding_symbol_id.hpp"
 #include "../proxy_layer.hpp"
 #include "../encode_symbol_tracker.hpp"
@@ -44,7 +44,7 @@ namespace kodo
         // Symbol ID API
         recoding_symbol_id<
         // Coefficient Generator API
-        uniform_generator<
+        fast_uniform_generator<
         pivot_aware_generator<
         // Encoder API
         encode_symbol_tracker<
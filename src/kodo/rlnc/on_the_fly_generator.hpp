@@ -8,7 +8,7 @@
 #include <cstdint>
 
 #include "../check_partial_generator.hpp"
-#include "../uniform_generator.hpp"
+#include "../fast_uniform_generator.hpp"
 #include "../pivot_aware_generator.hpp"
 
 namespace kodo
@@ -23,7 +23,7 @@ namespace kodo
     template<class SuperCoder>
     using on_the_fly_generator =
         check_partial_generator<
-        uniform_generator<
+        fast_uniform_generator<
         pivot_aware_generator<
         SuperCoder> > >;
 }
@@ -43,7 +43,7 @@ namespace kodo
         // Symbol ID API
         recoding_symbol_id<
         // Coefficient Generator API
-        uniform_generator<
+        fast_uniform_generator<
         pivot_aware_generator<
         // Encoder API
         encode_symbol_tracker<
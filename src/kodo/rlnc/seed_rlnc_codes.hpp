@@ -7,3 +7,5 @@
 
 #include "seed_rlnc_encoder.hpp"
 #include "seed_rlnc_decoder.hpp"
+#include "fast_seed_rlnc_encoder.hpp"
+#include "fast_seed_rlnc_decoder.hpp"
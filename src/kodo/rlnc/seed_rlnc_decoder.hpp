@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "../const_payload_decoder.hpp"
+#include "../batch_payload_decoder.hpp"
 #include "../payload_decoder.hpp"
 #include "../systematic_decoder.hpp"
 #include "../symbol_id_decoder.hpp"
@@ -13,6 +15,7 @@
 #include "../coefficient_storage_layers.hpp"
 #include "../deep_storage_layers.hpp"
 #include "../finite_field_layers.hpp"
+#include "../uniform_generator.hpp"
 
 namespace kodo
 {
@@ -26,6 +29,8 @@ namespace kodo
     template<class Field, class TraceTag = kodo::disable_trace>
     class seed_rlnc_decoder : public
         // Payload API
+        const_payload_decoder<
+        batch_payload_decoder<
         payload_decoder<
         // Codec Header API
         systematic_decoder<
@@ -44,7 +49,7 @@ namespace kodo
         finite_field_layers<Field,
         // Final Layer
         final_layer
-        > > > > > > > > >
+        > > > > > > > > > > >
     {
     public:
         using factory = pool_factory<seed_rlnc_decoder>;
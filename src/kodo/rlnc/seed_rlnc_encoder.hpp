@@ -8,6 +8,8 @@
 #include "../final_layer.hpp"
 #include "../zero_symbol_encoder.hpp"
 #include "../default_on_systematic_encoder.hpp"
+#include "../gather_payload_encoder.hpp"
+#include "../batch_payload_encoder.hpp"
 #include "../payload_encoder.hpp"
 #include "../symbol_id_encoder.hpp"
 #include "../forward_linear_block_decoder.hpp"
@@ -17,6 +19,7 @@
 #include "../uniform_generator.hpp"
 #include "../storage_aware_encoder.hpp"
 #include "../encode_symbol_tracker.hpp"
+#include "../symbol_reference_encoder.hpp"
 #include "../linear_block_encoder.hpp"
 #include "../deep_storage_layers.hpp"
 #include "../finite_field_layers.hpp"
@@ -38,6 +41,8 @@ namespace kodo
     template<class Field, class TraceTag = kodo::disable_trace>
     class seed_rlnc_encoder : public
         // Payload Codec API
+        gather_payload_encoder<
+        batch_payload_encoder<
         payload_encoder<
         // Codec Header API
         default_on_systematic_encoder<
@@ -49,6 +54,7 @@ namespace kodo
         // Encoder API
         encode_symbol_tracker<
         zero_symbol_encoder<
+        symbol_reference_encoder<
         linear_block_encoder<
         storage_aware_encoder<
         // Coefficient Storage API
@@ -60,7 +66,7 @@ namespace kodo
         finite_field_layers<Field,
         // Final Layer
         final_layer
-        > > > > > > > > > > > > >
+        > > > > > > > > > > > > > > > >
     {
     public:
         using factory = pool_factory<seed_rlnc_encoder>;
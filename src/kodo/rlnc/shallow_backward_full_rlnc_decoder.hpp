@@ -8,6 +8,9 @@
 #include "../final_layer.hpp"
 #include "../systematic_decoder.hpp"
 #include "../payload_decoder.hpp"
+#include "../scatter_payload_decoder.hpp"
+#include "../const_payload_decoder.hpp"
+#include "../batch_payload_decoder.hpp"
 #include "../symbol_id_decoder.hpp"
 #include "../plain_symbol_id_reader.hpp"
 #include "../proxy_stack.hpp"
@@ -16,6 +19,7 @@
 #include "../coefficient_storage_layers.hpp"
 #include "../partial_mutable_shallow_storage_layers.hpp"
 #include "../finite_field_layers.hpp"
+#include "../const_symbol_decoder.hpp"
 #include "../backward_linear_block_decoder.hpp"
 
 #include "full_rlnc_recoding_stack.hpp"
@@ -36,13 +40,17 @@ namespace kodo
         // Payload API
         nested_payload_recoder<
         proxy_stack<proxy_args<>, full_rlnc_recoding_stack,
+        const_payload_decoder<
+        batch_payload_decoder<
         payload_decoder<
+        scatter_payload_decoder<
         // Codec Header API
         systematic_decoder<
         symbol_id_decoder<
         // Symbol ID API
         plain_symbol_id_reader<
         // Decoder API
+        const_symbol_decoder<
         aligned_coefficients_decoder<
         backward_linear_block_decoder<
         symbol_decoding_status_counter<
@@ -55,7 +63,7 @@ namespace kodo
         finite_field_layers<Field,
         // Final Layer
         final_layer
-        > > > > > > > > > > > > >
+        > > > > > > > > > > > > > > > > >
     {
     public:
         using factory = pool_factory<shallow_backward_full_rlnc_decoder>;
@@ -5,8 +5,12 @@
 
 #pragma once
 
+#include "../scatter_payload_decoder.hpp"
+#include "../const_payload_decoder.hpp"
+#include "../batch_payload_decoder.hpp"
 #include "../default_on_systematic_encoder.hpp"
 #include "../has_shallow_symbol_storage.hpp"
+#include "../const_symbol_decoder.hpp"
 #include "../linear_block_decoder_delayed.hpp"
 #include "../partial_shallow_symbol_storage.hpp"
 #include "../rlnc/full_rlnc_codes.hpp"
@@ -35,13 +39,17 @@ namespace kodo
         // Payload API
         nested_payload_recoder<
         proxy_stack<proxy_args<>, full_rlnc_recoding_stack,
+        const_payload_decoder<
+        batch_payload_decoder<
         payload_decoder<
+        scatter_payload_decoder<
         // Codec Header API
         systematic_decoder<
         symbol_id_decoder<
         // Symbol ID API
         plain_symbol_id_reader<
         // Decoder API
+        const_symbol_decoder<
         aligned_coefficients_decoder<
         linear_block_decoder_delayed<
         forward_linear_block_decoder<
@@ -55,7 +63,7 @@ namespace kodo
         finite_field_layers<Field,
         // Final Layer
         final_layer
-        > > > > > > > > > > > > > >
+        > > > > > > > > > > > > > > > > > >
     {
     public:
         using factory = basic_factory<shallow_delayed_full_rlnc_decoder>;
@@ -16,6 +16,9 @@
 #include "../nested_payload_recoder.hpp"
 #include "../proxy_stack.hpp"
 #include "../payload_decoder.hpp"
+#include "../scatter_payload_decoder.hpp"
+#include "../const_payload_decoder.hpp"
+#include "../batch_payload_decoder.hpp"
 #include "../systematic_decoder.hpp"
 #include "../symbol_id_decoder.hpp"
 #include "../plain_symbol_id_reader.hpp"
@@ -35,7 +38,10 @@ namespace kodo
         // Payload API
         nested_payload_recoder<
         proxy_stack<proxy_args<>, full_rlnc_recoding_stack,
+        const_payload_decoder<
+        batch_payload_decoder<
         payload_decoder<
+        scatter_payload_decoder<
         // Codec Header API
         systematic_decoder<
         symbol_id_decoder<
@@ -51,7 +57,7 @@ namespace kodo
         finite_field_layers<Field,
         // Final Layer
         final_layer
-        > > > > > > > > > >
+        > > > > > > > > > > > > >
     {
     public:
         using factory = pool_factory<shallow_full_rlnc_decoder>;
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "../gather_payload_encoder.hpp"
+#include "../batch_payload_encoder.hpp"
 #include "../default_on_systematic_encoder.hpp"
 #include "../has_shallow_symbol_storage.hpp"
 #include "../linear_block_decoder_delayed.hpp"
@@ -12,6 +14,7 @@
 #include "../shallow_symbol_storage.hpp"
 #include "../partial_const_shallow_storage_layers.hpp"
 #include "../finite_field_layers.hpp"
+#include "../fast_uniform_generator.hpp"
 
 namespace kodo
 {
@@ -24,6 +27,8 @@ namespace kodo
     template<class Field, class TraceTag = kodo::disable_trace>
     class shallow_full_rlnc_encoder : public
         // Payload Codec API
+        gather_payload_encoder<
+        batch_payload_encoder<
         payload_encoder<
         // Codec Header API
         default_on_systematic_encoder<
@@ -31,10 +36,11 @@ namespace kodo
         // Symbol ID API
         plain_symbol_id_writer<
         // Coefficient Generator API
-        uniform_generator<
+        fast_uniform_generator<
         // Encoder API
         encode_symbol_tracker<
         zero_symbol_encoder<
+        symbol_reference_encoder<
         linear_block_encoder<
         storage_aware_encoder<
         // Coefficient Storage API
@@ -46,7 +52,7 @@ namespace kodo
         finite_field_layers<Field,
         // Final Layer
         final_layer
-        > > > > > > > > > > > > >
+        > > > > > > > > > > > > > > > >
     {
     public:
         using factory = pool_factory<shallow_full_rlnc_encoder>;
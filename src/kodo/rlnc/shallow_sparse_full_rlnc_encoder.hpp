@@ -5,9 +5,11 @@
 
 #pragma once
 
+#include "../gather_payload_encoder.hpp"
+#include "../batch_payload_encoder.hpp"
 #include "../default_on_systematic_encoder.hpp"
 #include "../partial_const_shallow_storage_layers.hpp"
-#include "../sparse_uniform_generator.hpp"
+#include "../fast_sparse_uniform_generator.hpp"
 #include "../finite_field_layers.hpp"
 
 namespace kodo
@@ -25,6 +27,8 @@ namespace kodo
     template<class Field, class TraceTag = kodo::disable_trace>
     class shallow_sparse_full_rlnc_encoder : public
         // Payload Codec API
+        gather_payload_encoder<
+        batch_payload_encoder<
         payload_encoder<
         // Codec Header API
         default_on_systematic_encoder<
@@ -32,10 +36,11 @@ namespace kodo
         // Symbol ID API
         plain_symbol_id_writer<
         // Coefficient Generator API
-        sparse_uniform_generator<
+        fast_sparse_uniform_generator<
         // Encoder API
         encode_symbol_tracker<
         zero_symbol_encoder<
+        symbol_reference_encoder<
         linear_block_encoder<
         storage_aware_encoder<
         // Coefficient Storage API
@@ -47,7 +52,7 @@ namespace kodo
         finite_field_layers<Field,
         // Final Layer
         final_layer
-        > > > > > > > > > > > > >
+        > > > > > > > > > > > > > > > >
     {
     public:
         using factory = pool_factory<shallow_sparse_full_rlnc_encoder>;
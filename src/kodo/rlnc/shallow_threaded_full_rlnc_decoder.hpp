@@ -0,0 +1,52 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "../threaded_finite_field_math.hpp"
+
+#include "shallow_full_rlnc_decoder.hpp"
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    ///
+    /// @brief Complete stack implementing a shallow storage RLNC decoder
+    ///        which splits the symbol operations across threads.
+    ///
+    /// The decoder is identical to the shallow_full_rlnc_decoder
+    /// except for the fact that it uses the threaded finite field
+    /// layers. The number of threads is set on the factory using
+    /// set_threads(). This is only beneficial for large symbols.
+    template<class Field, class TraceTag = kodo::disable_trace>
+    class shallow_threaded_full_rlnc_decoder : public
+        // Payload API
+        nested_payload_recoder<
+        proxy_stack<proxy_args<>, full_rlnc_recoding_stack,
+        const_payload_decoder<
+        batch_payload_decoder<
+        payload_decoder<
+        scatter_payload_decoder<
+        // Codec Header API
+        systematic_decoder<
+        symbol_id_decoder<
+        // Symbol ID API
+        plain_symbol_id_reader<
+        // Decoder API
+        common_decoder_layers<TraceTag,
+        // Coefficient Storage API
+        coefficient_storage_layers<
+        // Storage API
+        partial_mutable_shallow_storage_layers<TraceTag,
+        // Finite Field API
+        threaded_finite_field_layers<Field,
+        // Final Layer
+        final_layer
+        > > > > > > > > > > > > >
+    {
+    public:
+        using factory = pool_factory<shallow_threaded_full_rlnc_decoder>;
+    };
+}
@@ -0,0 +1,57 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "../threaded_finite_field_math.hpp"
+
+#include "full_rlnc_encoder.hpp"
+#include "shallow_full_rlnc_encoder.hpp"
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    ///
+    /// @brief Complete stack implementing a shallow storage RLNC encoder
+    ///        which splits the symbol operations across threads.
+    ///
+    /// The encoder is identical to the shallow_full_rlnc_encoder
+    /// except for the fact that it uses the threaded finite field
+    /// layers. The number of threads is set on the factory using
+    /// set_threads(). This is only beneficial for large symbols.
+    template<class Field, class TraceTag = kodo::disable_trace>
+    class shallow_threaded_full_rlnc_encoder : public
+        // Payload Codec API
+        gather_payload_encoder<
+        batch_payload_encoder<
+        payload_encoder<
+        // Codec Header API
+        default_on_systematic_encoder<
+        symbol_id_encoder<
+        // Symbol ID API
+        plain_symbol_id_writer<
+        // Coefficient Generator API
+        fast_uniform_generator<
+        // Encoder API
+        encode_symbol_tracker<
+        zero_symbol_encoder<
+        symbol_reference_encoder<
+        linear_block_encoder<
+        storage_aware_encoder<
+        // Coefficient Storage API
+        coefficient_value_access<
+        coefficient_info<
+        // Symbol Storage API
+        partial_const_shallow_storage_layers<TraceTag,
+         // Finite Field API
+        threaded_finite_field_layers<Field,
+        // Final Layer
+        final_layer
+        > > > > > > > > > > > > > > > >
+    {
+    public:
+        using factory = pool_factory<shallow_threaded_full_rlnc_encoder>;
+    };
+}
@@ -8,7 +8,7 @@
 #include <cstdint>
 
 #include "../check_partial_generator.hpp"
-#include "../uniform_generator.hpp"
+#include "../fast_uniform_generator.hpp"
 #include "../pivot_aware_generator.hpp"
 #include "../remote_pivot_aware_generator.hpp"
 
@@ -25,7 +25,7 @@ namespace kodo
     template<class SuperCoder>
     using sliding_window_generator =
         check_partial_generator<
-        uniform_generator<
+        fast_uniform_generator<
         remote_pivot_aware_generator<
         pivot_aware_generator<
         SuperCoder> > > >;
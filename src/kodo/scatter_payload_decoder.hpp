@@ -0,0 +1,93 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace kodo
+{
+    /// @ingroup payload_codec_layers
+    ///
+    /// @brief Decodes payloads received with scatter-gather I/O such
+    ///        as recvmsg(), where the symbol data and the header are
+    ///        in separate buffers.
+    ///
+    /// The symbol data of the next packet can be received directly
+    /// into the decoder storage returned by layer::receive_buffer().
+    /// With mutable shallow storage this is the memory of the user,
+    /// and since the storage does not copy a symbol onto itself an
+    /// uncoded symbol arriving in its own place is decoded without
+    /// any copy. The layer should be placed below the payload_decoder,
+    /// which hides layer::decode(uint8_t*, uint8_t*).
+    ///
+    /// The systematic symbols are expected in order, so the buffer
+    /// returned is the storage of the symbol following the last
+    /// uncoded symbol received, if that symbol is missing. After a
+    /// loss the following systematic symbols therefore still arrive in
+    /// place. Otherwise, e.g. once the systematic symbols have been
+    /// sent, the storage of the first missing symbol is returned.
+    template<class SuperCoder>
+    class scatter_payload_decoder : public SuperCoder
+    {
+    public:
+
+        /// Constructor
+        scatter_payload_decoder()
+            : m_next_systematic(0)
+        { }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+            m_next_systematic = 0;
+        }
+
+        /// @copydoc layer::receive_buffer()
+        uint8_t* receive_buffer()
+        {
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t index = m_next_systematic;
+
+            if(index == symbols || !SuperCoder::is_symbol_missing(index))
+            {
+                index = SuperCoder::next_symbol_missing(0);
+            }
+
+            if(index == symbols)
+                return 0;
+
+            return SuperCoder::symbol(index);
+        }
+
+        /// @copydoc layer::decode_scatter(uint8_t*, uint8_t*)
+        void decode_scatter(uint8_t *symbol_data, uint8_t *header)
+        {
+            assert(symbol_data != 0);
+            assert(header != 0);
+
+            SuperCoder::decode(symbol_data, header);
+
+            // The symbols before the expected one have been received
+            // or are lost, so an uncoded symbol from the expected one
+            // on is the one just received
+            uint32_t index = SuperCoder::next_symbol_uncoded(
+                m_next_systematic);
+
+            if(index < SuperCoder::symbols())
+            {
+                m_next_systematic = index + 1;
+            }
+        }
+
+    private:
+
+        /// The index of the next systematic symbol expected
+        uint32_t m_next_systematic;
+    };
+}
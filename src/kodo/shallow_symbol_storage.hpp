@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <vector>
 
@@ -20,6 +22,8 @@ namespace kodo
     /// This is useful in cases where data to
     /// be encoded already has been read into memory or if a user requires
     /// incoming data to be directly decoded into a specific buffer.
+    ///
+    /// The pointers to the symbols are kept in the arena of the coder.
     template<bool IsConst, class SuperCoder>
     class shallow_symbol_storage : public SuperCoder
     {
@@ -49,13 +53,50 @@ namespace kodo
 
     public:
 
+        /// @ingroup factory_base_layers
+        /// @brief Adds the symbol pointers to the arena of a coder
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(
+                        SuperCoder::factory_base::max_symbols() *
+                        sizeof(data_ptr));
+            }
+        };
+
+    public:
+
+        /// Constructor
+        shallow_symbol_storage()
+            : m_data(0),
+              m_max_symbols(0),
+              m_symbols_count(0),
+              m_dirty_symbols(0)
+        { }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
         {
             SuperCoder::construct(the_factory);
 
-            m_data.resize(the_factory.max_symbols(), 0);
+            m_max_symbols = the_factory.max_symbols();
+
+            // The arena is cleared when it is allocated
+            m_data = reinterpret_cast<data_ptr*>(
+                SuperCoder::arena_allocate(m_max_symbols * sizeof(data_ptr)));
+
+            m_dirty_symbols = 0;
         }
 
         /// @copydoc layer::initialize(uint32_t,uint32_t)
@@ -64,8 +105,12 @@ namespace kodo
         {
             SuperCoder::initialize(the_factory);
 
-            std::fill(m_data.begin(), m_data.end(), (data_ptr) 0);
+            // Only the symbols of the previous block can have been set
+            std::fill_n(m_data, m_dirty_symbols, (data_ptr) 0);
             m_symbols_count = 0;
+
+            m_dirty_symbols = the_factory.symbols();
+            assert(m_dirty_symbols <= m_max_symbols);
         }
 
         /// @copydoc layer::symbol(uint32_t) const
@@ -88,8 +133,13 @@ namespace kodo
         /// @copydoc layer::swap_symbols(std::vector<data_ptr>&)
         void swap_symbols(std::vector<data_ptr> &symbols)
         {
-            assert(m_data.size() == symbols.size());
-            m_data.swap(symbols);
+            // The pointers are in the arena, so the content of the
+            // two is exchanged
+            assert(m_max_symbols == symbols.size());
+            std::swap_ranges(symbols.begin(), symbols.end(), m_data);
+
+            // Any of the pointers may have been set by the user
+            m_dirty_symbols = m_max_symbols;
 
             m_symbols_count = 0;
 
@@ -222,11 +272,18 @@ namespace kodo
 
     protected:
 
-        /// Symbol mapping
-        std::vector<data_ptr> m_data;
+        /// Symbol mapping, max_symbols() pointers in the arena
+        data_ptr* m_data;
+
+        /// The number of pointers in m_data
+        uint32_t m_max_symbols;
 
         /// Symbols count
         uint32_t m_symbols_count;
 
+        /// The number of pointers at the start of m_data which may be
+        /// set
+        uint32_t m_dirty_symbols;
+
     };
 }
@@ -0,0 +1,62 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace kodo
+{
+    /// @ingroup symbol_storage_layers
+    ///
+    /// @brief Selects the allocator used by the storage layers.
+    ///
+    /// The final_layer allocates the arena holding the buffers of a
+    /// coder, e.g. the symbol and coefficient storage, with the
+    /// layer::allocator_type of the factory, which is
+    /// std::allocator<uint8_t> unless this layer is used. The layer
+    /// is placed directly above the final_layer, e.g. to back the
+    /// buffers of a stack with huge pages:
+    ///
+    ///     storage_allocator<huge_page_allocator<uint8_t>,
+    ///     final_layer>
+    ///
+    /// The buffers are allocated when a codec is constructed, so
+    /// with the numa_local_allocator a codec built by a factory on a
+    /// worker thread allocates on the node of that thread.
+    template<class Allocator, class SuperCoder>
+    class storage_allocator : public SuperCoder
+    {
+    public:
+
+        static_assert(std::is_same<
+                          typename Allocator::value_type, uint8_t>::value,
+                      "The storage allocator must allocate uint8_t");
+
+        /// @copydoc layer::allocator_type
+        typedef Allocator allocator_type;
+
+    public:
+
+        /// @ingroup factory_base_layers
+        /// @brief Provides the allocator used for the arena of the
+        ///        coders built by the factory
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::allocator_type
+            typedef Allocator allocator_type;
+
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+        };
+    };
+}
@@ -5,8 +5,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
-#include <boost/dynamic_bitset.hpp>
 
 namespace kodo
 {
@@ -18,7 +19,8 @@ namespace kodo
     /// should be a uncoded systematic symbol. This is done by
     /// tracking which symbols has already been sent systematically
     /// and which symbols are currently available in the storage
-    /// layers
+    /// layers. The symbols sent are tracked in a bitset in the arena
+    /// of the coder.
     template<class SuperCoder>
     class storage_aware_systematic_phase : public SuperCoder
     {
@@ -27,15 +29,58 @@ namespace kodo
         /// Make the encode_symbol overloads available
         using SuperCoder::encode_symbol;
 
+        /// The word type of the bitset
+        typedef uint64_t word_type;
+
+        /// The number of symbols tracked per word
+        static const uint32_t word_bits = 64;
+
     public:
 
+        /// @ingroup factory_base_layers
+        /// @brief Adds the bitset to the arena of a coder
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                uint32_t words = (SuperCoder::factory_base::max_symbols() +
+                                  word_bits - 1) / word_bits;
+
+                return SuperCoder::factory_base::arena_size() +
+                    SuperCoder::factory_base::arena_region_size(
+                        words * sizeof(word_type));
+            }
+        };
+
+    public:
+
+        /// Constructor
+        storage_aware_systematic_phase()
+            : m_offset(0),
+              m_systematic_count(0),
+              m_systematic_symbols_sent(0),
+              m_symbols(0)
+        { }
+
         /// @copdydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory& the_factory)
         {
             SuperCoder::construct(the_factory);
 
-            m_systematic_symbols_sent.resize(the_factory.max_symbols(), false);
+            uint32_t words =
+                (the_factory.max_symbols() + word_bits - 1) / word_bits;
+
+            m_systematic_symbols_sent = reinterpret_cast<word_type*>(
+                SuperCoder::arena_allocate(words * sizeof(word_type)));
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -46,13 +91,17 @@ namespace kodo
 
             m_offset = 0;
             m_systematic_count = 0;
-            m_systematic_symbols_sent.reset();
+
+            // Only the bits of the symbols in this block are cleared
+            m_symbols = the_factory.symbols();
+            std::fill_n(m_systematic_symbols_sent,
+                        (m_symbols + word_bits - 1) / word_bits, 0);
         }
 
         /// @copydoc layer::encode_symbol(uint8_t*,uint32_t)
         void encode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
         {
-            assert(symbol_index < m_systematic_symbols_sent.size());
+            assert(symbol_index < m_symbols);
 
             SuperCoder::encode_symbol(symbol_data, symbol_index);
 
@@ -81,7 +130,7 @@ namespace kodo
             // Find which symbol should be the next to send systematically
             for(uint32_t i = m_offset; i < SuperCoder::symbols(); ++i)
             {
-                bool is_not_sent = !m_systematic_symbols_sent.test(i);
+                bool is_not_sent = !is_systematic_sent(i);
                 bool is_uncoded = SuperCoder::is_symbol_uncoded(i);
 
                 if(is_not_sent && is_uncoded)
@@ -112,18 +161,19 @@ namespace kodo
         void update_systematic_state(uint32_t symbol_index)
         {
             assert(symbol_index < SuperCoder::symbols());
-            assert(symbol_index < m_systematic_symbols_sent.size());
+            assert(symbol_index < m_symbols);
 
             // If we have an one bit the symbol has been sent as systematic
             // before so:
             // 1) If the symbol has not been sent before is_not_sent will be 1
             // 2) If the symbol has been sent before is_not_sent will be 0
-            bool is_not_sent = !m_systematic_symbols_sent.test(symbol_index);
+            bool is_not_sent = !is_systematic_sent(symbol_index);
 
             // Increment the count if the symbol was not previously sent
             m_systematic_count += is_not_sent;
 
-            m_systematic_symbols_sent.set(symbol_index);
+            m_systematic_symbols_sent[symbol_index / word_bits] |=
+                word_type(1) << (symbol_index % word_bits);
 
             // Update the offset when we can confirm that we have
             // systematically sent all symbols with a lower or equal
@@ -131,7 +181,7 @@ namespace kodo
             for(uint32_t i = m_offset; i <= symbol_index; ++i)
             {
 
-                bool is_sent = m_systematic_symbols_sent.test(i);
+                bool is_sent = is_systematic_sent(i);
                 bool is_uncoded = SuperCoder::is_symbol_uncoded(i);
 
                 if(is_sent && is_uncoded)
@@ -146,6 +196,16 @@ namespace kodo
 
         }
 
+        /// @param index The index of a symbol
+        /// @return true if the symbol has been sent systematically
+        bool is_systematic_sent(uint32_t index) const
+        {
+            assert(index < m_symbols);
+
+            return (m_systematic_symbols_sent[index / word_bits] >>
+                    (index % word_bits)) & 1;
+        }
+
     protected:
 
         /// When searching for the next symbol to send systematically
@@ -160,8 +220,11 @@ namespace kodo
         uint32_t m_systematic_count;
 
         /// Bitset which keeps track of the symbols that have been sent
-        /// systematic
-        boost::dynamic_bitset<uint8_t> m_systematic_symbols_sent;
+        /// systematic, in the arena
+        word_type* m_systematic_symbols_sent;
+
+        /// The number of symbols tracked in the bitset
+        uint32_t m_symbols;
 
     };
 
@@ -32,7 +32,9 @@ namespace kodo
                   m_max_symbols(max_symbols),
                   m_max_symbol_size(max_symbol_size),
                   m_symbols(max_symbols),
-                  m_symbol_size(max_symbol_size)
+                  m_symbol_size(max_symbol_size),
+                  m_size_class_symbols(max_symbols),
+                  m_size_class_symbol_size(max_symbol_size)
             {
                 assert(m_max_symbols > 0);
                 assert(m_max_symbol_size > 0);
@@ -43,19 +45,19 @@ namespace kodo
             /// @copydoc layer::factory_base::max_symbols() const
             uint32_t max_symbols() const
             {
-                return m_max_symbols;
+                return m_size_class_symbols;
             }
 
             /// @copydoc layer::factory_base::max_symbol_size() const
             uint32_t max_symbol_size() const
             {
-                return m_max_symbol_size;
+                return m_size_class_symbol_size;
             }
 
             /// @copydoc layer::factory_base::max_block_size() const
             uint32_t max_block_size() const
             {
-                return m_max_symbols*m_max_symbol_size;
+                return m_size_class_symbols*m_size_class_symbol_size;
             }
 
             /// @copydoc layer::factory_base::symbols() const;
@@ -88,6 +90,18 @@ namespace kodo
                 m_symbol_size = symbol_size;
             }
 
+            /// @copydoc layer::factory_base::set_size_class(uint32_t,uint32_t)
+            void set_size_class(uint32_t symbols, uint32_t symbol_size)
+            {
+                assert(symbols >= m_symbols);
+                assert(symbols <= m_max_symbols);
+                assert(symbol_size >= m_symbol_size);
+                assert(symbol_size <= m_max_symbol_size);
+
+                m_size_class_symbols = symbols;
+                m_size_class_symbol_size = symbol_size;
+            }
+
         private:
 
             /// The maximum number of symbols
@@ -102,6 +116,12 @@ namespace kodo
             /// The symbol size used
             uint32_t m_symbol_size;
 
+            /// The number of symbols reported as the maximum
+            uint32_t m_size_class_symbols;
+
+            /// The symbol size reported as the maximum
+            uint32_t m_size_class_symbol_size;
+
         };
 
     public:
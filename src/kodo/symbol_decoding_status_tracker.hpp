@@ -5,10 +5,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
-#include <vector>
+
+#include "bit_scan.hpp"
 
 namespace kodo
 {
@@ -16,39 +18,76 @@ namespace kodo
     /// @ingroup decoder_api
     /// @brief The symbol decoding status tracker stores information about
     ///        the status of the different symbols contained within a decoder.
+    ///
+    /// The status is stored in two bitsets, one marking the "seen"
+    /// and one marking the "uncoded" symbols, a symbol in neither is
+    /// "missing". Besides the status of a single symbol, the tracker
+    /// can find the next symbol with a given status by scanning 64
+    /// symbols at a time, which lets the decoders skip long runs of
+    /// symbols they have no work for. The bitsets are allocated in the
+    /// arena of the coder, so when the layer is placed above the
+    /// coefficient storage they directly follow the coefficient
+    /// vectors.
     template<class SuperCoder>
     class symbol_decoding_status_tracker : public SuperCoder
     {
     public:
 
-        /// Defines the status that a symbol in a decoder can have.
-        enum class symbol_decoding_status
+        /// The word type of the bitsets
+        typedef uint64_t word_type;
+
+        /// The number of symbols tracked per word
+        static const uint32_t word_bits = 64;
+
+    public:
+
+        /// @ingroup factory_base_layers
+        /// @brief Adds the bitsets to the arena of a coder
+        class factory_base : public SuperCoder::factory_base
         {
-            /// missing means that the symbol has not yet been
-            /// received by the decoder.
-            missing,
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
 
-            /// seen means that the symbol has been received, but has
-            /// not yet been fully decoded. The use of the term "seen"
-            /// is common in network coding literature when referring
-            /// to partially decoded packets.
-            seen,
+            /// @copydoc layer::factory_base::arena_size() const
+            uint32_t arena_size() const
+            {
+                uint32_t words = (SuperCoder::factory_base::max_symbols() +
+                                  word_bits - 1) / word_bits;
 
-            /// uncoded means that the symbol has been received and
-            /// fully decoded.
-            uncoded
+                return SuperCoder::factory_base::arena_size() +
+                    2 * SuperCoder::factory_base::arena_region_size(
+                        words * sizeof(word_type));
+            }
         };
 
     public:
 
+        /// Constructor
+        symbol_decoding_status_tracker()
+            : m_seen(0),
+              m_uncoded(0),
+              m_words(0)
+        { }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
         {
             SuperCoder::construct(the_factory);
 
-            m_status.resize(the_factory.max_symbols(),
-                            symbol_decoding_status::missing);
+            m_words =
+                (the_factory.max_symbols() + word_bits - 1) / word_bits;
+
+            // The arena is cleared when it is allocated
+            m_seen = reinterpret_cast<word_type*>(
+                SuperCoder::arena_allocate(m_words * sizeof(word_type)));
+
+            m_uncoded = reinterpret_cast<word_type*>(
+                SuperCoder::arena_allocate(m_words * sizeof(word_type)));
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -57,56 +96,183 @@ namespace kodo
         {
             SuperCoder::initialize(the_factory);
 
-            std::fill_n(m_status.begin(), the_factory.symbols(),
-                        symbol_decoding_status::missing);
+            uint32_t words =
+                (the_factory.symbols() + word_bits - 1) / word_bits;
+
+            assert(words <= m_words);
+
+            std::fill_n(m_seen, words, 0);
+            std::fill_n(m_uncoded, words, 0);
         }
 
         /// @copydoc layer::set_symbol_missing(uint32_t)
         void set_symbol_missing(uint32_t index)
         {
-            assert(index < m_status.size());
-            m_status[index] = symbol_decoding_status::missing;
+            assert(index < SuperCoder::symbols());
+
+            m_seen[word(index)] &= ~mask(index);
+            m_uncoded[word(index)] &= ~mask(index);
         }
 
         /// @copydoc layer::set_symbol_seen(uint32_t)
         void set_symbol_seen(uint32_t index)
         {
-            assert(index < m_status.size());
-            m_status[index] = symbol_decoding_status::seen;
+            assert(index < SuperCoder::symbols());
+
+            m_seen[word(index)] |= mask(index);
+            m_uncoded[word(index)] &= ~mask(index);
         }
 
         /// @copydoc layer::set_symbol_uncoded(uint32_t)
         void set_symbol_uncoded(uint32_t index)
         {
-            assert(index < m_status.size());
-            m_status[index] = symbol_decoding_status::uncoded;
+            assert(index < SuperCoder::symbols());
+
+            m_seen[word(index)] &= ~mask(index);
+            m_uncoded[word(index)] |= mask(index);
         }
 
         /// @copydoc layer::is_symbol_missing(uint32_t) const
         bool is_symbol_missing(uint32_t index) const
         {
-            assert(index < m_status.size());
-            return m_status[index] == symbol_decoding_status::missing;
+            assert(index < SuperCoder::symbols());
+            return ((m_seen[word(index)] | m_uncoded[word(index)]) &
+                    mask(index)) == 0;
         }
 
         /// @copydoc layer::is_symbol_seen(uint32_t) const
         bool is_symbol_seen(uint32_t index) const
         {
-            assert(index < m_status.size());
-            return m_status[index] == symbol_decoding_status::seen;
+            assert(index < SuperCoder::symbols());
+            return (m_seen[word(index)] & mask(index)) != 0;
         }
 
         /// @copydoc layer::is_symbol_uncoded(uint32_t) const
         bool is_symbol_uncoded(uint32_t index) const
         {
-            assert(index < m_status.size());
-            return m_status[index] == symbol_decoding_status::uncoded;
+            assert(index < SuperCoder::symbols());
+            return (m_uncoded[word(index)] & mask(index)) != 0;
         }
 
-    public:
+        /// @copydoc layer::next_symbol_missing(uint32_t) const
+        uint32_t next_symbol_missing(uint32_t index) const
+        {
+            return scan_forward(index, [this](uint32_t w)
+                { return ~(m_seen[w] | m_uncoded[w]); });
+        }
+
+        /// @copydoc layer::next_symbol_seen(uint32_t) const
+        uint32_t next_symbol_seen(uint32_t index) const
+        {
+            return scan_forward(index, [this](uint32_t w)
+                { return m_seen[w]; });
+        }
+
+        /// @copydoc layer::next_symbol_uncoded(uint32_t) const
+        uint32_t next_symbol_uncoded(uint32_t index) const
+        {
+            return scan_forward(index, [this](uint32_t w)
+                { return m_uncoded[w]; });
+        }
+
+        /// @copydoc layer::next_symbol_pivot(uint32_t) const
+        uint32_t next_symbol_pivot(uint32_t index) const
+        {
+            return scan_forward(index, [this](uint32_t w)
+                { return m_seen[w] | m_uncoded[w]; });
+        }
+
+        /// @copydoc layer::previous_symbol_pivot(uint32_t) const
+        uint32_t previous_symbol_pivot(uint32_t index) const
+        {
+            return scan_backward(index, [this](uint32_t w)
+                { return m_seen[w] | m_uncoded[w]; });
+        }
+
+    private:
+
+        /// @param index The index of a symbol
+        /// @return The index of the word holding the symbol
+        static uint32_t word(uint32_t index)
+        {
+            return index / word_bits;
+        }
+
+        /// @param index The index of a symbol
+        /// @return The mask selecting the symbol within its word
+        static word_type mask(uint32_t index)
+        {
+            return word_type(1) << (index % word_bits);
+        }
+
+        /// Finds the first set bit at or after an index
+        /// @param index The index to start from
+        /// @param bits Function returning the bits of a word
+        /// @return The index of the bit found or symbols() if none
+        template<class Bits>
+        uint32_t scan_forward(uint32_t index, const Bits& bits) const
+        {
+            uint32_t symbols = SuperCoder::symbols();
+
+            if(index >= symbols)
+                return symbols;
+
+            uint32_t w = word(index);
+            uint32_t words = word(symbols - 1) + 1;
+
+            // Clear the bits below the index in the first word
+            word_type current =
+                bits(w) & (~word_type(0) << (index % word_bits));
+
+            while(current == 0)
+            {
+                if(++w == words)
+                    return symbols;
+
+                current = bits(w);
+            }
+
+            uint32_t found = w * word_bits + count_trailing_zeros(current);
+            return std::min(found, symbols);
+        }
+
+        /// Finds the last set bit at or before an index
+        /// @param index The index to start from
+        /// @param bits Function returning the bits of a word
+        /// @return The index of the bit found or symbols() if none
+        template<class Bits>
+        uint32_t scan_backward(uint32_t index, const Bits& bits) const
+        {
+            uint32_t symbols = SuperCoder::symbols();
+            assert(index < symbols);
+
+            uint32_t w = word(index);
+
+            // Clear the bits above the index in the first word
+            uint32_t shift = word_bits - 1 - (index % word_bits);
+            word_type current = bits(w) & (~word_type(0) >> shift);
+
+            while(current == 0)
+            {
+                if(w == 0)
+                    return symbols;
+
+                current = bits(--w);
+            }
+
+            return w * word_bits + highest_set_bit(current);
+        }
+
+    private:
+
+        /// Marks the symbols which are "seen"
+        word_type* m_seen;
+
+        /// Marks the symbols which are "uncoded"
+        word_type* m_uncoded;
 
-        /// Tracks whether a symbol is still partially decoded
-        std::vector<symbol_decoding_status> m_status;
+        /// The number of words in each bitset
+        uint32_t m_words;
 
     };
 
@@ -0,0 +1,96 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace kodo
+{
+    /// @ingroup encoder_layers
+    ///
+    /// @brief Hands out a pointer to the stored source symbol instead
+    ///        of copying it for uncoded symbols.
+    ///
+    /// Between layer::begin_symbol_reference() and
+    /// layer::end_symbol_reference() a call to
+    /// layer::encode_symbol(uint8_t*, uint32_t) only remembers the
+    /// requested source symbol and leaves the symbol data buffer
+    /// untouched. Coded symbols are produced as usual. The layer
+    /// should be placed directly above the layer copying the uncoded
+    /// symbols, e.g. the linear_block_encoder or the nocode_encoder.
+    template<class SuperCoder>
+    class symbol_reference_encoder : public SuperCoder
+    {
+    public:
+
+        /// Constructor
+        symbol_reference_encoder()
+            : m_referencing(false),
+              m_reference(0)
+        { }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            m_referencing = false;
+            m_reference = 0;
+        }
+
+        /// @copydoc layer::begin_symbol_reference()
+        void begin_symbol_reference()
+        {
+            assert(!m_referencing);
+
+            m_referencing = true;
+            m_reference = 0;
+        }
+
+        /// @copydoc layer::end_symbol_reference()
+        const uint8_t* end_symbol_reference()
+        {
+            assert(m_referencing);
+
+            m_referencing = false;
+            return m_reference;
+        }
+
+        /// @copydoc layer::encode_symbol(uint8_t*, uint8_t*)
+        void encode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            SuperCoder::encode_symbol(symbol_data, coefficients);
+        }
+
+        /// @copydoc layer::encode_symbol(uint8_t*,uint32_t)
+        void encode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            if(!m_referencing)
+            {
+                SuperCoder::encode_symbol(symbol_data, symbol_index);
+                return;
+            }
+
+            assert(symbol_data != 0);
+            assert(symbol_index < SuperCoder::symbols());
+
+            m_reference = SuperCoder::symbol(symbol_index);
+            assert(m_reference != 0);
+        }
+
+    private:
+
+        /// True between begin_symbol_reference() and
+        /// end_symbol_reference()
+        bool m_referencing;
+
+        /// The source symbol referenced instead of being copied
+        const uint8_t* m_reference;
+
+    };
+}
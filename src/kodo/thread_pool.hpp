@@ -0,0 +1,220 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace kodo
+{
+
+    /// @brief A fixed size pool of persistent worker threads.
+    ///
+    /// The pool runs one job at a time. A job consists of a number of
+    /// independent tasks identified by their index, which are shared
+    /// between the workers and the thread calling run(). The call
+    /// returns once all the tasks have completed.
+    class thread_pool : boost::noncopyable
+    {
+    public:
+
+        /// The function invoked for every task of a job
+        typedef std::function<void (uint32_t)> task_function;
+
+    public:
+
+        /// Creates the pool and starts the workers
+        /// @param threads The number of threads running the tasks
+        ///        including the thread calling run()
+        explicit thread_pool(uint32_t threads)
+            : m_threads(threads),
+              m_generation(0),
+              m_stop(false)
+        {
+            assert(threads > 0);
+
+            for(uint32_t i = 1; i < threads; ++i)
+            {
+                m_workers.emplace_back(&thread_pool::worker, this);
+            }
+        }
+
+        /// Stops and joins the workers
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+
+            m_wake.notify_all();
+
+            for(auto& worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+
+        /// @return The number of threads running the tasks including
+        ///         the thread calling run()
+        uint32_t threads() const
+        {
+            return m_threads;
+        }
+
+        /// Runs the tasks 0 to tasks - 1 and waits for them to
+        /// complete. Jobs from different threads are run one at a time.
+        /// @param tasks The number of tasks in the job
+        /// @param task The function invoked with the index of each task
+        void run(uint32_t tasks, const task_function& task)
+        {
+            std::lock_guard<std::mutex> run_lock(m_run_mutex);
+
+            if(tasks <= 1 || m_workers.empty())
+            {
+                for(uint32_t i = 0; i < tasks; ++i)
+                    task(i);
+
+                return;
+            }
+
+            auto current = std::make_shared<job>(tasks, task);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_job = current;
+                ++m_generation;
+            }
+
+            m_wake.notify_all();
+
+            // The calling thread helps out instead of idling
+            execute(*current);
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [&current]() { return current->m_pending == 0; });
+
+            m_job.reset();
+        }
+
+    private:
+
+        /// The state of a job shared between the threads. A worker
+        /// which wakes up late only sees the exhausted counters of the
+        /// job it was woken for.
+        struct job
+        {
+            /// Constructor
+            /// @param tasks The number of tasks
+            /// @param task The task function
+            job(uint32_t tasks, const task_function& task)
+                : m_tasks(tasks),
+                  m_task(task),
+                  m_next(0),
+                  m_pending(tasks)
+            { }
+
+            /// The number of tasks
+            const uint32_t m_tasks;
+
+            /// The task function, owned by the caller of run()
+            const task_function& m_task;
+
+            /// The index of the next task to run
+            std::atomic<uint32_t> m_next;
+
+            /// The number of tasks not yet completed
+            std::atomic<uint32_t> m_pending;
+        };
+
+        /// Runs tasks of the job until none are left
+        /// @param current The job to run
+        void execute(job& current)
+        {
+            while(true)
+            {
+                uint32_t index = current.m_next.fetch_add(1);
+
+                if(index >= current.m_tasks)
+                    return;
+
+                current.m_task(index);
+
+                if(current.m_pending.fetch_sub(1) == 1)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_done.notify_all();
+                }
+            }
+        }
+
+        /// The loop run by each worker thread
+        void worker()
+        {
+            uint64_t generation = 0;
+
+            while(true)
+            {
+                std::shared_ptr<job> current;
+
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+
+                    m_wake.wait(lock, [this, &generation]()
+                        { return m_stop || m_generation != generation; });
+
+                    if(m_stop)
+                        return;
+
+                    generation = m_generation;
+                    current = m_job;
+                }
+
+                if(current)
+                    execute(*current);
+            }
+        }
+
+    private:
+
+        /// The number of threads including the caller of run()
+        uint32_t m_threads;
+
+        /// The worker threads
+        std::vector<std::thread> m_workers;
+
+        /// Serializes calls to run()
+        std::mutex m_run_mutex;
+
+        /// Protects the job and the generation
+        std::mutex m_mutex;
+
+        /// Signals the workers that a new job is available
+        std::condition_variable m_wake;
+
+        /// Signals the caller of run() that the job has completed
+        std::condition_variable m_done;
+
+        /// The current job
+        std::shared_ptr<job> m_job;
+
+        /// Incremented for every job so the workers can tell them apart
+        uint64_t m_generation;
+
+        /// Tells the workers to exit
+        bool m_stop;
+    };
+
+}
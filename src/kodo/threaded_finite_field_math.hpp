@@ -0,0 +1,395 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <fifi/default_field.hpp>
+
+#include "finite_field_info.hpp"
+#include "finite_field_math.hpp"
+#include "thread_pool.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup finite_field_layers
+    /// @brief Splits the region operations of the finite field API
+    ///        across a pool of worker threads.
+    ///
+    /// Every region operation works element-wise, so a large symbol
+    /// can be split into byte ranges which are processed in parallel.
+    /// Operations shorter than two minimum task sizes, e.g. the
+    /// operations on the coefficient vectors, stay on the calling
+    /// thread. The factory owns the thread pool, which is shared by
+    /// all the coders built by it. With the default of one thread no
+    /// threads are started and all operations are passed directly to
+    /// the layer below.
+    ///
+    /// The layer must be placed directly above the finite_field_math
+    /// layer, since the layers below it are called from the worker
+    /// threads (e.g. a finite_field_counter must be placed above it).
+    ///
+    /// run_symbol_ranges() runs a function for the ranges of a symbol
+    /// on the worker threads. The region operations called from the
+    /// ranges run directly on the thread of the range.
+    template<class SuperCoder>
+    class threaded_finite_field_math : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// The minimum number of bytes processed by one task
+        static const uint32_t min_task_size = 16384;
+
+        /// The task boundaries are aligned to this number of bytes to
+        /// avoid two threads writing the same cache line
+        static const uint32_t task_alignment = 64;
+
+    public:
+
+        /// @ingroup factory_layers
+        /// The factory layer associated with this coder. Owns the
+        /// thread pool shared by the coders built by the factory.
+        class factory_base : public SuperCoder::factory_base
+        {
+        public:
+
+            /// @copydoc layer::factory_base::factory_base(uint32_t,uint32_t)
+            factory_base(uint32_t max_symbols, uint32_t max_symbol_size) :
+                SuperCoder::factory_base(max_symbols, max_symbol_size)
+            { }
+
+            /// @return The number of threads used for the region
+            ///         operations including the calling thread
+            uint32_t threads() const
+            {
+                return m_pool ? m_pool->threads() : 1U;
+            }
+
+            /// Sets the number of threads used for the region
+            /// operations by coders initialized after the call. Coders
+            /// already initialized keep the previous pool alive until
+            /// they are initialized again.
+            /// @param threads The number of threads including the
+            ///        calling thread
+            void set_threads(uint32_t threads)
+            {
+                assert(threads > 0);
+
+                if(threads == this->threads())
+                    return;
+
+                if(threads == 1)
+                {
+                    m_pool.reset();
+                }
+                else
+                {
+                    m_pool = std::make_shared<thread_pool>(threads);
+                }
+            }
+
+        private:
+
+            /// Give the layer access
+            friend class threaded_finite_field_math;
+
+            /// @return The thread pool or an empty pointer if the
+            ///         operations run on the calling thread
+            std::shared_ptr<thread_pool> worker_pool() const
+            {
+                return m_pool;
+            }
+
+        private:
+
+            /// The thread pool
+            std::shared_ptr<thread_pool> m_pool;
+        };
+
+    public:
+
+        /// Constructor
+        threaded_finite_field_math()
+            : m_max_symbols(0),
+              m_splitting(false)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+            m_max_symbols = the_factory.max_symbols();
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+            m_pool = the_factory.worker_pool();
+
+            // Every task but the first gets a slice of source pointers
+            // for the multiply_add_n() and multiply_subtract_n() calls,
+            // which only grows when the number of threads grows
+            uint32_t threads = m_pool ? m_pool->threads() : 1U;
+            uint32_t size = threads * m_max_symbols;
+
+            if(m_task_sources.size() < size)
+                m_task_sources.resize(size);
+        }
+
+        /// @copydoc layer::multiply(value_type*,value_type,uint32_t)
+        void multiply(value_type *symbol_dest, value_type coefficient,
+                      uint32_t symbol_length)
+        {
+            split(symbol_length,
+                  [=](uint32_t, uint32_t offset, uint32_t length)
+            {
+                SuperCoder::multiply(symbol_dest + offset, coefficient,
+                                     length);
+            });
+        }
+
+        /// @copydoc layer::multipy_add(value_type *, const value_type*,
+        ///                             value_type, uint32_t)
+        void multiply_add(value_type *symbol_dest,
+                          const value_type *symbol_src,
+                          value_type coefficient, uint32_t symbol_length)
+        {
+            split(symbol_length,
+                  [=](uint32_t, uint32_t offset, uint32_t length)
+            {
+                SuperCoder::multiply_add(symbol_dest + offset,
+                    symbol_src + offset, coefficient, length);
+            });
+        }
+
+        /// @copydoc layer::add(value_type*, const value_type *, uint32_t)
+        void add(value_type *symbol_dest, const value_type *symbol_src,
+                 uint32_t symbol_length)
+        {
+            split(symbol_length,
+                  [=](uint32_t, uint32_t offset, uint32_t length)
+            {
+                SuperCoder::add(symbol_dest + offset, symbol_src + offset,
+                                length);
+            });
+        }
+
+        /// @copydoc layer::multiply_subtract(value_type*, const value_type*,
+        ///                                   value_type, uint32_t)
+        void multiply_subtract(value_type *symbol_dest,
+                               const value_type *symbol_src,
+                               value_type coefficient,
+                               uint32_t symbol_length)
+        {
+            split(symbol_length,
+                  [=](uint32_t, uint32_t offset, uint32_t length)
+            {
+                SuperCoder::multiply_subtract(symbol_dest + offset,
+                    symbol_src + offset, coefficient, length);
+            });
+        }
+
+        /// @copydoc layer::subtract(value_type*,const value_type*, uint32_t)
+        void subtract(value_type *symbol_dest, const value_type *symbol_src,
+                      uint32_t symbol_length)
+        {
+            split(symbol_length,
+                  [=](uint32_t, uint32_t offset, uint32_t length)
+            {
+                SuperCoder::subtract(symbol_dest + offset,
+                                     symbol_src + offset, length);
+            });
+        }
+
+        /// @copydoc layer::multiply_add_n(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_add_n(value_type *symbol_dest,
+                            const value_type * const *symbol_src,
+                            const value_type *coefficients,
+                            uint32_t count, uint32_t symbol_length)
+        {
+            split(symbol_length,
+                  [=](uint32_t task, uint32_t offset, uint32_t length)
+            {
+                if(offset == 0)
+                {
+                    SuperCoder::multiply_add_n(symbol_dest, symbol_src,
+                        coefficients, count, length);
+                    return;
+                }
+
+                const value_type** sources = task_sources(task);
+
+                // The sources are offset in chunks which fit the slice
+                // of the task
+                for(uint32_t first = 0; first < count;
+                    first += m_max_symbols)
+                {
+                    uint32_t chunk = std::min(m_max_symbols, count - first);
+
+                    for(uint32_t i = 0; i < chunk; ++i)
+                        sources[i] = symbol_src[first + i] + offset;
+
+                    SuperCoder::multiply_add_n(symbol_dest + offset,
+                        sources, coefficients + first, chunk, length);
+                }
+            });
+        }
+
+        /// @copydoc layer::multiply_subtract_n(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_subtract_n(value_type *symbol_dest,
+                                 const value_type * const *symbol_src,
+                                 const value_type *coefficients,
+                                 uint32_t count, uint32_t symbol_length)
+        {
+            split(symbol_length,
+                  [=](uint32_t task, uint32_t offset, uint32_t length)
+            {
+                if(offset == 0)
+                {
+                    SuperCoder::multiply_subtract_n(symbol_dest, symbol_src,
+                        coefficients, count, length);
+                    return;
+                }
+
+                const value_type** sources = task_sources(task);
+
+                // The sources are offset in chunks which fit the slice
+                // of the task
+                for(uint32_t first = 0; first < count;
+                    first += m_max_symbols)
+                {
+                    uint32_t chunk = std::min(m_max_symbols, count - first);
+
+                    for(uint32_t i = 0; i < chunk; ++i)
+                        sources[i] = symbol_src[first + i] + offset;
+
+                    SuperCoder::multiply_subtract_n(symbol_dest + offset,
+                        sources, coefficients + first, chunk, length);
+                }
+            });
+        }
+
+        /// @copydoc layer::run_symbol_ranges(uint32_t, const Function&)
+        template<class Function>
+        void run_symbol_ranges(uint32_t symbol_length,
+                               const Function& function)
+        {
+            split(symbol_length,
+                  [&](uint32_t, uint32_t offset, uint32_t length)
+            {
+                function(offset, length);
+            });
+        }
+
+    private:
+
+        /// Runs the operation on the full symbol, or on byte ranges of
+        /// the symbol in parallel if the symbol is large enough.
+        /// @param symbol_length The length of the symbol in value_type
+        ///        elements
+        /// @param operation The operation invoked with the task index
+        ///        and the offset and length in value_type elements of
+        ///        each range
+        template<class Operation>
+        void split(uint32_t symbol_length, const Operation& operation)
+        {
+            uint32_t symbol_size = symbol_length * sizeof(value_type);
+
+            uint32_t tasks = 1;
+
+            // Operations called from a running task stay on the
+            // thread of the task
+            if(m_pool && !m_splitting)
+            {
+                tasks = std::min(m_pool->threads(),
+                                 symbol_size / min_task_size);
+            }
+
+            if(tasks <= 1)
+            {
+                operation(0, 0, symbol_length);
+                return;
+            }
+
+            // Round the task length up to the alignment
+            uint32_t alignment_length = std::max<uint32_t>(
+                1U, task_alignment / sizeof(value_type));
+
+            uint32_t task_length = (symbol_length + tasks - 1) / tasks;
+            task_length = ((task_length + alignment_length - 1) /
+                alignment_length) * alignment_length;
+
+            m_splitting = true;
+
+            m_pool->run(tasks, [&](uint32_t task)
+            {
+                uint32_t offset = task * task_length;
+
+                if(offset >= symbol_length)
+                    return;
+
+                operation(task, offset,
+                          std::min(task_length, symbol_length - offset));
+            });
+
+            m_splitting = false;
+        }
+
+        /// @param task The index of a task
+        /// @return The source pointers reserved for the task
+        const value_type** task_sources(uint32_t task)
+        {
+            assert((task + 1) * m_max_symbols <= m_task_sources.size());
+            return &m_task_sources[task * m_max_symbols];
+        }
+
+    private:
+
+        /// The thread pool or an empty pointer if the operations run
+        /// on the calling thread
+        std::shared_ptr<thread_pool> m_pool;
+
+        /// The maximum number of symbols, the number of source
+        /// pointers reserved for each task
+        uint32_t m_max_symbols;
+
+        /// The source pointers offset to the range of each task
+        std::vector<const value_type*> m_task_sources;
+
+        /// True while the tasks of an operation are running, it is
+        /// set before and cleared after the tasks, so the workers only
+        /// read it
+        bool m_splitting;
+    };
+
+    /// @ingroup finite_field_layers
+    ///
+    /// @brief Template alias for the common set of finite field
+    ///        layers with the region operations split across threads
+    template<class Field, class SuperCoder>
+    using threaded_finite_field_layers =
+        threaded_finite_field_math<
+        finite_field_math<typename fifi::default_field<Field>::type,
+        finite_field_info<Field, SuperCoder> > >;
+}
@@ -0,0 +1,261 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include "bit_scan.hpp"
+
+namespace kodo
+{
+    /// @brief Random generator policy for the coefficient generators
+    ///        using the xoshiro256** generator.
+    ///
+    /// Every draw yields 64 random bits which are used in full, i.e.
+    /// coefficient vectors are filled eight bytes at a time and the
+    /// bits of a sparse mask are drawn two at a time. This is
+    /// considerably faster than the mt19937_generator_policy, but
+    /// the coefficients generated from a seed differ. It should
+    /// therefore only be used where the coefficients themselves are
+    /// sent, e.g. in the full RLNC codes.
+    class xoshiro256_generator_policy
+    {
+    public:
+
+        /// The type of the seed
+        typedef uint32_t seed_type;
+
+    public:
+
+        /// Constructor
+        xoshiro256_generator_policy()
+        {
+            seed(0);
+        }
+
+        /// @param seed_value The seed of the random generator
+        void seed(seed_type seed_value)
+        {
+            // Expand the seed to the full state with splitmix64 which
+            // never produces an all zero state
+            uint64_t x = seed_value;
+
+            for(uint32_t i = 0; i < 4; ++i)
+            {
+                x += 0x9e3779b97f4a7c15ULL;
+
+                uint64_t z = x;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                m_state[i] = z ^ (z >> 31);
+            }
+        }
+
+        /// @return 64 random bits
+        uint64_t next()
+        {
+            uint64_t result = rotate_left(m_state[1] * 5, 7) * 9;
+            uint64_t t = m_state[1] << 17;
+
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+
+            m_state[2] ^= t;
+            m_state[3] = rotate_left(m_state[3], 45);
+
+            return result;
+        }
+
+        /// Fills a buffer with uniform random bytes
+        /// @param data The buffer to fill
+        /// @param size The size of the buffer in bytes
+        void generate(uint8_t* data, uint32_t size)
+        {
+            assert(data != 0);
+
+            uint32_t i = 0;
+
+            for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+            {
+                uint64_t word = next();
+                std::memcpy(data + i, &word, sizeof(uint64_t));
+            }
+
+            if(i < size)
+            {
+                uint64_t word = next();
+                std::memcpy(data + i, &word, size - i);
+            }
+        }
+
+        /// @param min The smallest value to generate
+        /// @param max The largest value to generate
+        /// @return A uniform random value in [min, max]
+        template<class ValueType>
+        ValueType generate_value(ValueType min, ValueType max)
+        {
+            static_assert(sizeof(ValueType) <= sizeof(uint32_t),
+                          "Only values up to 32 bit are supported");
+            assert(min <= max);
+
+            uint64_t range = uint64_t(max) - uint64_t(min) + 1;
+
+            if(range > std::numeric_limits<uint32_t>::max())
+            {
+                return (ValueType) (min + (next() >> 32));
+            }
+
+            // Lemire's multiply and shift method, the rejection makes
+            // the values unbiased for ranges which are not a power of
+            // two
+            uint64_t product = (next() >> 32) * range;
+            uint32_t low = (uint32_t) product;
+
+            if(low < range)
+            {
+                uint32_t threshold = (uint32_t) ((0x100000000ULL - range) %
+                                                 range);
+
+                while(low < threshold)
+                {
+                    product = (next() >> 32) * range;
+                    low = (uint32_t) product;
+                }
+            }
+
+            return (ValueType) (min + (product >> 32));
+        }
+
+        /// Fills a bit mask where each bit is set with a given
+        /// probability. The bits are stored least significant bit
+        /// first, i.e. in the layout of a fifi::binary vector.
+        /// @param mask The buffer of at least (count + 7) / 8 bytes
+        /// @param count The number of bits to generate
+        /// @param density The probability that a bit is set
+        void generate_mask(uint8_t* mask, uint32_t count, double density)
+        {
+            assert(mask != 0);
+            assert(density >= 0.0 && density <= 1.0);
+
+            uint32_t size = (count + 7) / 8;
+
+            if(density == 0.5)
+            {
+                // Every random bit is a mask bit
+                generate(mask, size);
+            }
+            else
+            {
+                // A bit is set if a 32 bit random number is below the
+                // threshold, two bits are drawn at a time
+                uint64_t threshold = (uint64_t) (density * 4294967296.0);
+
+                for(uint32_t i = 0; i < size; ++i)
+                {
+                    uint32_t bits = 0;
+
+                    for(uint32_t j = 0; j < 8; j += 2)
+                    {
+                        uint64_t word = next();
+
+                        bits |= uint32_t((word & 0xffffffffULL) <
+                                         threshold) << j;
+                        bits |= uint32_t((word >> 32) <
+                                         threshold) << (j + 1);
+                    }
+
+                    mask[i] = (uint8_t) bits;
+                }
+            }
+
+            // Clear the bits after the last one
+            if(count % 8 != 0)
+            {
+                mask[size - 1] &= (uint8_t) ((1U << (count % 8)) - 1);
+            }
+        }
+
+        /// Fills a sparse coefficient vector. The positions of the
+        /// nonzero coefficients are drawn first as a bit mask for the
+        /// whole vector with generate_mask(), after which a nonzero
+        /// value is drawn for every set position accepted by the
+        /// filter.
+        /// @param coefficients The coefficient vector, which must be
+        ///        zero initialized
+        /// @param count The number of coefficients
+        /// @param density The probability that a coefficient is nonzero
+        /// @param filter Returns true for the index of a coefficient
+        ///        which may be nonzero
+        template<class Field, class Filter>
+        void generate_sparse(typename Field::value_type* coefficients,
+                             uint32_t count, double density,
+                             const Filter& filter)
+        {
+            typedef typename Field::value_type value_type;
+
+            assert(coefficients != 0);
+
+            m_mask.resize((count + 7) / 8);
+            generate_mask(m_mask.data(), count, density);
+
+            for(uint32_t i = 0; i < m_mask.size(); ++i)
+            {
+                uint32_t bits = m_mask[i];
+
+                while(bits)
+                {
+                    uint32_t index = i * 8 + count_trailing_zeros(bits);
+                    bits &= bits - 1;
+
+                    if(!filter(index))
+                    {
+                        continue;
+                    }
+
+                    if(fifi::is_binary<Field>::value)
+                    {
+                        fifi::set_value<Field>(coefficients, index, 1);
+                    }
+                    else
+                    {
+                        fifi::set_value<Field>(coefficients, index,
+                            generate_value(value_type(1),
+                                           value_type(Field::max_value)));
+                    }
+                }
+            }
+        }
+
+    private:
+
+        /// @param value The value to rotate
+        /// @param bits The number of bits to rotate
+        /// @return The value rotated left
+        static uint64_t rotate_left(uint64_t value, uint32_t bits)
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+    private:
+
+        /// The state of the generator
+        uint64_t m_state[4];
+
+        /// The positions of the nonzero coefficients drawn by
+        /// generate_sparse()
+        std::vector<uint8_t> m_mask;
+
+    };
+}
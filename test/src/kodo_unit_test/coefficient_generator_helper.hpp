@@ -20,6 +20,8 @@
 #include <kodo/storage_block_length.hpp>
 #include <kodo/uniform_generator.hpp>
 #include <kodo/sparse_uniform_generator.hpp>
+#include <kodo/fast_uniform_generator.hpp>
+#include <kodo/fast_sparse_uniform_generator.hpp>
 #include <kodo/fake_symbol_storage.hpp>
 
 #include "basic_api_test_helper.hpp"
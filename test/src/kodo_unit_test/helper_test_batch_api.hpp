@@ -0,0 +1,167 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <ctime>
+
+#include <gtest/gtest.h>
+
+#include <kodo/has_deep_symbol_storage.hpp>
+#include <kodo/has_shallow_symbol_storage.hpp>
+#include <kodo/has_systematic_encoder.hpp>
+#include <kodo/set_systematic_off.hpp>
+#include <kodo/set_systematic_on.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Helper function which decodes a shuffled mix of systematic and coded
+/// payloads using layer::decode_batch(uint8_t**, uint32_t)
+template<class Encoder, class Decoder>
+inline void run_test_batch_api(uint32_t symbols, uint32_t symbol_size,
+                               uint32_t batch_size)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+    auto systematic_encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+
+    encoder->set_symbols(sak::storage(data_in));
+    systematic_encoder->set_symbols(sak::storage(data_in));
+
+    ASSERT_TRUE(kodo::has_systematic_encoder<Encoder>::value);
+    kodo::set_systematic_off(encoder);
+    kodo::set_systematic_on(systematic_encoder);
+
+    if (kodo::has_shallow_symbol_storage<Decoder>::value)
+    {
+        decoder->set_symbols(sak::storage(data_out));
+    }
+
+    // Use small tiles so that the symbols are split into several tiles
+    decoder->set_batch_tile_size(48);
+
+    // Half of the systematic symbols are lost, so the uncoded symbols
+    // that do arrive will often replace coded symbols in the decoder
+    std::vector<std::vector<uint8_t> > payloads;
+
+    for (uint32_t i = 0; i < symbols; ++i)
+    {
+        std::vector<uint8_t> payload(systematic_encoder->payload_size());
+        systematic_encoder->encode(payload.data());
+
+        if (rand() % 2)
+            payloads.push_back(payload);
+    }
+
+    // Add enough coded symbols to make decoding very likely
+    for (uint32_t i = 0; i < symbols + 20; ++i)
+    {
+        std::vector<uint8_t> payload(encoder->payload_size());
+        encoder->encode(payload.data());
+        payloads.push_back(payload);
+    }
+
+    std::random_shuffle(payloads.begin(), payloads.end());
+
+    std::vector<uint8_t*> batch;
+
+    for (auto& payload : payloads)
+    {
+        batch.push_back(payload.data());
+
+        if (batch.size() < batch_size)
+            continue;
+
+        decoder->decode_batch(batch.data(), (uint32_t) batch.size());
+        batch.clear();
+    }
+
+    if (batch.size() > 0)
+    {
+        decoder->decode_batch(batch.data(), (uint32_t) batch.size());
+    }
+
+    ASSERT_TRUE(decoder->is_complete());
+
+    if (kodo::has_deep_symbol_storage<Decoder>::value)
+    {
+        decoder->copy_symbols(sak::storage(data_out));
+    }
+
+    EXPECT_TRUE(data_out == data_in);
+}
+
+template
+<
+    template <class...> class Encoder,
+    template <class...> class Decoder
+>
+inline void test_batch_api(uint32_t symbols, uint32_t symbol_size,
+                           uint32_t batch_size)
+{
+    SCOPED_TRACE(testing::Message() << "symbols = " << symbols);
+    SCOPED_TRACE(testing::Message() << "symbol_size = " << symbol_size);
+    SCOPED_TRACE(testing::Message() << "batch_size = " << batch_size);
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary");
+        run_test_batch_api
+            <
+            Encoder<fifi::binary>,
+            Decoder<fifi::binary>
+            >(symbols, symbol_size, batch_size);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary4");
+        run_test_batch_api
+            <
+            Encoder<fifi::binary4>,
+            Decoder<fifi::binary4>
+            >(symbols, symbol_size, batch_size);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary8");
+        run_test_batch_api
+            <
+            Encoder<fifi::binary8>,
+            Decoder<fifi::binary8>
+            >(symbols, symbol_size, batch_size);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary16");
+        run_test_batch_api
+            <
+            Encoder<fifi::binary16>,
+            Decoder<fifi::binary16>
+            >(symbols, symbol_size, batch_size);
+    }
+}
+
+template
+<
+    template <class...> class Encoder,
+    template <class...> class Decoder
+>
+inline void test_batch_api()
+{
+    test_batch_api<Encoder, Decoder>(32, 1600, 8);
+    test_batch_api<Encoder, Decoder>(1, 1600, 4);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+    uint32_t batch_size = rand_nonzero(2 * symbols);
+
+    test_batch_api<Encoder, Decoder>(symbols, symbol_size, batch_size);
+}
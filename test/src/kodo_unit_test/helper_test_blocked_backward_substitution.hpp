@@ -0,0 +1,157 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/fifi_utils.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Helper function which decodes the same mix of uncoded and coded
+/// symbols with the blocked and the pivot by pivot final backward
+/// substitution of a delayed decoder, and checks that both decoders
+/// produce the original data and unit encoding vectors
+/// @param symbols The number of symbols
+/// @param symbol_size The size of a symbol in bytes
+/// @param tile_size The size in bytes of the tiles used by the
+///        blocked substitution
+/// @param batch True to decode all symbols in one decode batch
+template<class Decoder>
+inline void run_test_blocked_backward_substitution(
+    uint32_t symbols, uint32_t symbol_size, uint32_t tile_size, bool batch)
+{
+    typedef typename Decoder::field_type field_type;
+    typedef typename field_type::value_type value_type;
+
+    typename Decoder::factory factory(symbols, symbol_size);
+
+    auto blocked = factory.build();
+    auto pivots = factory.build();
+
+    EXPECT_TRUE(blocked->blocked_backward_substitution());
+
+    blocked->set_batch_tile_size(tile_size);
+    pivots->set_blocked_backward_substitution(false);
+
+    EXPECT_FALSE(pivots->blocked_backward_substitution());
+
+    std::vector<std::vector<uint8_t> > data(symbols);
+    for (auto& symbol : data)
+    {
+        symbol = random_vector(symbol_size);
+    }
+
+    uint32_t vector_size = blocked->coefficient_vector_size();
+    uint32_t symbol_length = blocked->symbol_length();
+
+    // The symbols given to the decoders must stay alive until the end
+    // of a decode batch, so all of them are prepared up front
+    std::vector<std::vector<uint8_t> > coded;
+    std::vector<std::vector<uint8_t> > coefficients;
+    std::vector<uint32_t> uncoded;
+
+    for (uint32_t i = 0; i < 2 * symbols; ++i)
+    {
+        std::vector<uint8_t> vector(vector_size);
+        std::vector<uint8_t> symbol(symbol_size, 0);
+
+        for (uint32_t j = 0; j < symbols; ++j)
+        {
+            value_type c = value_type(rand()) & field_type::max_value;
+            fifi::set_value<field_type>(&vector[0], j, c);
+
+            blocked->multiply_add(
+                reinterpret_cast<value_type*>(&symbol[0]),
+                reinterpret_cast<const value_type*>(&data[j][0]),
+                c, symbol_length);
+        }
+
+        coded.push_back(symbol);
+        coefficients.push_back(vector);
+    }
+
+    // Every third symbol is also received uncoded half way through,
+    // some of them after the coded symbols have made them pivots
+    for (uint32_t i = 0; i < symbols; i += 3)
+    {
+        uncoded.push_back(i);
+    }
+
+    for (auto decoder : {blocked, pivots})
+    {
+        std::vector<std::vector<uint8_t> > symbol_copies = coded;
+        std::vector<std::vector<uint8_t> > vector_copies = coefficients;
+
+        if (batch)
+            decoder->begin_decode_batch();
+
+        uint32_t next_uncoded = 0;
+
+        for (uint32_t i = 0; i < symbol_copies.size(); ++i)
+        {
+            if (decoder->is_complete())
+                break;
+
+            decoder->decode_symbol(
+                &symbol_copies[i][0], &vector_copies[i][0]);
+
+            if (i == symbols / 2 && next_uncoded < uncoded.size())
+            {
+                for (; next_uncoded < uncoded.size(); ++next_uncoded)
+                {
+                    uint32_t index = uncoded[next_uncoded];
+                    decoder->decode_symbol(&data[index][0], index);
+                }
+            }
+        }
+
+        if (batch)
+            decoder->end_decode_batch();
+
+        ASSERT_TRUE(decoder->is_complete());
+
+        for (uint32_t i = 0; i < symbols; ++i)
+        {
+            EXPECT_TRUE(decoder->is_symbol_uncoded(i));
+
+            const uint8_t* symbol =
+                reinterpret_cast<const uint8_t*>(decoder->symbol_value(i));
+
+            EXPECT_EQ(data[i],
+                      std::vector<uint8_t>(symbol, symbol + symbol_size));
+
+            const uint8_t* vector = decoder->coefficient_vector_data(i);
+
+            for (uint32_t j = 0; j < symbols; ++j)
+            {
+                EXPECT_EQ(i == j ? 1U : 0U,
+                          (uint32_t) fifi::get_value<field_type>(vector, j));
+            }
+        }
+    }
+}
+
+/// Runs the blocked backward substitution test for the binary and
+/// binary8 fields, outside and inside a decode batch
+template<template <class> class Decoder>
+inline void test_blocked_backward_substitution()
+{
+    for (bool batch : {false, true})
+    {
+        run_test_blocked_backward_substitution<Decoder<fifi::binary> >(
+            20, 100, 16, batch);
+
+        run_test_blocked_backward_substitution<Decoder<fifi::binary8> >(
+            20, 100, 16, batch);
+
+        run_test_blocked_backward_substitution<Decoder<fifi::binary8> >(
+            7, 1000, 2048, batch);
+    }
+}
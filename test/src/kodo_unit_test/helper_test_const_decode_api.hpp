@@ -0,0 +1,124 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/has_deep_symbol_storage.hpp>
+#include <kodo/has_shallow_symbol_storage.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Helper function which checks that layer::decode(const uint8_t*)
+/// decodes the payloads without changing them. Every third
+/// systematic packet is lost, so coded payloads are decoded as well.
+template<class Encoder, class Decoder>
+inline void run_test_const_decode_api(uint32_t symbols, uint32_t symbol_size)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+
+    encoder->set_symbols(sak::storage(data_in));
+
+    if (kodo::has_shallow_symbol_storage<Decoder>::value)
+    {
+        decoder->set_symbols(sak::storage(data_out));
+    }
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    uint32_t packets = 0;
+
+    while (!decoder->is_complete())
+    {
+        ASSERT_LT(packets, 10 * symbols + 100);
+
+        encoder->encode(payload.data());
+
+        if (packets < symbols && packets % 3 == 2)
+        {
+            ++packets;
+            continue;
+        }
+
+        std::vector<uint8_t> original = payload;
+
+        const uint8_t* const_payload = payload.data();
+        decoder->decode(const_payload);
+
+        EXPECT_TRUE(payload == original);
+        ++packets;
+    }
+
+    if (kodo::has_deep_symbol_storage<Decoder>::value)
+    {
+        decoder->copy_symbols(sak::storage(data_out));
+    }
+
+    EXPECT_TRUE(data_out == data_in);
+}
+
+template
+<
+    template <class...> class Encoder,
+    template <class...> class Decoder
+>
+inline void test_const_decode_api(uint32_t symbols, uint32_t symbol_size)
+{
+    SCOPED_TRACE(testing::Message() << "symbols = " << symbols);
+    SCOPED_TRACE(testing::Message() << "symbol_size = " << symbol_size);
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary");
+        run_test_const_decode_api
+            <
+            Encoder<fifi::binary>,
+            Decoder<fifi::binary>
+            >(symbols, symbol_size);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary8");
+        run_test_const_decode_api
+            <
+            Encoder<fifi::binary8>,
+            Decoder<fifi::binary8>
+            >(symbols, symbol_size);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary16");
+        run_test_const_decode_api
+            <
+            Encoder<fifi::binary16>,
+            Decoder<fifi::binary16>
+            >(symbols, symbol_size);
+    }
+}
+
+template
+<
+    template <class...> class Encoder,
+    template <class...> class Decoder
+>
+inline void test_const_decode_api()
+{
+    test_const_decode_api<Encoder, Decoder>(32, 1600);
+    test_const_decode_api<Encoder, Decoder>(1, 1600);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_const_decode_api<Encoder, Decoder>(symbols, symbol_size);
+}
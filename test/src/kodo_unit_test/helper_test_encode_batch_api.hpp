@@ -0,0 +1,170 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/has_deep_symbol_storage.hpp>
+#include <kodo/has_shallow_symbol_storage.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Helper function which checks that layer::encode_batch(uint8_t**,
+/// uint32_t, uint32_t*) produces the same payloads as encoding them
+/// one at a time, and that the payloads decode
+template<class Encoder, class Decoder>
+inline void run_test_encode_batch_api(uint32_t symbols, uint32_t symbol_size,
+                                      uint32_t batch_size)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+    auto batch_encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+
+    encoder->set_symbols(sak::storage(data_in));
+    batch_encoder->set_symbols(sak::storage(data_in));
+
+    if (kodo::has_shallow_symbol_storage<Decoder>::value)
+    {
+        decoder->set_symbols(sak::storage(data_out));
+    }
+
+    // The batches span the systematic and the coded phase
+    uint32_t payload_count = 2 * symbols + 20;
+    uint32_t payload_size = encoder->payload_size();
+
+    std::vector<std::vector<uint8_t> > payloads(payload_count);
+    std::vector<std::vector<uint8_t> > batch_payloads(payload_count);
+
+    for (uint32_t i = 0; i < payload_count; ++i)
+    {
+        payloads[i].resize(payload_size, 0xAA);
+        batch_payloads[i].resize(payload_size, 0x55);
+    }
+
+    std::vector<uint32_t> bytes_used(payload_count);
+    std::vector<uint32_t> batch_bytes_used(payload_count);
+
+    for (uint32_t i = 0; i < payload_count; ++i)
+    {
+        bytes_used[i] = encoder->encode(payloads[i].data());
+    }
+
+    std::vector<uint8_t*> batch;
+
+    for (uint32_t i = 0; i < payload_count; i += batch_size)
+    {
+        uint32_t count = std::min(batch_size, payload_count - i);
+
+        batch.clear();
+
+        for (uint32_t j = 0; j < count; ++j)
+        {
+            batch.push_back(batch_payloads[i + j].data());
+        }
+
+        batch_encoder->encode_batch(batch.data(), count,
+                                    &batch_bytes_used[i]);
+    }
+
+    for (uint32_t i = 0; i < payload_count; ++i)
+    {
+        ASSERT_EQ(bytes_used[i], batch_bytes_used[i]);
+
+        EXPECT_TRUE(std::equal(payloads[i].begin(),
+                               payloads[i].begin() + bytes_used[i],
+                               batch_payloads[i].begin()));
+    }
+
+    for (uint32_t i = 0; i < payload_count && !decoder->is_complete(); ++i)
+    {
+        decoder->decode(batch_payloads[i].data());
+    }
+
+    ASSERT_TRUE(decoder->is_complete());
+
+    if (kodo::has_deep_symbol_storage<Decoder>::value)
+    {
+        decoder->copy_symbols(sak::storage(data_out));
+    }
+
+    EXPECT_TRUE(data_out == data_in);
+}
+
+template
+<
+    template <class...> class Encoder,
+    template <class...> class Decoder
+>
+inline void test_encode_batch_api(uint32_t symbols, uint32_t symbol_size,
+                                  uint32_t batch_size)
+{
+    SCOPED_TRACE(testing::Message() << "symbols = " << symbols);
+    SCOPED_TRACE(testing::Message() << "symbol_size = " << symbol_size);
+    SCOPED_TRACE(testing::Message() << "batch_size = " << batch_size);
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary");
+        run_test_encode_batch_api
+            <
+            Encoder<fifi::binary>,
+            Decoder<fifi::binary>
+            >(symbols, symbol_size, batch_size);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary4");
+        run_test_encode_batch_api
+            <
+            Encoder<fifi::binary4>,
+            Decoder<fifi::binary4>
+            >(symbols, symbol_size, batch_size);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary8");
+        run_test_encode_batch_api
+            <
+            Encoder<fifi::binary8>,
+            Decoder<fifi::binary8>
+            >(symbols, symbol_size, batch_size);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary16");
+        run_test_encode_batch_api
+            <
+            Encoder<fifi::binary16>,
+            Decoder<fifi::binary16>
+            >(symbols, symbol_size, batch_size);
+    }
+}
+
+template
+<
+    template <class...> class Encoder,
+    template <class...> class Decoder
+>
+inline void test_encode_batch_api()
+{
+    // Large symbols are split into several tiles per batch
+    test_encode_batch_api<Encoder, Decoder>(32, 8000, 16);
+    test_encode_batch_api<Encoder, Decoder>(1, 1600, 4);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+    uint32_t batch_size = rand_nonzero(2 * symbols);
+
+    test_encode_batch_api<Encoder, Decoder>(symbols, symbol_size, batch_size);
+}
@@ -0,0 +1,159 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/has_deep_symbol_storage.hpp>
+#include <kodo/has_shallow_symbol_storage.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Helper function which checks that layer::encode_gather(uint8_t*,
+/// const uint8_t**) produces the same packets as
+/// layer::encode(uint8_t*), that the first symbols_uncoded packets
+/// reference the source symbols instead of copying them, and that
+/// the packets decode
+template<class Encoder, class Decoder>
+inline void run_test_encode_gather_api(uint32_t symbols,
+                                       uint32_t symbol_size,
+                                       uint32_t symbols_uncoded)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+    auto gather_encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+
+    encoder->set_symbols(sak::storage(data_in));
+    gather_encoder->set_symbols(sak::storage(data_in));
+
+    if (kodo::has_shallow_symbol_storage<Decoder>::value)
+    {
+        decoder->set_symbols(sak::storage(data_out));
+    }
+
+    uint32_t payload_size = encoder->payload_size();
+
+    std::vector<uint8_t> payload(payload_size);
+    std::vector<uint8_t> gather_payload(payload_size, 0x55);
+    std::vector<uint8_t> packet(payload_size);
+
+    for (uint32_t i = 0; i < 2 * symbols + 20; ++i)
+    {
+        uint32_t bytes_used = encoder->encode(payload.data());
+
+        // Mark the symbol data, an uncoded symbol must not touch it
+        std::fill(gather_payload.begin(), gather_payload.end(), 0x55);
+
+        const uint8_t* symbol = 0;
+        uint32_t gather_bytes_used =
+            gather_encoder->encode_gather(gather_payload.data(), &symbol);
+
+        ASSERT_EQ(bytes_used, gather_bytes_used);
+        ASSERT_TRUE(symbol != 0);
+
+        if (i < symbols_uncoded)
+        {
+            EXPECT_TRUE(symbol != gather_payload.data());
+            EXPECT_EQ(0x55, gather_payload[0]);
+
+            if (kodo::has_shallow_symbol_storage<Encoder>::value)
+            {
+                EXPECT_EQ(&data_in[(i % symbols) * symbol_size], symbol);
+            }
+        }
+        else
+        {
+            EXPECT_EQ(gather_payload.data(), symbol);
+        }
+
+        // Assemble the packet as sendmsg() would from the two buffers
+        std::copy(symbol, symbol + symbol_size, packet.begin());
+        std::copy(gather_payload.begin() + symbol_size,
+                  gather_payload.begin() + bytes_used,
+                  packet.begin() + symbol_size);
+
+        EXPECT_TRUE(std::equal(payload.begin(),
+                               payload.begin() + bytes_used,
+                               packet.begin()));
+
+        if (!decoder->is_complete())
+        {
+            decoder->decode(packet.data());
+        }
+    }
+
+    ASSERT_TRUE(decoder->is_complete());
+
+    if (kodo::has_deep_symbol_storage<Decoder>::value)
+    {
+        decoder->copy_symbols(sak::storage(data_out));
+    }
+
+    EXPECT_TRUE(data_out == data_in);
+}
+
+template
+<
+    template <class...> class Encoder,
+    template <class...> class Decoder
+>
+inline void test_encode_gather_api(uint32_t symbols, uint32_t symbol_size)
+{
+    SCOPED_TRACE(testing::Message() << "symbols = " << symbols);
+    SCOPED_TRACE(testing::Message() << "symbol_size = " << symbol_size);
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary");
+        run_test_encode_gather_api
+            <
+            Encoder<fifi::binary>,
+            Decoder<fifi::binary>
+            >(symbols, symbol_size, symbols);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary8");
+        run_test_encode_gather_api
+            <
+            Encoder<fifi::binary8>,
+            Decoder<fifi::binary8>
+            >(symbols, symbol_size, symbols);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary16");
+        run_test_encode_gather_api
+            <
+            Encoder<fifi::binary16>,
+            Decoder<fifi::binary16>
+            >(symbols, symbol_size, symbols);
+    }
+}
+
+template
+<
+    template <class...> class Encoder,
+    template <class...> class Decoder
+>
+inline void test_encode_gather_api()
+{
+    test_encode_gather_api<Encoder, Decoder>(32, 1600);
+    test_encode_gather_api<Encoder, Decoder>(1, 1600);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_encode_gather_api<Encoder, Decoder>(symbols, symbol_size);
+}
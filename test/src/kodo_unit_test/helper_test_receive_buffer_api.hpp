@@ -0,0 +1,132 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "basic_api_test_helper.hpp"
+
+/// Helper function which receives every packet directly into the
+/// buffer given by layer::receive_buffer() and decodes it with
+/// layer::decode_scatter(uint8_t*, uint8_t*). Every third systematic
+/// packet is lost, so coded packets are received into the decoder
+/// storage as well. The packet following a loss is received into the
+/// storage of the lost symbol, but the systematic packets after it
+/// must again be received in place.
+template<class Encoder, class Decoder>
+inline void run_test_receive_buffer_api(uint32_t symbols,
+                                        uint32_t symbol_size)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+
+    encoder->set_symbols(sak::storage(data_in));
+    decoder->set_symbols(sak::storage(data_out));
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+    std::vector<uint8_t> header(encoder->payload_size());
+
+    uint32_t packets = 0;
+
+    while (!decoder->is_complete())
+    {
+        ASSERT_LT(packets, 10 * symbols + 100);
+
+        uint32_t bytes_used = encoder->encode(payload.data());
+
+        if (packets < symbols && packets % 3 == 2)
+        {
+            ++packets;
+            continue;
+        }
+
+        uint8_t* symbol_data = decoder->receive_buffer();
+        ASSERT_TRUE(symbol_data != 0);
+
+        // The systematic symbols arrive in place, except the one
+        // received right after a loss
+        if (packets < symbols && (packets == 0 || packets % 3 != 0))
+        {
+            EXPECT_EQ(&data_out[packets * symbol_size], symbol_data)
+                << "packet " << packets;
+        }
+
+        // Receive the packet as recvmsg() would into the two buffers
+        std::copy(payload.begin(), payload.begin() + symbol_size,
+                  symbol_data);
+        std::copy(payload.begin() + symbol_size,
+                  payload.begin() + bytes_used, header.begin());
+
+        decoder->decode_scatter(symbol_data, header.data());
+        ++packets;
+    }
+
+    EXPECT_TRUE(decoder->receive_buffer() == 0);
+    EXPECT_TRUE(data_out == data_in);
+}
+
+template
+<
+    template <class...> class Encoder,
+    template <class...> class Decoder
+>
+inline void test_receive_buffer_api(uint32_t symbols, uint32_t symbol_size)
+{
+    SCOPED_TRACE(testing::Message() << "symbols = " << symbols);
+    SCOPED_TRACE(testing::Message() << "symbol_size = " << symbol_size);
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary");
+        run_test_receive_buffer_api
+            <
+            Encoder<fifi::binary>,
+            Decoder<fifi::binary>
+            >(symbols, symbol_size);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary8");
+        run_test_receive_buffer_api
+            <
+            Encoder<fifi::binary8>,
+            Decoder<fifi::binary8>
+            >(symbols, symbol_size);
+    }
+
+    {
+        SCOPED_TRACE(testing::Message() << "field = binary16");
+        run_test_receive_buffer_api
+            <
+            Encoder<fifi::binary16>,
+            Decoder<fifi::binary16>
+            >(symbols, symbol_size);
+    }
+}
+
+template
+<
+    template <class...> class Encoder,
+    template <class...> class Decoder
+>
+inline void test_receive_buffer_api()
+{
+    test_receive_buffer_api<Encoder, Decoder>(32, 1600);
+    test_receive_buffer_api<Encoder, Decoder>(1, 1600);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_receive_buffer_api<Encoder, Decoder>(symbols, symbol_size);
+}
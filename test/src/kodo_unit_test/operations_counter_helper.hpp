@@ -18,6 +18,7 @@ inline void set_values(kodo::operations_counter &counter, uint32_t value)
     counter.m_multiply_subtract = value;
     counter.m_subtract = value;
     counter.m_invert = value;
+    counter.m_bytes_saved = value;
 }
 
 /// Helper function which tests all values in the counter
@@ -31,4 +32,5 @@ inline void test_values(kodo::operations_counter &counter, uint32_t value)
     EXPECT_EQ(counter.m_multiply_subtract, value);
     EXPECT_EQ(counter.m_subtract, value);
     EXPECT_EQ(counter.m_invert, value);
+    EXPECT_EQ(counter.m_bytes_saved, value);
 }
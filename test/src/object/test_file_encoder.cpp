@@ -4,17 +4,24 @@
 // http://www.steinwurf.com/licensing
 
 /// @file test_file_encoder.cpp Unit tests for the
-///       file_encoder and file_decoder class
+///       file_encoder, streaming_file_encoder, file_decoder and
+///       streaming_file_decoder class
 
 #include <fstream>
 #include <algorithm>
+#include <csignal>
+#include <system_error>
 #include <vector>
 
+#include <sys/resource.h>
+
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 
 #include <kodo/object/file_encoder.hpp>
 #include <kodo/object/file_decoder.hpp>
+#include <kodo/object/streaming_file_encoder.hpp>
+#include <kodo/object/streaming_file_decoder.hpp>
 
 #include <kodo/rlnc/full_rlnc_codes.hpp>
 
@@ -189,6 +196,104 @@ namespace
         kodo::final_test>>>;
 }
 
+namespace
+{
+    /// Lowers the limit of the size of the files written by the
+    /// process and ignores SIGXFSZ, so writes beyond the limit fail
+    /// with EFBIG. Both are restored when the guard is destroyed,
+    /// also if the test fails.
+    class file_size_limit_guard
+    {
+    public:
+
+        /// @param size The largest file size allowed
+        explicit file_size_limit_guard(rlim_t size)
+            : m_limited(false)
+        {
+            m_handler = std::signal(SIGXFSZ, SIG_IGN);
+
+            if (getrlimit(RLIMIT_FSIZE, &m_limit) == 0)
+            {
+                rlimit small_limit = m_limit;
+                small_limit.rlim_cur = size;
+
+                m_limited = setrlimit(RLIMIT_FSIZE, &small_limit) == 0;
+            }
+        }
+
+        ~file_size_limit_guard()
+        {
+            if (m_limited)
+            {
+                setrlimit(RLIMIT_FSIZE, &m_limit);
+            }
+
+            std::signal(SIGXFSZ, m_handler);
+        }
+
+        /// @return True if the limit was lowered
+        bool is_limited() const
+        {
+            return m_limited;
+        }
+
+    private:
+
+        file_size_limit_guard(const file_size_limit_guard&);
+        file_size_limit_guard& operator=(const file_size_limit_guard&);
+
+    private:
+
+        /// The limit to restore
+        rlimit m_limit;
+
+        /// True if the limit was lowered
+        bool m_limited;
+
+        /// The handler of SIGXFSZ to restore
+        void (*m_handler)(int);
+    };
+
+    /// Creates a unique directory under the temporary directory and
+    /// removes it with its files when the guard is destroyed, also if
+    /// the test fails
+    class temporary_directory_guard
+    {
+    public:
+
+        temporary_directory_guard()
+            : m_path(boost::filesystem::temp_directory_path() /
+                     boost::filesystem::unique_path("kodo-%%%%-%%%%-%%%%"))
+        {
+            boost::filesystem::create_directories(m_path);
+        }
+
+        ~temporary_directory_guard()
+        {
+            boost::system::error_code error;
+            boost::filesystem::remove_all(m_path, error);
+        }
+
+        /// @param file_name The name of a file
+        /// @return The path of the file in the directory
+        std::string file(const std::string& file_name) const
+        {
+            return (m_path / file_name).string();
+        }
+
+    private:
+
+        temporary_directory_guard(const temporary_directory_guard&);
+        temporary_directory_guard& operator=(
+            const temporary_directory_guard&);
+
+    private:
+
+        /// The path of the directory
+        boost::filesystem::path m_path;
+    };
+}
+
 void run_test_file(uint32_t max_symbols, uint32_t max_symbol_size)
 {
     using encoder = kodo::object::file_encoder<
@@ -300,3 +405,561 @@ TEST(ObjectTestFileEncoder, rebuild)
     test t(max_symbols, max_symbol_size);
     t.run();
 }
+
+// Test that the streaming file encoder works with the file decoder
+TEST(ObjectTestFileEncoder, streaming_api)
+{
+    uint32_t max_symbols = 42;
+    uint32_t max_symbol_size = 64;
+
+    using encoder = kodo::object::streaming_file_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary>>;
+
+    using decoder = kodo::object::file_decoder<
+        kodo::shallow_full_rlnc_decoder<fifi::binary>>;
+
+    {
+        using test = test_file<encoder, decoder>;
+
+        test t(max_symbols, max_symbol_size);
+        t.run();
+    }
+
+    {
+        using test = test_file_random<encoder, decoder>;
+
+        test t(max_symbols, max_symbol_size);
+        t.run();
+    }
+
+    {
+        using test = test_file_rebuild<encoder, decoder>;
+
+        test t(max_symbols, max_symbol_size);
+        t.run();
+    }
+}
+
+// Test the streaming file encoder with different numbers of block
+// buffers, encoding the blocks in order
+TEST(ObjectTestFileEncoder, streaming_buffered_blocks)
+{
+    uint32_t max_symbols = 16;
+    uint32_t max_symbol_size = 100;
+    uint32_t file_size = 23456;
+
+    using encoder_type = kodo::object::streaming_file_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary8>>;
+
+    using decoder_type = kodo::object::file_decoder<
+        kodo::shallow_full_rlnc_decoder<fifi::binary8>>;
+
+    std::string encode_filename = "encode-streaming-file.bin";
+    std::string decode_filename = "decode-streaming-file.bin";
+
+    std::vector<char> data_in(file_size);
+    std::generate(data_in.begin(), data_in.end(), rand);
+
+    {
+        std::ofstream encode_file(encode_filename, std::ios::binary);
+        encode_file.write(data_in.data(), data_in.size());
+    }
+
+    for (uint32_t buffered_blocks = 1; buffered_blocks <= 3;
+         ++buffered_blocks)
+    {
+        SCOPED_TRACE(testing::Message() << "buffered_blocks = "
+                                        << buffered_blocks);
+
+        if (boost::filesystem::is_regular_file(decode_filename))
+        {
+            boost::filesystem::remove(decode_filename);
+        }
+
+        encoder_type::factory encoder_factory(max_symbols, max_symbol_size);
+        decoder_type::factory decoder_factory(max_symbols, max_symbol_size);
+
+        encoder_factory.set_filename(encode_filename);
+        encoder_factory.set_buffered_blocks(buffered_blocks);
+
+        decoder_factory.set_filename(decode_filename);
+        decoder_factory.set_file_size(file_size);
+
+        {
+            auto encoder = encoder_factory.build();
+            auto decoder = decoder_factory.build();
+
+            EXPECT_EQ(file_size, encoder->object_size());
+            EXPECT_EQ(buffered_blocks, encoder->buffered_blocks());
+            ASSERT_EQ(decoder->blocks(), encoder->blocks());
+            ASSERT_GT(encoder->blocks(), 3U);
+
+            for (uint32_t i = 0; i < encoder->blocks(); ++i)
+            {
+                auto e = encoder->build(i);
+                auto d = decoder->build(i);
+
+                std::vector<uint8_t> payload(e->payload_size());
+
+                while (!d->is_complete())
+                {
+                    e->encode(payload.data());
+                    d->decode(payload.data());
+                }
+            }
+        }
+
+        std::vector<char> data_out(file_size);
+
+        std::ifstream decode_file(decode_filename, std::ios::binary);
+        decode_file.read(data_out.data(), data_out.size());
+        decode_file.close();
+
+        EXPECT_TRUE(data_in == data_out);
+    }
+
+    boost::filesystem::remove(encode_filename);
+    boost::filesystem::remove(decode_filename);
+}
+
+// Test that the streaming file encoder reports the errors of opening
+// and reading the file
+TEST(ObjectTestFileEncoder, streaming_encoder_errors)
+{
+    uint32_t max_symbols = 16;
+    uint32_t max_symbol_size = 100;
+    uint32_t file_size = 23456;
+
+    using encoder_type = kodo::object::streaming_file_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary8>>;
+
+    std::string encode_filename = "encode-read-errors-file.bin";
+
+    std::vector<char> data_in(file_size);
+    std::generate(data_in.begin(), data_in.end(), rand);
+
+    {
+        std::ofstream encode_file(encode_filename, std::ios::binary);
+        encode_file.write(data_in.data(), data_in.size());
+    }
+
+    encoder_type::factory encoder_factory(max_symbols, max_symbol_size);
+
+    encoder_factory.set_filename("missing-" + encode_filename);
+
+    try
+    {
+        encoder_factory.build();
+        ADD_FAILURE() << "Expected a std::system_error";
+    }
+    catch (const std::system_error& error)
+    {
+        EXPECT_EQ(ENOENT, error.code().value());
+    }
+
+    encoder_factory.set_filename(encode_filename);
+
+    for (uint32_t buffered_blocks = 1; buffered_blocks <= 2;
+         ++buffered_blocks)
+    {
+        SCOPED_TRACE(testing::Message() << "buffered_blocks = "
+                                        << buffered_blocks);
+
+        encoder_factory.set_buffered_blocks(buffered_blocks);
+
+        boost::filesystem::resize_file(encode_filename, file_size);
+
+        auto encoder = encoder_factory.build();
+        ASSERT_GT(encoder->blocks(), 3U);
+
+        // The file shrinks after it was opened, so it ends inside
+        // block 2
+        boost::filesystem::resize_file(
+            encode_filename, encoder->byte_offset(2) + 10);
+
+        EXPECT_NO_THROW(encoder->build(0));
+        EXPECT_NO_THROW(encoder->build(1));
+
+        for (uint32_t i = 2; i < encoder->blocks(); ++i)
+        {
+            try
+            {
+                encoder->build(i);
+                ADD_FAILURE() << "Expected a std::system_error";
+            }
+            catch (const std::system_error& error)
+            {
+                EXPECT_EQ(EIO, error.code().value());
+            }
+        }
+    }
+
+    boost::filesystem::remove(encode_filename);
+}
+
+// Test that the streaming file decoder works with both file encoders
+TEST(ObjectTestFileEncoder, streaming_decoder_api)
+{
+    uint32_t max_symbols = 42;
+    uint32_t max_symbol_size = 64;
+
+    using encoder = kodo::object::file_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary>>;
+
+    using streaming_encoder = kodo::object::streaming_file_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary>>;
+
+    using decoder = kodo::object::streaming_file_decoder<
+        kodo::shallow_full_rlnc_decoder<fifi::binary>>;
+
+    {
+        using test = test_file<encoder, decoder>;
+
+        test t(max_symbols, max_symbol_size);
+        t.run();
+    }
+
+    {
+        using test = test_file<streaming_encoder, decoder>;
+
+        test t(max_symbols, max_symbol_size);
+        t.run();
+    }
+
+    {
+        using test = test_file_output_exists<encoder, decoder>;
+
+        test t(max_symbols, max_symbol_size);
+        t.run();
+    }
+
+    {
+        using test = test_file_random<encoder, decoder>;
+
+        test t(max_symbols, max_symbol_size);
+        t.run();
+    }
+
+    {
+        using test = test_file_duplicate_blocks<encoder, decoder>;
+
+        test t(max_symbols, max_symbol_size);
+        t.run();
+    }
+
+    {
+        using test = test_file_rebuild<encoder, decoder>;
+
+        test t(max_symbols, max_symbol_size);
+        t.run();
+    }
+}
+
+// Test that the streaming file decoder only allocates buffers for the
+// blocks being decoded and that completed blocks are written by flush
+TEST(ObjectTestFileEncoder, streaming_decoder_write_behind)
+{
+    uint32_t max_symbols = 16;
+    uint32_t max_symbol_size = 100;
+    uint32_t file_size = 23456;
+
+    using encoder_type = kodo::object::streaming_file_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary8>>;
+
+    using decoder_type = kodo::object::streaming_file_decoder<
+        kodo::shallow_full_rlnc_decoder<fifi::binary8>>;
+
+    std::string encode_filename = "encode-write-behind-file.bin";
+    std::string decode_filename = "decode-write-behind-file.bin";
+
+    std::vector<char> data_in(file_size);
+    std::generate(data_in.begin(), data_in.end(), rand);
+
+    {
+        std::ofstream encode_file(encode_filename, std::ios::binary);
+        encode_file.write(data_in.data(), data_in.size());
+    }
+
+    encoder_type::factory encoder_factory(max_symbols, max_symbol_size);
+    decoder_type::factory decoder_factory(max_symbols, max_symbol_size);
+
+    encoder_factory.set_filename(encode_filename);
+
+    decoder_factory.set_filename(decode_filename);
+    decoder_factory.set_file_size(file_size);
+
+    auto encoder = encoder_factory.build();
+    auto decoder = decoder_factory.build();
+
+    EXPECT_EQ(file_size, decoder->object_size());
+    ASSERT_EQ(decoder->blocks(), encoder->blocks());
+    ASSERT_GT(decoder->blocks(), 3U);
+
+    // The file is created with its final size
+    EXPECT_EQ(file_size, boost::filesystem::file_size(decode_filename));
+
+    for (uint32_t i = 0; i < encoder->blocks(); ++i)
+    {
+        auto e = encoder->build(i);
+        auto d = decoder->build(i);
+
+        std::vector<uint8_t> payload(e->payload_size());
+
+        while (!d->is_complete())
+        {
+            e->encode(payload.data());
+            d->decode(payload.data());
+        }
+
+        EXPECT_TRUE(decoder->is_block_complete(i));
+
+        // Once the block is written its buffer is reused for the
+        // next block
+        decoder->flush();
+        EXPECT_EQ(1U, decoder->allocated_buffers());
+
+        // The block is in the file before the decoder is released
+        std::vector<char> block_out(d->block_size());
+
+        std::ifstream decode_file(decode_filename, std::ios::binary);
+        decode_file.seekg(decoder->byte_offset(i));
+        decode_file.read(block_out.data(), block_out.size());
+
+        uint32_t bytes = (uint32_t) decode_file.gcount();
+        EXPECT_TRUE(std::equal(block_out.begin(), block_out.begin() + bytes,
+                               data_in.begin() + decoder->byte_offset(i)));
+    }
+
+    EXPECT_TRUE(decoder->is_complete());
+
+    encoder.reset();
+    decoder.reset();
+
+    std::vector<char> data_out(file_size);
+
+    std::ifstream decode_file(decode_filename, std::ios::binary);
+    decode_file.read(data_out.data(), data_out.size());
+    decode_file.close();
+
+    EXPECT_TRUE(data_in == data_out);
+
+    boost::filesystem::remove(encode_filename);
+    boost::filesystem::remove(decode_filename);
+}
+
+// Test that the streaming file decoder reports the errors of creating
+// and writing the file
+TEST(ObjectTestFileEncoder, streaming_decoder_errors)
+{
+    uint32_t max_symbols = 16;
+    uint32_t max_symbol_size = 100;
+    uint32_t file_size = 23456;
+
+    using encoder_type = kodo::object::streaming_file_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary8>>;
+
+    using decoder_type = kodo::object::streaming_file_decoder<
+        kodo::shallow_full_rlnc_decoder<fifi::binary8>>;
+
+    std::string encode_filename = "encode-write-errors-file.bin";
+    std::string decode_filename = "decode-write-errors-file.bin";
+
+    std::vector<char> data_in(file_size);
+    std::generate(data_in.begin(), data_in.end(), rand);
+
+    {
+        std::ofstream encode_file(encode_filename, std::ios::binary);
+        encode_file.write(data_in.data(), data_in.size());
+    }
+
+    decoder_type::factory decoder_factory(max_symbols, max_symbol_size);
+    decoder_factory.set_file_size(file_size);
+
+    // The file cannot be created in a directory which does not exist
+    decoder_factory.set_filename("missing-directory/" + decode_filename);
+
+    try
+    {
+        decoder_factory.build();
+        ADD_FAILURE() << "Expected a std::system_error";
+    }
+    catch (const std::system_error& error)
+    {
+        EXPECT_EQ(ENOENT, error.code().value());
+    }
+
+    encoder_type::factory encoder_factory(max_symbols, max_symbol_size);
+    encoder_factory.set_filename(encode_filename);
+
+    decoder_factory.set_filename(decode_filename);
+
+    auto encoder = encoder_factory.build();
+    auto decoder = decoder_factory.build();
+
+    ASSERT_GT(decoder->blocks(), 3U);
+
+    {
+        // Limit the size of the files written, so the writes of the
+        // blocks ending after the limit are cut short and the next
+        // write fails with EFBIG
+        file_size_limit_guard limit(decoder->byte_offset(2) + 10);
+        ASSERT_TRUE(limit.is_limited());
+
+        for (uint32_t i = 0; i < encoder->blocks(); ++i)
+        {
+            auto e = encoder->build(i);
+            auto d = decoder->build(i);
+
+            std::vector<uint8_t> payload(e->payload_size());
+
+            while (!d->is_complete())
+            {
+                e->encode(payload.data());
+                d->decode(payload.data());
+            }
+        }
+
+        try
+        {
+            decoder->flush();
+            ADD_FAILURE() << "Expected a std::system_error";
+        }
+        catch (const std::system_error& error)
+        {
+            EXPECT_EQ(EFBIG, error.code().value());
+        }
+    }
+
+    // The error is only reported once
+    EXPECT_NO_THROW(decoder->flush());
+    EXPECT_NO_THROW(decoder->close());
+
+    // The blocks before the limit were written in full
+    std::vector<char> data_out(decoder->byte_offset(2));
+
+    std::ifstream decode_file(decode_filename, std::ios::binary);
+    decode_file.read(data_out.data(), data_out.size());
+    decode_file.close();
+
+    EXPECT_TRUE(std::equal(data_out.begin(), data_out.end(),
+                           data_in.begin()));
+
+    encoder.reset();
+    decoder.reset();
+
+    boost::filesystem::remove(encode_filename);
+    boost::filesystem::remove(decode_filename);
+}
+
+// Test that files larger than 4 GB can be encoded and decoded. The
+// files are sparse so only the blocks around the 4 GB boundary and at
+// the end of the file are written and decoded.
+TEST(ObjectTestFileEncoder, large_file)
+{
+    uint32_t max_symbols = 32;
+    uint32_t max_symbol_size = 1024;
+    uint64_t file_size = 5ULL * 1024 * 1024 * 1024 + 4321;
+
+    using encoder_type = kodo::object::file_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary8>>;
+
+    using decoder_type = kodo::object::file_decoder<
+        kodo::shallow_full_rlnc_decoder<fifi::binary8>>;
+
+    // The files are removed with the directory, also if the test fails
+    temporary_directory_guard directory;
+
+    std::string encode_filename = directory.file("encode-large-file.bin");
+    std::string decode_filename = directory.file("decode-large-file.bin");
+
+    // Create a sparse file for encoding
+    {
+        std::ofstream encode_file(encode_filename, std::ios::binary);
+        ASSERT_TRUE(encode_file.good());
+    }
+
+    boost::filesystem::resize_file(encode_filename, file_size);
+
+    kodo::rfc5052_partitioning_scheme partitioning(
+        max_symbols, max_symbol_size, file_size);
+
+    // Pick the block crossing the 4 GB boundary and the last block
+    uint32_t boundary_block = 0;
+    while (partitioning.byte_offset(boundary_block) +
+           partitioning.block_size(boundary_block) <= (1ULL << 32))
+    {
+        ++boundary_block;
+    }
+
+    std::vector<uint32_t> blocks = {
+        boundary_block, partitioning.blocks() - 1 };
+
+    // Fill the selected blocks with random data
+    std::vector<std::vector<char>> data_in;
+
+    {
+        std::fstream encode_file(encode_filename,
+            std::ios::binary | std::ios::in | std::ios::out);
+
+        for (auto block : blocks)
+        {
+            std::vector<char> data(partitioning.bytes_used(block));
+            std::generate(data.begin(), data.end(), rand);
+
+            encode_file.seekp(partitioning.byte_offset(block));
+            encode_file.write(data.data(), data.size());
+
+            data_in.push_back(data);
+        }
+    }
+
+    encoder_type::factory encoder_factory(max_symbols, max_symbol_size);
+    decoder_type::factory decoder_factory(max_symbols, max_symbol_size);
+
+    encoder_factory.set_filename(encode_filename);
+    decoder_factory.set_filename(decode_filename);
+    decoder_factory.set_file_size(file_size);
+
+    {
+        auto encoder = encoder_factory.build();
+        auto decoder = decoder_factory.build();
+
+        EXPECT_EQ(file_size, encoder->object_size());
+        EXPECT_EQ(file_size, decoder->object_size());
+        EXPECT_EQ(partitioning.blocks(), encoder->blocks());
+        EXPECT_EQ(partitioning.blocks(), decoder->blocks());
+
+        for (auto block : blocks)
+        {
+            auto e = encoder->build(block);
+            auto d = decoder->build(block);
+
+            std::vector<uint8_t> payload(e->payload_size());
+
+            while (!d->is_complete())
+            {
+                e->encode(payload.data());
+                d->decode(payload.data());
+            }
+
+            EXPECT_TRUE(decoder->is_block_complete(block));
+        }
+    }
+
+    EXPECT_EQ(file_size, boost::filesystem::file_size(decode_filename));
+
+    // Compare the decoded blocks with the input data
+    std::ifstream decode_file(decode_filename, std::ios::binary);
+
+    for (uint32_t i = 0; i < blocks.size(); ++i)
+    {
+        std::vector<char> data_out(data_in[i].size());
+
+        decode_file.seekg(partitioning.byte_offset(blocks[i]));
+        decode_file.read(data_out.data(), data_out.size());
+
+        EXPECT_TRUE(data_in[i] == data_out);
+    }
+
+    decode_file.close();
+}
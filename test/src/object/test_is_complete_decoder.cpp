@@ -8,6 +8,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <stub/call.hpp>
@@ -161,3 +162,44 @@ TEST(ObjectTestIsCompleteDecoder, api)
     EXPECT_TRUE(stack.is_block_complete(0U));
     EXPECT_TRUE(stack.is_block_complete(1U));
 }
+
+TEST(ObjectTestIsCompleteDecoder, block_complete_callback)
+{
+    kodo::dummy_factory factory;
+    kodo::dummy_stack stack;
+
+    stack.m_blocks.set_return(3U);
+    stack.m_build.set_return(
+        {std::make_shared<kodo::dummy_stack::stack>(),
+         std::make_shared<kodo::dummy_stack::stack>(),
+         std::make_shared<kodo::dummy_stack::stack>()}).no_repeat();
+
+    stack.initialize(factory);
+
+    std::vector<uint32_t> completed;
+    stack.set_block_complete_callback(
+        [&completed](uint32_t index) { completed.push_back(index); });
+
+    auto stack2 = stack.build(2);
+    auto stack0 = stack.build(0);
+    auto stack1 = stack.build(1);
+
+    stack2->m_callback();
+    stack0->m_callback();
+
+    EXPECT_EQ(std::vector<uint32_t>({2U, 0U}), completed);
+
+    // Re-initializing removes the callback
+    stack.m_build.set_return(
+        {std::make_shared<kodo::dummy_stack::stack>()}).no_repeat();
+
+    stack1->m_callback();
+    EXPECT_EQ(std::vector<uint32_t>({2U, 0U, 1U}), completed);
+
+    stack.initialize(factory);
+
+    stack0 = stack.build(0);
+    stack0->m_callback();
+
+    EXPECT_EQ(3U, completed.size());
+}
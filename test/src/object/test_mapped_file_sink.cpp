@@ -39,9 +39,9 @@ namespace
                 return m_filename();
             }
 
-            void set_storage(const sak::mutable_storage& storage)
+            void set_storage(uint8_t* data, uint64_t size)
             {
-                m_set_storage(storage);
+                m_set_storage(sak::storage(data, (uint32_t) size));
             }
 
             stub::call<std::string()> m_filename;
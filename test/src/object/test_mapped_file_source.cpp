@@ -48,9 +48,9 @@ namespace
             return m_file_name();
         }
 
-        void set_storage(const sak::const_storage& storage)
+        void set_storage(const uint8_t* data, uint64_t size)
         {
-            m_set_storage(storage);
+            m_set_storage(sak::storage(data, (uint32_t) size));
         }
 
         stub::call<std::string()> m_file_name;
@@ -0,0 +1,299 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_parallel_object_coder.cpp Unit tests for the
+///       parallel_object_coder class
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <gtest/gtest.h>
+
+#include <kodo/object/has_streaming_file_source.hpp>
+#include <kodo/object/parallel_object_coder.hpp>
+#include <kodo/object/storage_encoder.hpp>
+#include <kodo/object/storage_decoder.hpp>
+#include <kodo/object/streaming_file_encoder.hpp>
+#include <kodo/object/streaming_file_decoder.hpp>
+
+#include <kodo/rlnc/full_rlnc_codes.hpp>
+
+namespace
+{
+    using storage_encoder = kodo::object::storage_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary8>>;
+
+    using storage_decoder = kodo::object::storage_decoder<
+        kodo::shallow_full_rlnc_decoder<fifi::binary8>>;
+
+    /// Encodes the payloads of all the blocks on the workers of one
+    /// parallel coder and decodes them on the workers of another
+    void run_parallel_object_coder(uint32_t max_symbols,
+                                   uint32_t max_symbol_size,
+                                   uint32_t object_size,
+                                   uint32_t threads)
+    {
+        std::vector<uint8_t> data_in(object_size);
+        std::vector<uint8_t> data_out(object_size, 0);
+
+        std::generate(data_in.begin(), data_in.end(), rand);
+
+        storage_encoder::factory encoder_factory(
+            max_symbols, max_symbol_size);
+        storage_decoder::factory decoder_factory(
+            max_symbols, max_symbol_size);
+
+        encoder_factory.set_storage(sak::storage(data_in));
+        decoder_factory.set_storage(sak::storage(data_out));
+
+        kodo::object::parallel_object_coder<storage_encoder> encoder(
+            encoder_factory.build(), threads);
+
+        kodo::object::parallel_object_coder<storage_decoder> decoder(
+            decoder_factory.build(), threads);
+
+        EXPECT_EQ(threads, encoder.threads());
+        EXPECT_EQ(threads, decoder.threads());
+
+        uint32_t blocks = encoder.blocks();
+        ASSERT_EQ(blocks, decoder.blocks());
+        EXPECT_FALSE(decoder.is_complete());
+
+        // The stacks are built by the workers
+        for (uint32_t i = 0; i < blocks; ++i)
+        {
+            EXPECT_FALSE((bool) encoder.stack(i));
+            EXPECT_FALSE((bool) decoder.stack(i));
+        }
+
+        // One payload buffer per block, filled in parallel
+        std::vector<std::vector<uint8_t>> payloads(blocks);
+
+        uint32_t rounds = 0;
+
+        while (!decoder.is_complete())
+        {
+            ASSERT_LT(rounds, 10 * max_symbols);
+            ++rounds;
+
+            for (uint32_t i = 0; i < blocks; ++i)
+            {
+                std::vector<uint8_t>* payload = &payloads[i];
+
+                encoder.post(i, [payload](
+                    decltype(encoder)::stack_pointer& stack)
+                {
+                    payload->resize(stack->payload_size());
+                    stack->encode(payload->data());
+                });
+            }
+
+            encoder.wait();
+
+            for (uint32_t i = 0; i < blocks; ++i)
+            {
+                decoder.decode(i, payloads[i].data());
+            }
+
+            decoder.wait();
+        }
+
+        // The decoders are released once their blocks are decoded
+        for (uint32_t i = 0; i < blocks; ++i)
+        {
+            EXPECT_TRUE(decoder.is_block_complete(i));
+            EXPECT_FALSE((bool) decoder.stack(i));
+            EXPECT_TRUE((bool) encoder.stack(i));
+        }
+
+        // Payloads for completed blocks are dropped
+        decoder.decode(0, payloads[0].data());
+        decoder.wait();
+
+        EXPECT_TRUE(data_in == data_out);
+    }
+}
+
+/// Checks that the objects decode with different numbers of threads,
+/// including more threads than blocks
+TEST(ObjectTestParallelObjectCoder, decode)
+{
+    run_parallel_object_coder(16, 64, 23456, 1);
+    run_parallel_object_coder(16, 64, 23456, 4);
+    run_parallel_object_coder(42, 1400, 100000, 3);
+    run_parallel_object_coder(8, 32, 100, 8);
+}
+
+/// Checks that the work posted for a block runs in the order it was
+/// posted even when the block is stolen by another worker
+TEST(ObjectTestParallelObjectCoder, ordering)
+{
+    uint32_t object_size = 8 * 16 * 32;
+    std::vector<uint8_t> data_in(object_size);
+
+    storage_encoder::factory encoder_factory(16, 32);
+    encoder_factory.set_storage(sak::storage(data_in));
+
+    kodo::object::parallel_object_coder<storage_encoder> encoder(
+        encoder_factory.build(), 4);
+
+    uint32_t blocks = encoder.blocks();
+    EXPECT_EQ(8U, blocks);
+
+    std::vector<std::vector<uint32_t>> order(blocks);
+
+    for (uint32_t task = 0; task < 1000; ++task)
+    {
+        uint32_t index = task % blocks;
+        std::vector<uint32_t>* block_order = &order[index];
+
+        encoder.post(index, [block_order, task](
+            decltype(encoder)::stack_pointer&)
+        {
+            block_order->push_back(task);
+        });
+    }
+
+    encoder.wait();
+
+    for (uint32_t i = 0; i < blocks; ++i)
+    {
+        EXPECT_EQ(1000U / blocks, order[i].size());
+
+        for (uint32_t j = 1; j < order[i].size(); ++j)
+        {
+            EXPECT_LT(order[i][j - 1], order[i][j]);
+        }
+    }
+}
+
+/// Checks that an exception thrown by the work is reported by wait()
+/// and that the work posted afterwards still runs
+TEST(ObjectTestParallelObjectCoder, error)
+{
+    std::vector<uint8_t> data_in(1000);
+
+    storage_encoder::factory encoder_factory(16, 32);
+    encoder_factory.set_storage(sak::storage(data_in));
+
+    kodo::object::parallel_object_coder<storage_encoder> encoder(
+        encoder_factory.build(), 2);
+
+    encoder.post(0, [](decltype(encoder)::stack_pointer&)
+    {
+        throw std::runtime_error("failed");
+    });
+
+    EXPECT_THROW(encoder.wait(), std::runtime_error);
+    EXPECT_NO_THROW(encoder.wait());
+
+    bool done = false;
+
+    encoder.post(0, [&done](decltype(encoder)::stack_pointer&)
+    {
+        done = true;
+    });
+
+    encoder.wait();
+    EXPECT_TRUE(done);
+}
+
+/// Checks that a streaming file decoder only allocates block buffers
+/// for the blocks being decoded, since the stacks are built when the
+/// first payload of their block arrives
+TEST(ObjectTestParallelObjectCoder, streaming_file_decoder)
+{
+    using decoder_type = kodo::object::streaming_file_decoder<
+        kodo::shallow_full_rlnc_decoder<fifi::binary8>>;
+
+    uint32_t file_size = 23456;
+
+    std::vector<uint8_t> data_in(file_size);
+    std::generate(data_in.begin(), data_in.end(), rand);
+
+    boost::filesystem::path decode_filename =
+        boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("kodo-%%%%-%%%%-%%%%.bin");
+
+    {
+        storage_encoder::factory encoder_factory(16, 100);
+        encoder_factory.set_storage(sak::storage(data_in));
+
+        decoder_type::factory decoder_factory(16, 100);
+        decoder_factory.set_filename(decode_filename.string());
+        decoder_factory.set_file_size(file_size);
+
+        auto object_encoder = encoder_factory.build();
+        auto object_decoder = decoder_factory.build();
+
+        kodo::object::parallel_object_coder<decoder_type> decoder(
+            object_decoder, 4);
+
+        uint32_t blocks = object_encoder->blocks();
+        ASSERT_EQ(blocks, decoder.blocks());
+        ASSERT_GT(blocks, 3U);
+
+        EXPECT_EQ(0U, object_decoder->allocated_buffers());
+
+        // The blocks are decoded one at a time, so the buffer of a
+        // written block is reused for the next one
+        for (uint32_t i = 0; i < blocks; ++i)
+        {
+            auto encoder = object_encoder->build(i);
+            std::vector<uint8_t> payload(encoder->payload_size());
+
+            while (!decoder.is_block_complete(i))
+            {
+                encoder->encode(payload.data());
+                decoder.decode(i, payload.data());
+                decoder.wait();
+            }
+
+            object_decoder->flush();
+            EXPECT_EQ(1U, object_decoder->allocated_buffers());
+        }
+
+        EXPECT_TRUE(decoder.is_complete());
+        object_decoder->close();
+    }
+
+    std::vector<uint8_t> data_out(file_size);
+
+    {
+        std::ifstream decode_file(decode_filename.string(),
+                                  std::ios::binary);
+        decode_file.read((char*) data_out.data(), data_out.size());
+    }
+
+    boost::filesystem::remove(decode_filename);
+
+    EXPECT_TRUE(data_in == data_out);
+}
+
+/// Checks the trait rejecting the object encoders whose block encoders
+/// share a ring of buffers
+TEST(ObjectTestParallelObjectCoder, has_streaming_file_source)
+{
+    using streaming_encoder = kodo::object::streaming_file_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary8>>;
+
+    using streaming_decoder = kodo::object::streaming_file_decoder<
+        kodo::shallow_full_rlnc_decoder<fifi::binary8>>;
+
+    EXPECT_TRUE(kodo::object::has_streaming_file_source<
+                    streaming_encoder>::value);
+
+    EXPECT_FALSE(kodo::object::has_streaming_file_source<
+                     streaming_decoder>::value);
+
+    EXPECT_FALSE(kodo::object::has_streaming_file_source<
+                     storage_encoder>::value);
+}
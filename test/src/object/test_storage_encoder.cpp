@@ -146,3 +146,60 @@ TEST(ObjectTestStorageEncoder, random_blocks)
     test t(max_symbols, max_symbol_size);
     t.run();
 }
+
+/// Test that the storage decoder decodes const payloads, completing the
+/// blocks and restoring the partial last symbol, without changing the
+/// payloads
+TEST(ObjectTestStorageEncoder, const_decode)
+{
+    uint32_t max_symbols = 16;
+    uint32_t max_symbol_size = 100;
+    uint32_t object_size = 23456;
+
+    using encoder_type = kodo::object::storage_encoder<
+        kodo::shallow_full_rlnc_encoder<fifi::binary8>>;
+
+    using decoder_type = kodo::object::storage_decoder<
+        kodo::shallow_full_rlnc_decoder<fifi::binary8>>;
+
+    std::vector<uint8_t> data_in = random_vector(object_size);
+    std::vector<uint8_t> data_out(object_size, 0);
+
+    encoder_type::factory encoder_factory(max_symbols, max_symbol_size);
+    decoder_type::factory decoder_factory(max_symbols, max_symbol_size);
+
+    encoder_factory.set_storage(sak::storage(data_in));
+    decoder_factory.set_storage(sak::storage(data_out));
+
+    auto encoder = encoder_factory.build();
+    auto decoder = decoder_factory.build();
+
+    ASSERT_EQ(encoder->blocks(), decoder->blocks());
+
+    for (uint32_t i = 0; i < encoder->blocks(); ++i)
+    {
+        auto e = encoder->build(i);
+        auto d = decoder->build(i);
+
+        e->set_systematic_off();
+
+        std::vector<uint8_t> payload(e->payload_size());
+
+        while (!d->is_complete())
+        {
+            e->encode(payload.data());
+
+            std::vector<uint8_t> original = payload;
+            const uint8_t* const_payload = payload.data();
+
+            d->decode(const_payload);
+
+            EXPECT_EQ(original, payload);
+        }
+
+        EXPECT_TRUE(decoder->is_block_complete(i));
+    }
+
+    EXPECT_TRUE(decoder->is_complete());
+    EXPECT_EQ(data_in, data_out);
+}
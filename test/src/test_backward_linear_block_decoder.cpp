@@ -15,6 +15,7 @@
 #include <kodo/trace_linear_block_decoder.hpp>
 
 #include "kodo_unit_test/basic_api_test_helper.hpp"
+#include "kodo_unit_test/helper_test_blocked_backward_substitution.hpp"
 
 namespace kodo
 {
@@ -256,3 +257,10 @@ TEST(TestBackwardLinearBlockDecoder, test_decoder_delayed)
 {
     test_backward_stack<kodo::test_backward_delayed_stack>();
 }
+
+/// Checks that the blocked final backward substitution of the delayed
+/// decoder gives the same result as substituting pivot by pivot
+TEST(TestBackwardLinearBlockDecoder, test_blocked_backward_substitution)
+{
+    test_blocked_backward_substitution<kodo::test_backward_delayed_stack>();
+}
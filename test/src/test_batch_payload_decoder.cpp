@@ -0,0 +1,100 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_batch_payload_decoder.cpp Unit test for the
+///       batch_payload_decoder layer
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <stub/call.hpp>
+
+#include <kodo/batch_payload_decoder.hpp>
+
+namespace kodo
+{
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+        // Dummy layer satisfying the dependencies of
+        // batch_payload_decoder
+        class dummy_layer
+        {
+        public:
+
+            void begin_decode_batch()
+            {
+                m_begin_decode_batch();
+            }
+
+            void end_decode_batch()
+            {
+                m_end_decode_batch();
+            }
+
+            void decode(uint8_t* payload)
+            {
+                m_decode(payload);
+            }
+
+            bool is_complete() const
+            {
+                return m_is_complete();
+            }
+
+            stub::call<void()> m_begin_decode_batch;
+            stub::call<void()> m_end_decode_batch;
+            stub::call<void(uint8_t*)> m_decode;
+            stub::call<bool()> m_is_complete;
+        };
+
+        // Test stack
+        class dummy_stack : public batch_payload_decoder<dummy_layer>
+        { };
+    }
+}
+
+/// Test that all payloads are passed on inside the batch
+TEST(TestBatchPayloadDecoder, decode_batch)
+{
+    kodo::dummy_stack stack;
+    stack.m_is_complete.set_return(false);
+
+    std::vector<uint8_t> data(30);
+    std::vector<uint8_t*> payloads = {&data[0], &data[10], &data[20]};
+
+    stack.decode_batch(payloads.data(), (uint32_t) payloads.size());
+
+    EXPECT_EQ(stack.m_begin_decode_batch.calls(), 1U);
+    EXPECT_EQ(stack.m_end_decode_batch.calls(), 1U);
+
+    EXPECT_TRUE((bool) stack.m_decode.expect_calls()
+                    .with(&data[0])
+                    .with(&data[10])
+                    .with(&data[20]));
+}
+
+/// Test that the remaining payloads are skipped once the decoder is
+/// complete
+TEST(TestBatchPayloadDecoder, decode_batch_complete)
+{
+    kodo::dummy_stack stack;
+    stack.m_is_complete.set_return({false, true}).no_repeat();
+
+    std::vector<uint8_t> data(30);
+    std::vector<uint8_t*> payloads = {&data[0], &data[10], &data[20]};
+
+    stack.decode_batch(payloads.data(), (uint32_t) payloads.size());
+
+    EXPECT_EQ(stack.m_begin_decode_batch.calls(), 1U);
+    EXPECT_EQ(stack.m_end_decode_batch.calls(), 1U);
+    EXPECT_EQ(stack.m_is_complete.calls(), 2U);
+
+    EXPECT_TRUE((bool) stack.m_decode.expect_calls()
+                    .with(&data[0]));
+}
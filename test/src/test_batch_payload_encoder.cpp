@@ -0,0 +1,94 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_batch_payload_encoder.cpp Unit test for the
+///       batch_payload_encoder layer
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <stub/call.hpp>
+
+#include <kodo/batch_payload_encoder.hpp>
+
+namespace kodo
+{
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+        // Dummy layer satisfying the dependencies of
+        // batch_payload_encoder
+        class dummy_layer
+        {
+        public:
+
+            void begin_encode_batch()
+            {
+                m_begin_encode_batch();
+            }
+
+            void end_encode_batch()
+            {
+                m_end_encode_batch();
+            }
+
+            uint32_t encode(uint8_t* payload)
+            {
+                return m_encode(payload);
+            }
+
+            stub::call<void()> m_begin_encode_batch;
+            stub::call<void()> m_end_encode_batch;
+            stub::call<uint32_t(uint8_t*)> m_encode;
+        };
+
+        // Test stack
+        class dummy_stack : public batch_payload_encoder<dummy_layer>
+        { };
+    }
+}
+
+/// Test that all payloads are encoded inside the batch
+TEST(TestBatchPayloadEncoder, encode_batch)
+{
+    kodo::dummy_stack stack;
+    stack.m_encode.set_return({10U, 8U, 9U});
+
+    std::vector<uint8_t> data(30);
+    std::vector<uint8_t*> payloads = {&data[0], &data[10], &data[20]};
+    std::vector<uint32_t> bytes_used(3);
+
+    stack.encode_batch(payloads.data(), (uint32_t) payloads.size(),
+                       bytes_used.data());
+
+    EXPECT_EQ(stack.m_begin_encode_batch.calls(), 1U);
+    EXPECT_EQ(stack.m_end_encode_batch.calls(), 1U);
+
+    EXPECT_TRUE((bool) stack.m_encode.expect_calls()
+                    .with(&data[0])
+                    .with(&data[10])
+                    .with(&data[20]));
+
+    EXPECT_EQ(bytes_used, std::vector<uint32_t>({10U, 8U, 9U}));
+}
+
+/// Test that the bytes used are optional
+TEST(TestBatchPayloadEncoder, encode_batch_without_bytes_used)
+{
+    kodo::dummy_stack stack;
+    stack.m_encode.set_return(10U);
+
+    std::vector<uint8_t> data(20);
+    std::vector<uint8_t*> payloads = {&data[0], &data[10]};
+
+    stack.encode_batch(payloads.data(), (uint32_t) payloads.size(), 0);
+
+    EXPECT_EQ(stack.m_begin_encode_batch.calls(), 1U);
+    EXPECT_EQ(stack.m_end_encode_batch.calls(), 1U);
+    EXPECT_EQ(stack.m_encode.calls(), 2U);
+}
@@ -87,6 +87,10 @@ namespace
     ///   - layer::coefficients(uint32_t)
     ///   - layer::coefficients(uint32_t) const
     ///   - layer::set_coefficients(uint32_t, const sak::const_storage&)
+    ///   - layer::factory_base::coefficient_vector_alignment() const
+    ///   - layer::factory_base::set_coefficient_vector_alignment(uint32_t)
+    ///   - layer::factory_base::coefficient_vector_stride() const
+    ///   - layer::coefficient_vector_stride() const
     template<class Coder>
     struct api_coefficients_storage
     {
@@ -116,6 +120,19 @@ namespace
                 rand_symbol_size(m_factory.max_symbol_size());
 
             run_once(symbols, symbol_size);
+
+            // Change the alignment of the coefficient vectors, which
+            // must also apply to recycled coders
+            m_factory.set_coefficient_vector_alignment(64);
+            EXPECT_EQ(64U, m_factory.coefficient_vector_alignment());
+
+            run_once(symbols, symbol_size);
+
+            m_factory.set_coefficient_vector_alignment(1);
+            EXPECT_EQ(m_factory.max_coefficient_vector_size(),
+                      m_factory.coefficient_vector_stride());
+
+            run_once(symbols, symbol_size);
         }
 
         void run_once(uint32_t symbols, uint32_t symbol_size)
@@ -146,6 +163,26 @@ namespace
 
             EXPECT_EQ(length, coder->coefficient_vector_length());
 
+            // The coefficient vectors are stored in one buffer with
+            // aligned rows
+            uint32_t alignment = m_factory.coefficient_vector_alignment();
+            uint32_t stride = coder->coefficient_vector_stride();
+
+            // The pool_factory may construct the coder for a size
+            // class smaller than the maximum of the factory
+            EXPECT_TRUE(stride <= m_factory.coefficient_vector_stride());
+            EXPECT_EQ(0U, stride % alignment);
+            EXPECT_TRUE(stride >= size);
+
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                const uint8_t* data = coder->coefficient_vector_data(i);
+
+                EXPECT_EQ(coder->coefficient_vector_data(0) + i * stride,
+                          data);
+                EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(data) % alignment);
+            }
+
             /// @todo everyting should not be zero as far as I can see
             ///       the coefficient storage does not zero initialize
             ///       the coefficient vectors and it should not zero
@@ -7,10 +7,13 @@
 ///       coefficient_value_access class
 
 #include <cstdint>
+#include <cstdlib>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <fifi/binary.hpp>
 #include <fifi/binary8.hpp>
+#include <fifi/binary16.hpp>
 #include <kodo/coefficient_value_access.hpp>
 #include <kodo/storage_block_size.hpp>
 
@@ -42,6 +45,58 @@ namespace kodo
         class test_stack :
             public coefficient_value_access<test_layer<FieldType> >
         { };
+
+        /// Compares the nonzero searches against the coefficient values
+        /// for coefficient vectors of different sizes and densities
+        template<class FieldType>
+        void test_nonzero_coefficient(uint32_t symbols, uint32_t density)
+        {
+            typedef typename FieldType::value_type value_type;
+
+            test_stack<FieldType> stack;
+
+            std::vector<value_type> coefficients(
+                fifi::elements_to_length<FieldType>(symbols));
+
+            // Roughly one in density coefficients is nonzero
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                value_type value = (rand() % density) == 0 ?
+                    (value_type)(1 + rand() % FieldType::max_value) : 0;
+
+                stack.set_coefficient_value(&coefficients[0], i, value);
+            }
+
+            const value_type* c = &coefficients[0];
+
+            // Check a selection of ranges including the empty ones
+            for(uint32_t begin = 0; begin <= symbols; begin += 1 + begin / 8)
+            {
+                for(uint32_t end = begin; end <= symbols;
+                    end += 1 + (end - begin) / 4)
+                {
+                    uint32_t first = end;
+                    uint32_t last = end;
+
+                    for(uint32_t i = begin; i < end; ++i)
+                    {
+                        if(stack.coefficient_value(c, i))
+                        {
+                            if(first == end)
+                                first = i;
+
+                            last = i;
+                        }
+                    }
+
+                    EXPECT_EQ(first,
+                        stack.first_nonzero_coefficient(c, begin, end));
+
+                    EXPECT_EQ(last,
+                        stack.last_nonzero_coefficient(c, begin, end));
+                }
+            }
+        }
     }
 }
 
@@ -96,3 +151,22 @@ TEST(TestCoefficientValueAccess, api)
     }
 
 }
+
+TEST(TestCoefficientValueAccess, nonzero_coefficient)
+{
+    uint32_t sizes[] = { 1, 7, 8, 9, 63, 64, 65, 200, 1000 };
+    uint32_t densities[] = { 1, 2, 16, 100, 100000 };
+
+    for(uint32_t symbols : sizes)
+    {
+        for(uint32_t density : densities)
+        {
+            SCOPED_TRACE(testing::Message() << "symbols = " << symbols
+                         << " density = " << density);
+
+            kodo::test_nonzero_coefficient<fifi::binary>(symbols, density);
+            kodo::test_nonzero_coefficient<fifi::binary8>(symbols, density);
+            kodo::test_nonzero_coefficient<fifi::binary16>(symbols, density);
+        }
+    }
+}
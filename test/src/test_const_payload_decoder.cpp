@@ -0,0 +1,83 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_const_payload_decoder.cpp Unit test for the
+///       const_payload_decoder layer
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <stub/call.hpp>
+
+#include <kodo/const_payload_decoder.hpp>
+
+namespace kodo
+{
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+        // Dummy layer satisfying the dependencies of
+        // const_payload_decoder
+        class dummy_layer
+        {
+        public:
+
+            void begin_const_decode()
+            {
+                m_begin_const_decode();
+            }
+
+            void end_const_decode()
+            {
+                m_end_const_decode();
+            }
+
+            void decode(uint8_t* payload)
+            {
+                m_decode(payload);
+            }
+
+            stub::call<void()> m_begin_const_decode;
+            stub::call<void()> m_end_const_decode;
+            stub::call<void(uint8_t*)> m_decode;
+        };
+
+        // Test stack
+        class dummy_stack : public const_payload_decoder<dummy_layer>
+        { };
+    }
+}
+
+/// Test that a const payload is decoded in a const decode
+TEST(TestConstPayloadDecoder, decode_const)
+{
+    kodo::dummy_stack stack;
+
+    std::vector<uint8_t> payload(10);
+    const uint8_t* const_payload = payload.data();
+
+    stack.decode(const_payload);
+
+    EXPECT_EQ(stack.m_begin_const_decode.calls(), 1U);
+    EXPECT_EQ(stack.m_end_const_decode.calls(), 1U);
+    EXPECT_TRUE((bool) stack.m_decode.expect_calls().with(payload.data()));
+}
+
+/// Test that a mutable payload is decoded as usual
+TEST(TestConstPayloadDecoder, decode_mutable)
+{
+    kodo::dummy_stack stack;
+
+    std::vector<uint8_t> payload(10);
+
+    stack.decode(payload.data());
+
+    EXPECT_EQ(stack.m_begin_const_decode.calls(), 0U);
+    EXPECT_EQ(stack.m_end_const_decode.calls(), 0U);
+    EXPECT_TRUE((bool) stack.m_decode.expect_calls().with(payload.data()));
+}
@@ -7,6 +7,7 @@
 ///       kodo::default_on_systematic_encoder layer
 
 #include <cstdint>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <kodo/default_on_systematic_encoder.hpp>
@@ -69,6 +70,14 @@ namespace kodo
                 m_is_symbol_uncoded.resize(m_symbols, false);
             }
 
+            uint8_t* arena_allocate(uint32_t size)
+            {
+                m_arena.push_back(std::vector<uint8_t>(size, 0));
+                return m_arena.back().data();
+            }
+
+            std::vector<std::vector<uint8_t> > m_arena;
+
             uint32_t encode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
             {
                 (void) symbol_data;
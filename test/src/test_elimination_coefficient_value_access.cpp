@@ -54,6 +54,26 @@ namespace kodo
                 m_value = value;
             }
 
+            uint32_t first_nonzero_coefficient(
+                const value_type* coefficients, uint32_t begin,
+                uint32_t end) const
+            {
+                m_coefficients = coefficients;
+                m_index = begin;
+                m_end = end;
+                return m_found;
+            }
+
+            uint32_t last_nonzero_coefficient(
+                const value_type* coefficients, uint32_t begin,
+                uint32_t end) const
+            {
+                m_coefficients = coefficients;
+                m_index = begin;
+                m_end = end;
+                return m_found;
+            }
+
         public:
 
             uint32_t m_symbols;
@@ -62,6 +82,9 @@ namespace kodo
             mutable const value_type* m_coefficients;
             mutable uint32_t m_index;
             mutable value_type m_value;
+            mutable uint32_t m_end;
+
+            uint32_t m_found;
 
         };
 
@@ -97,4 +120,15 @@ TEST(TestEliminationCoefficientValueAccess, api)
     EXPECT_EQ(stack.m_coefficients, &buffer[0]);
     EXPECT_EQ(stack.m_index, 6U);
 
+    // Test the nonzero searches, the offset is removed from the result
+    stack.m_found = 7;
+    EXPECT_EQ(5U, stack.first_nonzero_coefficient(&buffer[0], 1, 8));
+    EXPECT_EQ(stack.m_index, 3U);
+    EXPECT_EQ(stack.m_end, 10U);
+
+    stack.m_found = 10;
+    EXPECT_EQ(8U, stack.last_nonzero_coefficient(&buffer[0], 1, 8));
+    EXPECT_EQ(stack.m_index, 3U);
+    EXPECT_EQ(stack.m_end, 10U);
+
 }
@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 
 #include <kodo/final_layer.hpp>
+#include <kodo/rlnc/full_rlnc_codes.hpp>
 
 TEST(TestFinalLayer, api)
 {
@@ -23,3 +24,105 @@ TEST(TestFinalLayer, api)
     stack.construct(factory);
     stack.initialize(factory);
 }
+
+namespace kodo
+{
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+        // Layer allocating two buffers in the arena
+        template<class SuperCoder>
+        class dummy_arena_layer : public SuperCoder
+        {
+        public:
+
+            class factory_base : public SuperCoder::factory_base
+            {
+            public:
+
+                factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                    : SuperCoder::factory_base(max_symbols, max_symbol_size)
+                { }
+
+                uint32_t arena_size() const
+                {
+                    return SuperCoder::factory_base::arena_size() +
+                        SuperCoder::factory_base::arena_region_size(10) +
+                        SuperCoder::factory_base::arena_region_size(100);
+                }
+            };
+
+        public:
+
+            template<class Factory>
+            void construct(Factory &the_factory)
+            {
+                SuperCoder::construct(the_factory);
+
+                m_first = SuperCoder::arena_allocate(10);
+                m_second = SuperCoder::arena_allocate(100);
+            }
+
+            uint8_t* m_first;
+            uint8_t* m_second;
+        };
+
+        class dummy_arena_stack : public dummy_arena_layer<final_layer>
+        { };
+    }
+}
+
+/// Tests that the buffers of the layers are carved from the arena in
+/// the order the layers are constructed
+TEST(TestFinalLayer, arena)
+{
+    uint32_t symbols = 16;
+    uint32_t symbol_size = 16;
+
+    kodo::dummy_arena_stack::factory_base factory(symbols, symbol_size);
+    kodo::dummy_arena_stack stack;
+
+    EXPECT_EQ(192U, factory.arena_size());
+
+    stack.construct(factory);
+    stack.initialize(factory);
+
+    EXPECT_EQ(192U, stack.arena_size());
+    EXPECT_EQ(192U, stack.arena_used());
+
+    uint32_t alignment = kodo::final_layer::arena_alignment;
+
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(stack.m_first) % alignment);
+    EXPECT_EQ(stack.m_first + 64, stack.m_second);
+
+    for(uint32_t i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(0U, stack.m_second[i]);
+    }
+}
+
+/// Tests that a decoder keeps the symbols, the coefficient vectors
+/// and the symbol status in its arena
+TEST(TestFinalLayer, arena_decoder)
+{
+    uint32_t symbols = 16;
+    uint32_t symbol_size = 1400;
+
+    typedef kodo::full_rlnc_decoder<fifi::binary8> decoder_type;
+
+    decoder_type::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    EXPECT_EQ(decoder_factory.arena_size(), decoder->arena_size());
+    EXPECT_EQ(decoder->arena_size(), decoder->arena_used());
+
+    // The symbols are stored first followed by the coefficient
+    // vectors
+    const uint8_t* symbol = decoder->symbol(0);
+    const uint8_t* coefficients = decoder->coefficient_vector_data(0);
+
+    EXPECT_LT(symbol, coefficients);
+    EXPECT_LT(uint32_t(coefficients - symbol), decoder->arena_size());
+}
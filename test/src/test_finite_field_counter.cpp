@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 
 #include <fifi/binary.hpp>
+#include <fifi/binary8.hpp>
 
 #include <kodo/operations_counter.hpp>
 #include <kodo/finite_field_counter.hpp>
@@ -102,6 +103,36 @@ namespace kodo
                 (void) symbol_length;
             }
 
+            /// @copydoc layer::multiply_add_n(value_type*,
+            ///              const value_type* const*, const value_type*,
+            ///              uint32_t, uint32_t)
+            void multiply_add_n(value_type *symbol_dest,
+                                const value_type * const *symbol_src,
+                                const value_type *coefficients,
+                                uint32_t count, uint32_t symbol_length)
+            {
+                (void) symbol_dest;
+                (void) symbol_src;
+                (void) coefficients;
+                (void) count;
+                (void) symbol_length;
+            }
+
+            /// @copydoc layer::multiply_subtract_n(value_type*,
+            ///              const value_type* const*, const value_type*,
+            ///              uint32_t, uint32_t)
+            void multiply_subtract_n(value_type *symbol_dest,
+                                     const value_type * const *symbol_src,
+                                     const value_type *coefficients,
+                                     uint32_t count, uint32_t symbol_length)
+            {
+                (void) symbol_dest;
+                (void) symbol_src;
+                (void) coefficients;
+                (void) count;
+                (void) symbol_length;
+            }
+
             /// @copydoc layer::invert(value_type)
             value_type invert(value_type value)
             {
@@ -155,6 +186,8 @@ void invoke_counters(Stack &stack)
     stack.subtract(dummy_ptr, dummy_ptr, dummy_length);
 
     dummy_coefficient = stack.invert(dummy_coefficient);
+
+    stack.count_bytes_saved(1U);
 }
 
 /// Run the tests for the finite field counter
@@ -188,3 +221,31 @@ TEST(TestFiniteFieldCounter, invoke_counters)
 
     test_values(counter, 0U);
 }
+
+/// Check that the fused operations are counted as the single source
+/// operations used for each coefficient
+TEST(TestFiniteFieldCounter, fused_counters)
+{
+    typedef kodo::counter_test_stack<fifi::binary8> stack_type;
+    typedef stack_type::value_type value_type;
+
+    stack_type stack;
+
+    value_type *dummy_ptr = 0;
+    const value_type *sources[3] = { 0, 0, 0 };
+    value_type coefficients[3] = { 0, 1, 2 };
+    uint32_t dummy_length = 0;
+
+    stack.multiply_add_n(dummy_ptr, sources, coefficients, 3, dummy_length);
+    stack.multiply_subtract_n(dummy_ptr, sources, coefficients, 3,
+                              dummy_length);
+
+    auto counter = stack.get_operations_counter();
+
+    EXPECT_EQ(counter.m_add, 1U);
+    EXPECT_EQ(counter.m_multiply_add, 1U);
+    EXPECT_EQ(counter.m_subtract, 1U);
+    EXPECT_EQ(counter.m_multiply_subtract, 1U);
+    EXPECT_EQ(counter.m_multiply, 0U);
+    EXPECT_EQ(counter.m_invert, 0U);
+}
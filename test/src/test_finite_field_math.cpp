@@ -0,0 +1,142 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_finite_field_math.cpp Unit tests for the
+///       kodo::finite_field_math class
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/default_field.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include <kodo/basic_factory.hpp>
+#include <kodo/final_layer.hpp>
+#include <kodo/finite_field_info.hpp>
+#include <kodo/finite_field_math.hpp>
+#include <kodo/storage_block_size.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        template<class Field>
+        class test_math_stack : public
+            finite_field_math<typename fifi::default_field<Field>::type,
+            finite_field_info<Field,
+            storage_block_size<
+            final_layer> > >
+        {
+        public:
+            using factory = basic_factory<test_math_stack>;
+        };
+
+    }
+}
+
+/// Checks that the fused operations give the same result as the
+/// corresponding sequence of single source operations
+template<class Field>
+void test_fused_operations(uint32_t sources, uint32_t symbol_size)
+{
+    typedef Field field_type;
+    typedef typename field_type::value_type value_type;
+
+    typename kodo::test_math_stack<field_type>::factory f(
+        sources, symbol_size);
+
+    auto stack = f.build();
+
+    uint32_t symbol_length =
+        fifi::size_to_length<field_type>(symbol_size);
+
+    std::vector< std::vector<value_type> > data(sources);
+    std::vector<const value_type*> source_data(sources);
+    std::vector<value_type> coefficients(sources);
+
+    for(uint32_t i = 0; i < sources; ++i)
+    {
+        data[i].resize(symbol_length);
+
+        for(auto& v : data[i])
+            v = value_type(rand()) & field_type::max_value;
+
+        source_data[i] = &data[i][0];
+
+        // Make sure zero and one are part of the coefficients
+        coefficients[i] = value_type(rand()) & field_type::max_value;
+    }
+
+    coefficients[0] = 0;
+    coefficients[sources - 1] = 1;
+
+    std::vector<value_type> initial(symbol_length);
+    for(auto& v : initial)
+        v = value_type(rand()) & field_type::max_value;
+
+    {
+        std::vector<value_type> fused = initial;
+        std::vector<value_type> expected = initial;
+
+        stack->multiply_add_n(&fused[0], &source_data[0],
+                              &coefficients[0], sources, symbol_length);
+
+        for(uint32_t i = 0; i < sources; ++i)
+        {
+            if(!coefficients[i])
+                continue;
+
+            stack->multiply_add(&expected[0], source_data[i],
+                                coefficients[i], symbol_length);
+        }
+
+        EXPECT_EQ(expected, fused);
+    }
+
+    {
+        std::vector<value_type> fused = initial;
+        std::vector<value_type> expected = initial;
+
+        stack->multiply_subtract_n(&fused[0], &source_data[0],
+                                   &coefficients[0], sources,
+                                   symbol_length);
+
+        for(uint32_t i = 0; i < sources; ++i)
+        {
+            if(!coefficients[i])
+                continue;
+
+            stack->multiply_subtract(&expected[0], source_data[i],
+                                     coefficients[i], symbol_length);
+        }
+
+        EXPECT_EQ(expected, fused);
+    }
+}
+
+/// The symbol sizes cover both a single and several destination tiles
+TEST(TestFiniteFieldMath, fused_operations)
+{
+    test_fused_operations<fifi::binary>(5, 160);
+    test_fused_operations<fifi::binary>(8, 10000);
+
+    test_fused_operations<fifi::binary8>(5, 160);
+    test_fused_operations<fifi::binary8>(8, 10000);
+
+    test_fused_operations<fifi::binary16>(5, 160);
+    test_fused_operations<fifi::binary16>(8, 10000);
+
+    test_fused_operations<fifi::prime2325>(5, 160);
+    test_fused_operations<fifi::prime2325>(8, 10000);
+}
@@ -9,12 +9,14 @@
 #include <cstdint>
 #include <gtest/gtest.h>
 
+#include <kodo/finite_field_counter.hpp>
 #include <kodo/forward_linear_block_decoder.hpp>
 #include <kodo/rlnc/full_rlnc_codes.hpp>
 
 #include <kodo/trace_linear_block_decoder.hpp>
 
 #include "kodo_unit_test/basic_api_test_helper.hpp"
+#include "kodo_unit_test/helper_test_blocked_backward_substitution.hpp"
 
 namespace kodo
 {
@@ -85,6 +87,33 @@ namespace kodo
         public:
             using factory = basic_factory<test_forward_delayed_stack>;
         };
+
+        template<class Field>
+        class test_forward_counter_stack : public
+            // Decoder API
+            forward_linear_block_decoder<
+            symbol_decoding_status_counter<
+            symbol_decoding_status_tracker<
+            // Coefficient Storage API
+            coefficient_value_access<
+            coefficient_storage<
+            coefficient_info<
+            // Storage API
+            deep_symbol_storage<
+            storage_bytes_used<
+            storage_block_length<
+            storage_block_size<
+            // Finite Field API
+            finite_field_counter<
+            finite_field_math<typename fifi::default_field<Field>::type,
+            finite_field_info<Field,
+            // Final Layer
+            final_layer
+            > > > > > > > > > > > > >
+        {
+        public:
+            using factory = basic_factory<test_forward_counter_stack>;
+        };
     }
 }
 
@@ -239,3 +268,193 @@ TEST(TestForwardLinearBlockDecoder, test_decoder_delayed)
 {
     test_forward_stack<kodo::test_forward_delayed_stack>();
 }
+
+/// Checks that deferred substitution produces the same result as the
+/// ordinary decoding and that the symbol data of a linearly dependent
+/// symbol is left untouched
+TEST(TestForwardLinearBlockDecoder, test_deferred_substitution)
+{
+    typedef fifi::binary8 field_type;
+    typedef kodo::test_forward_counter_stack<field_type> stack_type;
+
+    uint32_t symbols = 8;
+    uint32_t symbol_size = 160;
+
+    stack_type::factory f(symbols, symbol_size);
+
+    auto reference = f.build();
+    auto deferred = f.build();
+    deferred->set_deferred_substitution(true);
+
+    EXPECT_FALSE(reference->deferred_substitution());
+    EXPECT_TRUE(deferred->deferred_substitution());
+
+    std::vector<uint8_t> coefficients(reference->coefficient_vector_size());
+
+    // The coefficient vectors form a lower triangular matrix with a
+    // nonzero diagonal, so every symbol is innovative. Each symbol is
+    // reduced by all the earlier pivots before its pivot is found.
+    for(uint32_t k = 0; k < symbols; ++k)
+    {
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            fifi::set_value<field_type>(&coefficients[0], i,
+                                        i <= k ? rand_nonzero(255) : 0);
+        }
+
+        std::vector<uint8_t> symbol = random_vector(symbol_size);
+
+        std::vector<uint8_t> reference_symbol = symbol;
+        std::vector<uint8_t> reference_coefficients = coefficients;
+
+        reference->decode_symbol(&reference_symbol[0],
+                                 &reference_coefficients[0]);
+
+        deferred->decode_symbol(&symbol[0], &coefficients[0]);
+
+        EXPECT_EQ(reference->rank(), deferred->rank());
+        EXPECT_EQ(k + 1, deferred->rank());
+    }
+
+    EXPECT_TRUE(reference->is_complete());
+    EXPECT_TRUE(deferred->is_complete());
+
+    std::vector<uint8_t> reference_data(reference->block_size());
+    std::vector<uint8_t> deferred_data(deferred->block_size());
+
+    reference->copy_symbols(sak::storage(reference_data));
+    deferred->copy_symbols(sak::storage(deferred_data));
+
+    EXPECT_EQ(reference_data, deferred_data);
+
+    // Every symbol is now a pivot so any coded symbol is linearly
+    // dependent. Each nonzero coefficient would have cost an operation
+    // on the symbol data.
+    EXPECT_EQ(deferred->get_operations_counter().m_bytes_saved, 0U);
+
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        fifi::set_value<field_type>(&coefficients[0], i, rand_nonzero(255));
+    }
+
+    std::vector<uint8_t> symbol = random_vector(symbol_size);
+    std::vector<uint8_t> original_symbol = symbol;
+    std::vector<uint8_t> original_coefficients = coefficients;
+
+    deferred->decode_symbol(&symbol[0], &coefficients[0]);
+
+    EXPECT_EQ(symbol, original_symbol);
+    EXPECT_EQ(deferred->get_operations_counter().m_bytes_saved,
+              symbols * symbol_size);
+
+    reference->decode_symbol(&symbol[0], &original_coefficients[0]);
+
+    EXPECT_NE(symbol, original_symbol);
+    EXPECT_EQ(reference->get_operations_counter().m_bytes_saved, 0U);
+}
+
+/// Checks that the unit vectors of the uncoded symbols are provided
+/// when requested, also when an uncoded symbol replaces a coded
+/// symbol, and that the data is decoded correctly
+template<template <class> class Stack>
+void test_unit_vectors()
+{
+    typedef fifi::binary8 field_type;
+
+    uint32_t symbols = 6;
+    uint32_t symbol_size = 160;
+
+    typename Stack<field_type>::factory f(symbols, symbol_size);
+    auto d = f.build();
+
+    std::vector<std::vector<uint8_t> > data(symbols);
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        data[i] = random_vector(symbol_size);
+    }
+
+    std::vector<uint8_t> coefficients(d->coefficient_vector_size());
+    std::vector<uint8_t> symbol(symbol_size);
+
+    // Encodes the data with the coefficients into symbol
+    auto encode = [&]()
+    {
+        std::fill(symbol.begin(), symbol.end(), 0);
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            uint8_t c = fifi::get_value<field_type>(&coefficients[0], i);
+            d->multiply_add(&symbol[0], &data[i][0], c, symbol_size);
+        }
+    };
+
+    // A coded symbol with pivot 1 which is replaced by the uncoded
+    // symbol 1, leaving its vector in memory
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        fifi::set_value<field_type>(&coefficients[0], i, i < 1 ? 0 : 3 + i);
+    }
+    encode();
+    d->decode_symbol(&symbol[0], &coefficients[0]);
+    EXPECT_TRUE(d->is_symbol_seen(1));
+
+    symbol = data[1];
+    d->decode_symbol(&symbol[0], 1U);
+    EXPECT_TRUE(d->is_symbol_uncoded(1));
+
+    symbol = data[4];
+    d->decode_symbol(&symbol[0], 4U);
+    EXPECT_TRUE(d->is_symbol_uncoded(4));
+
+    // The vector of symbol 4 is requested through a const decoder,
+    // which must provide the unit vector as well
+    const auto& const_decoder = *d;
+
+    for(uint32_t index : {1U, 4U})
+    {
+        const uint8_t* vector = index == 1 ?
+            d->coefficient_vector_data(index) :
+            const_decoder.coefficient_vector_data(index);
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            EXPECT_EQ(i == index ? 1U : 0U,
+                      fifi::get_value<field_type>(vector, i));
+        }
+    }
+
+    while(!d->is_complete())
+    {
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            fifi::set_value<field_type>(&coefficients[0], i, rand() % 256);
+        }
+        encode();
+        d->decode_symbol(&symbol[0], &coefficients[0]);
+    }
+
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        std::vector<uint8_t> decoded(
+            d->symbol(i), d->symbol(i) + symbol_size);
+        EXPECT_EQ(data[i], decoded);
+
+        const uint8_t* vector = d->coefficient_vector_data(i);
+        for(uint32_t j = 0; j < symbols; ++j)
+        {
+            EXPECT_EQ(i == j ? 1U : 0U,
+                      fifi::get_value<field_type>(vector, j));
+        }
+    }
+}
+
+TEST(TestForwardLinearBlockDecoder, test_unit_vectors)
+{
+    test_unit_vectors<kodo::test_forward_counter_stack>();
+    test_unit_vectors<kodo::test_forward_delayed_stack>();
+}
+
+/// Checks that the blocked final backward substitution of the delayed
+/// decoder gives the same result as substituting pivot by pivot
+TEST(TestForwardLinearBlockDecoder, test_blocked_backward_substitution)
+{
+    test_blocked_backward_substitution<kodo::test_forward_delayed_stack>();
+}
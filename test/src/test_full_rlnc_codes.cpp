@@ -25,6 +25,11 @@
 #include "kodo_unit_test/helper_test_initialize_api.hpp"
 #include "kodo_unit_test/helper_test_systematic_api.hpp"
 #include "kodo_unit_test/helper_test_mix_uncoded_api.hpp"
+#include "kodo_unit_test/helper_test_batch_api.hpp"
+#include "kodo_unit_test/helper_test_encode_batch_api.hpp"
+#include "kodo_unit_test/helper_test_encode_gather_api.hpp"
+#include "kodo_unit_test/helper_test_receive_buffer_api.hpp"
+#include "kodo_unit_test/helper_test_const_decode_api.hpp"
 
 namespace
 {
@@ -104,6 +109,54 @@ TEST(TestFullRlncCodes, mix_uncoded)
     test_mix_uncoded<shallow_sparse_encoder, decoder>();
 }
 
+/// Tests that decoding batches of mixed un-coded and coded packets
+/// gives the same result as decoding the packets one at a time.
+TEST(TestFullRlncCodes, test_batch_api)
+{
+    test_batch_api<shallow_encoder, decoder>();
+    test_batch_api<encoder, decoder>();
+    test_batch_api<encoder, shallow_decoder>();
+    test_batch_api<encoder, shallow_delayed_decoder>();
+    test_batch_api<encoder, shallow_backward_decoder>();
+    test_batch_api<shallow_sparse_encoder, decoder>();
+}
+
+/// Tests that encoding batches of payloads gives the same payloads as
+/// encoding them one at a time.
+TEST(TestFullRlncCodes, test_encode_batch_api)
+{
+    test_encode_batch_api<encoder, decoder>();
+    test_encode_batch_api<shallow_encoder, shallow_decoder>();
+    test_encode_batch_api<shallow_sparse_encoder, decoder>();
+}
+
+/// Tests that the systematic packets produced by encode_gather
+/// reference the source symbols instead of copying them.
+TEST(TestFullRlncCodes, test_encode_gather_api)
+{
+    test_encode_gather_api<encoder, decoder>();
+    test_encode_gather_api<shallow_encoder, shallow_decoder>();
+    test_encode_gather_api<shallow_sparse_encoder, decoder>();
+}
+
+/// Tests that the shallow decoders decode packets received directly
+/// into their storage.
+TEST(TestFullRlncCodes, test_receive_buffer_api)
+{
+    test_receive_buffer_api<encoder, shallow_decoder>();
+    test_receive_buffer_api<encoder, shallow_delayed_decoder>();
+    test_receive_buffer_api<encoder, shallow_backward_decoder>();
+}
+
+/// Tests that decoding a const payload leaves it unchanged
+TEST(TestFullRlncCodes, test_const_decode_api)
+{
+    test_const_decode_api<encoder, decoder>();
+    test_const_decode_api<encoder, shallow_decoder>();
+    test_const_decode_api<encoder, shallow_delayed_decoder>();
+    test_const_decode_api<encoder, shallow_backward_decoder>();
+}
+
 /// The recoding
 TEST(TestFullRlncCodes, test_recoders_api)
 {
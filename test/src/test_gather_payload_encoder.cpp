@@ -0,0 +1,92 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_gather_payload_encoder.cpp Unit test for the
+///       gather_payload_encoder layer
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <stub/call.hpp>
+
+#include <kodo/gather_payload_encoder.hpp>
+
+namespace kodo
+{
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+        // Dummy layer satisfying the dependencies of
+        // gather_payload_encoder
+        class dummy_layer
+        {
+        public:
+
+            void begin_symbol_reference()
+            {
+                m_begin_symbol_reference();
+            }
+
+            const uint8_t* end_symbol_reference()
+            {
+                return m_end_symbol_reference();
+            }
+
+            uint32_t encode(uint8_t* payload)
+            {
+                return m_encode(payload);
+            }
+
+            stub::call<void()> m_begin_symbol_reference;
+            stub::call<const uint8_t*()> m_end_symbol_reference;
+            stub::call<uint32_t(uint8_t*)> m_encode;
+        };
+
+        // Test stack
+        class dummy_stack : public gather_payload_encoder<dummy_layer>
+        { };
+    }
+}
+
+/// Test that an uncoded symbol is returned by reference
+TEST(TestGatherPayloadEncoder, uncoded_symbol)
+{
+    kodo::dummy_stack stack;
+
+    std::vector<uint8_t> source(10);
+    std::vector<uint8_t> payload(12);
+
+    stack.m_encode.set_return(12U);
+    stack.m_end_symbol_reference.set_return(source.data());
+
+    const uint8_t* symbol = 0;
+    EXPECT_EQ(12U, stack.encode_gather(payload.data(), &symbol));
+    EXPECT_EQ(source.data(), symbol);
+
+    EXPECT_EQ(stack.m_begin_symbol_reference.calls(), 1U);
+    EXPECT_EQ(stack.m_end_symbol_reference.calls(), 1U);
+    EXPECT_TRUE((bool) stack.m_encode.expect_calls().with(payload.data()));
+}
+
+/// Test that a coded symbol is returned in the payload
+TEST(TestGatherPayloadEncoder, coded_symbol)
+{
+    kodo::dummy_stack stack;
+
+    std::vector<uint8_t> payload(12);
+
+    stack.m_encode.set_return(11U);
+    stack.m_end_symbol_reference.set_return((const uint8_t*) 0);
+
+    const uint8_t* symbol = 0;
+    EXPECT_EQ(11U, stack.encode_gather(payload.data(), &symbol));
+    EXPECT_EQ(payload.data(), symbol);
+
+    EXPECT_EQ(stack.m_begin_symbol_reference.calls(), 1U);
+    EXPECT_EQ(stack.m_end_symbol_reference.calls(), 1U);
+}
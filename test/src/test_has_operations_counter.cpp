@@ -0,0 +1,48 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_has_operations_counter.cpp Unit tests for the
+///       has_operations_counter class
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/has_operations_counter.hpp>
+#include <kodo/rlnc/full_rlnc_codes.hpp>
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        struct dummy
+        {
+            void get_operations_counter();
+        };
+
+        struct dummy_parent : public dummy
+        { };
+
+        struct dummy_false
+        { };
+
+    }
+}
+
+TEST(TestHasOperationsCounter, detect)
+{
+    EXPECT_FALSE(kodo::has_operations_counter<uint32_t>::value);
+    EXPECT_FALSE(kodo::has_operations_counter<kodo::dummy_false>::value);
+    EXPECT_TRUE(kodo::has_operations_counter<kodo::dummy>::value);
+    EXPECT_TRUE(kodo::has_operations_counter<kodo::dummy_parent>::value);
+
+    typedef kodo::full_rlnc_encoder<fifi::binary8> encoder_type;
+    EXPECT_FALSE(kodo::has_operations_counter<encoder_type>::value);
+}
@@ -44,9 +44,15 @@ namespace kodo
                 m_decode(payload);
             }
 
+            void decode(const uint8_t* payload)
+            {
+                m_decode_const(payload);
+            }
+
             stub::call<void()> m_initialize;
             stub::call<bool()> m_is_complete;
             stub::call<void(uint8_t*)> m_decode;
+            stub::call<void(const uint8_t*)> m_decode_const;
         };
 
         // Helper stack
@@ -153,6 +159,39 @@ TEST(TestIsCompleteCallback, callback)
 
 }
 
+/// Tests that the callback is also invoked when a const payload
+/// completes the decoding
+TEST(TestIsCompleteCallback, callback_const_decode)
+{
+    kodo::dummy_factory factory;
+    kodo::dummy_stack stack;
+
+    stack.m_is_complete.set_return(false);
+
+    const uint8_t* pointer = (const uint8_t*)0xdeadbeef;
+
+    stub::call<void()> callback;
+
+    stack.initialize(factory);
+    stack.set_is_complete_callback(std::bind(std::ref(callback)));
+
+    stack.decode(pointer);
+    EXPECT_EQ(callback.calls(), 0U);
+
+    // Trigger that we are complete
+    stack.m_is_complete.set_return(true);
+
+    stack.decode(pointer);
+    stack.decode(pointer);
+
+    EXPECT_TRUE((bool) stack.m_decode_const.expect_calls()
+                    .with(pointer)
+                    .repeat(2));
+
+    EXPECT_EQ(stack.m_decode.calls(), 0U);
+    EXPECT_EQ(callback.calls(), 1U);
+}
+
 /// Test that we can wrap an stack with the
 /// wrap_is_complete_callback_decoder layer we won't actually do
 /// anything but check that it compiles, because the
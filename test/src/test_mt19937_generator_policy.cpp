@@ -0,0 +1,63 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_mt19937_generator_policy.cpp Unit tests for the
+///       mt19937_generator_policy
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <boost/random/bernoulli_distribution.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <kodo/mt19937_generator_policy.hpp>
+
+/// Checks that the policy draws the same values as the coefficient
+/// generators did before the policies were introduced, since seed
+/// codes depend on it
+TEST(TestMt19937GeneratorPolicy, compatible)
+{
+    kodo::mt19937_generator_policy policy;
+    policy.seed(42);
+
+    boost::random::mt19937 random_generator;
+    random_generator.seed(42);
+
+    std::vector<uint8_t> data(100);
+    policy.generate(&data[0], (uint32_t) data.size());
+
+    boost::random::uniform_int_distribution<uint8_t> byte_distribution;
+
+    for (uint32_t i = 0; i < data.size(); ++i)
+    {
+        EXPECT_EQ(byte_distribution(random_generator), data[i]);
+    }
+
+    boost::random::uniform_int_distribution<uint16_t>
+        value_distribution(1, 65535);
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(value_distribution(random_generator),
+                  policy.generate_value<uint16_t>(1, 65535));
+    }
+
+    std::vector<uint8_t> mask(13);
+    policy.generate_mask(&mask[0], 100, 0.3);
+
+    boost::random::bernoulli_distribution<> bernoulli(0.3);
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        bool bit = ((mask[i / 8] >> (i % 8)) & 1) != 0;
+        EXPECT_EQ(bernoulli(random_generator), bit);
+    }
+
+    // The bits after the last one are zero
+    EXPECT_EQ(0, mask[12] >> 4);
+}
@@ -12,6 +12,7 @@
 #include <kodo/nocode/nocode_carousel_codes.hpp>
 
 #include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_encode_gather_api.hpp"
 
 namespace
 {
@@ -34,3 +35,16 @@ TEST(TestNoCodeCarouselCodes, basic_api)
 
     test_coders(symbols, symbol_size);
 }
+
+/// Tests that all the carousel packets reference the source symbols
+TEST(TestNoCodeCarouselCodes, encode_gather_api)
+{
+    // Every packet of the carousel is an uncoded symbol
+    run_test_encode_gather_api<encoder,decoder>(32, 1600, ~0U);
+    run_test_encode_gather_api<encoder,decoder>(1, 1600, ~0U);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    run_test_encode_gather_api<encoder,decoder>(symbols, symbol_size, ~0U);
+}
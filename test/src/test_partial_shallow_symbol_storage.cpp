@@ -7,6 +7,7 @@
 ///       partial_shallow_symbol_storage class
 
 #include <cstdint>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <stub/call.hpp>
@@ -43,6 +44,14 @@ namespace kodo
                 m_symbol_size.set_return(the_factory.symbol_size());
             }
 
+            uint8_t* arena_allocate(uint32_t size)
+            {
+                m_arena.push_back(std::vector<uint8_t>(size, 0));
+                return m_arena.back().data();
+            }
+
+            std::vector<std::vector<uint8_t> > m_arena;
+
             uint32_t symbol_size() const
             {
                 return m_symbol_size();
@@ -0,0 +1,125 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_philox_generator_policy.cpp Unit tests for the
+///       philox_generator_policy
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/philox_generator_policy.hpp>
+
+/// Checks the bijection against the known answers of the reference
+/// implementation
+TEST(TestPhiloxGeneratorPolicy, known_answer)
+{
+    {
+        uint32_t block[4] = { 0, 0, 0, 0 };
+        kodo::philox_generator_policy::philox4x32(block, 0, 0);
+
+        EXPECT_EQ(0x6627e8d5U, block[0]);
+        EXPECT_EQ(0xe169c58dU, block[1]);
+        EXPECT_EQ(0xbc57ac4cU, block[2]);
+        EXPECT_EQ(0x9b00dbd8U, block[3]);
+    }
+
+    {
+        uint32_t block[4] =
+            { 0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU };
+        kodo::philox_generator_policy::philox4x32(
+            block, 0xffffffffU, 0xffffffffU);
+
+        EXPECT_EQ(0x408f276dU, block[0]);
+        EXPECT_EQ(0x41c83b0eU, block[1]);
+        EXPECT_EQ(0xa20bc7c6U, block[2]);
+        EXPECT_EQ(0x6d5451fdU, block[3]);
+    }
+
+    {
+        uint32_t block[4] =
+            { 0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U };
+        kodo::philox_generator_policy::philox4x32(
+            block, 0xa4093822U, 0x299f31d0U);
+
+        EXPECT_EQ(0xd16cfe09U, block[0]);
+        EXPECT_EQ(0x94fdccebU, block[1]);
+        EXPECT_EQ(0x5001e420U, block[2]);
+        EXPECT_EQ(0x24126ea1U, block[3]);
+    }
+}
+
+/// Checks that the generated bytes are the words of the stream in
+/// little endian order, i.e. that any part of the stream can be
+/// computed directly
+TEST(TestPhiloxGeneratorPolicy, random_access)
+{
+    kodo::philox_generator_policy policy;
+    policy.seed(1234);
+
+    std::vector<uint8_t> data(70);
+    policy.generate(&data[0], (uint32_t) data.size());
+
+    for (uint32_t i = 0; i < data.size(); ++i)
+    {
+        uint32_t word = policy.word(i / 4);
+        EXPECT_EQ((uint8_t) (word >> (8 * (i % 4))), data[i]);
+    }
+
+    // The next call continues with the next block
+    std::vector<uint8_t> next(4);
+    policy.generate(&next[0], (uint32_t) next.size());
+
+    EXPECT_EQ((uint8_t) policy.word(20), next[0]);
+
+    // Seeding again restarts the stream
+    std::vector<uint8_t> again(70);
+    policy.seed(1234);
+    policy.generate(&again[0], (uint32_t) again.size());
+
+    EXPECT_EQ(data, again);
+
+    policy.seed(1235);
+    policy.generate(&again[0], (uint32_t) again.size());
+
+    EXPECT_NE(data, again);
+}
+
+/// Checks the values and masks drawn from the stream
+TEST(TestPhiloxGeneratorPolicy, generate_value)
+{
+    kodo::philox_generator_policy policy;
+
+    std::vector<uint32_t> counts(255, 0);
+
+    for (uint32_t i = 0; i < 255000; ++i)
+    {
+        uint8_t value = policy.generate_value<uint8_t>(1, 255);
+        ASSERT_GE(value, 1);
+        ++counts[value - 1];
+    }
+
+    for (uint32_t count : counts)
+    {
+        EXPECT_GT(count, 800U);
+        EXPECT_LT(count, 1200U);
+    }
+
+    uint32_t count = 1003;
+    std::vector<uint8_t> mask((count + 7) / 8, 0xff);
+    policy.generate_mask(&mask[0], count, 0.1);
+
+    uint32_t set = 0;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        set += (mask[i / 8] >> (i % 8)) & 1;
+    }
+
+    EXPECT_GT(set, 50U);
+    EXPECT_LT(set, 150U);
+    EXPECT_EQ(0, mask.back() >> (count % 8));
+}
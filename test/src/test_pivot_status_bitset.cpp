@@ -7,6 +7,7 @@
 ///       kodo::pivot_status_bitset layer
 
 #include <cstdint>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <kodo/pivot_status_bitset.hpp>
@@ -64,6 +65,14 @@ namespace kodo
             {
                 (void) the_factory;
             }
+
+            uint8_t* arena_allocate(uint32_t size)
+            {
+                m_arena.push_back(std::vector<uint8_t>(size, 0));
+                return m_arena.back().data();
+            }
+
+            std::vector<std::vector<uint8_t> > m_arena;
         };
 
 
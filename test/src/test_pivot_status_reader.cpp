@@ -7,6 +7,7 @@
 ///       kodo::pivot_status_reader layer
 
 #include <cstdint>
+#include <vector>
 #include <gtest/gtest.h>
 #include <fifi/fifi_utils.hpp>
 
@@ -69,6 +70,14 @@ namespace kodo
             {
                 (void) the_factory;
             }
+
+            uint8_t* arena_allocate(uint32_t size)
+            {
+                m_arena.push_back(std::vector<uint8_t>(size, 0));
+                return m_arena.back().data();
+            }
+
+            std::vector<std::vector<uint8_t> > m_arena;
         };
 
         // Instantiate a stack containing the pivot_status_reader
@@ -5,12 +5,15 @@
 
 /// @file test_basic_factory.cpp Unit tests for the basic_factory class
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <stub/call.hpp>
 
 #include <kodo/pool_factory.hpp>
+#include <kodo/rlnc/full_rlnc_codes.hpp>
 
 namespace kodo
 {
@@ -77,6 +80,81 @@ namespace kodo
             stub::call<void()> m_deinitialize;
 
         };
+
+        /// Helper stack with a factory supporting size classes
+        class dummy_size_class_stack
+        {
+        public:
+
+            class factory_base
+            {
+            public:
+
+                factory_base(uint32_t max_symbols, uint32_t max_symbol_size)
+                    : m_max_symbols(max_symbols),
+                      m_max_symbol_size(max_symbol_size),
+                      m_symbols(max_symbols),
+                      m_symbol_size(max_symbol_size)
+                { }
+
+                uint32_t max_symbols() const
+                {
+                    return m_max_symbols;
+                }
+
+                uint32_t max_symbol_size() const
+                {
+                    return m_max_symbol_size;
+                }
+
+                uint32_t symbols() const
+                {
+                    return m_symbols;
+                }
+
+                uint32_t symbol_size() const
+                {
+                    return m_symbol_size;
+                }
+
+                void set_symbols(uint32_t symbols)
+                {
+                    m_symbols = symbols;
+                }
+
+                void set_symbol_size(uint32_t symbol_size)
+                {
+                    m_symbol_size = symbol_size;
+                }
+
+                void set_size_class(uint32_t symbols, uint32_t symbol_size)
+                {
+                    m_max_symbols = symbols;
+                    m_max_symbol_size = symbol_size;
+                }
+
+            private:
+
+                uint32_t m_max_symbols;
+                uint32_t m_max_symbol_size;
+                uint32_t m_symbols;
+                uint32_t m_symbol_size;
+            };
+
+        public:
+
+            template<class Factory>
+            void construct(Factory& the_factory)
+            {
+                m_constructed_symbols = the_factory.max_symbols();
+                m_constructed_symbol_size = the_factory.max_symbol_size();
+            }
+
+        public:
+
+            uint32_t m_constructed_symbols;
+            uint32_t m_constructed_symbol_size;
+        };
     }
 }
 
@@ -133,3 +211,121 @@ TEST(TestPoolFactory, api)
     // We invoke the member in the deinitialize function
     EXPECT_EQ(factory.m_member.calls(), 8U);
 }
+
+TEST(TestPoolFactory, size_classes)
+{
+    kodo::pool_factory<kodo::dummy_size_class_stack> factory(1024, 1500);
+
+    auto stack_max = factory.build();
+    EXPECT_EQ(1024U, stack_max->m_constructed_symbols);
+    EXPECT_EQ(1500U, stack_max->m_constructed_symbol_size);
+
+    // The maximum values are restored after constructing
+    EXPECT_EQ(1024U, factory.max_symbols());
+    EXPECT_EQ(1500U, factory.max_symbol_size());
+
+    factory.set_symbols(20);
+    factory.set_symbol_size(100);
+
+    auto stack_small = factory.build();
+    EXPECT_EQ(32U, stack_small->m_constructed_symbols);
+    EXPECT_EQ(128U, stack_small->m_constructed_symbol_size);
+
+    EXPECT_EQ(1024U, factory.max_symbols());
+    EXPECT_EQ(1500U, factory.max_symbol_size());
+
+    // A generation of the same size class reuses the codec
+    auto small_pointer = stack_small.get();
+    stack_small.reset();
+
+    factory.set_symbols(17);
+    stack_small = factory.build();
+    EXPECT_EQ(small_pointer, stack_small.get());
+
+    // The size classes are limited by the maximum values
+    factory.set_symbols(1000);
+    factory.set_symbol_size(1400);
+
+    auto stack_large = factory.build();
+    EXPECT_EQ(1024U, stack_large->m_constructed_symbols);
+    EXPECT_EQ(1500U, stack_large->m_constructed_symbol_size);
+
+    stack_max.reset();
+
+    auto occupancy = factory.occupancy();
+    ASSERT_EQ(2U, occupancy.size());
+
+    EXPECT_EQ(32U, occupancy[0].m_symbols);
+    EXPECT_EQ(128U, occupancy[0].m_symbol_size);
+    EXPECT_EQ(1U, occupancy[0].m_total_resources);
+    EXPECT_EQ(0U, occupancy[0].m_unused_resources);
+
+    EXPECT_EQ(1024U, occupancy[1].m_symbols);
+    EXPECT_EQ(1500U, occupancy[1].m_symbol_size);
+    EXPECT_EQ(2U, occupancy[1].m_total_resources);
+    EXPECT_EQ(1U, occupancy[1].m_unused_resources);
+
+    // The pool of the maximum values is the one returned by pool()
+    EXPECT_EQ(2U, factory.pool().total_resources());
+}
+
+TEST(TestPoolFactory, size_classes_codes)
+{
+    using encoder_type = kodo::full_rlnc_encoder<fifi::binary8>;
+    using decoder_type = kodo::full_rlnc_decoder<fifi::binary8>;
+
+    uint32_t max_symbols = 1024;
+    uint32_t max_symbol_size = 1500;
+
+    encoder_type::factory encoder_factory(max_symbols, max_symbol_size);
+    decoder_type::factory decoder_factory(max_symbols, max_symbol_size);
+
+    for (uint32_t symbols : {16U, 40U, 64U, 16U})
+    {
+        SCOPED_TRACE(testing::Message() << "symbols = " << symbols);
+
+        encoder_factory.set_symbols(symbols);
+        decoder_factory.set_symbols(symbols);
+
+        auto encoder = encoder_factory.build();
+        auto decoder = decoder_factory.build();
+
+        EXPECT_EQ(symbols, encoder->symbols());
+        EXPECT_EQ(symbols, decoder->symbols());
+
+        std::vector<uint8_t> data_in(encoder->block_size());
+        std::generate(data_in.begin(), data_in.end(), rand);
+
+        encoder->set_symbols(sak::storage(data_in));
+
+        std::vector<uint8_t> payload(encoder->payload_size());
+
+        while (!decoder->is_complete())
+        {
+            encoder->encode(payload.data());
+            decoder->decode(payload.data());
+        }
+
+        std::vector<uint8_t> data_out(decoder->block_size());
+        decoder->copy_symbols(sak::storage(data_out));
+
+        EXPECT_TRUE(data_in == data_out);
+    }
+
+    // The generations of 40 and 64 symbols share the size class of
+    // 64 symbols, and the codecs were recycled between the builds
+    auto occupancy = decoder_factory.occupancy();
+    ASSERT_EQ(3U, occupancy.size());
+
+    EXPECT_EQ(16U, occupancy[0].m_symbols);
+    EXPECT_EQ(1U, occupancy[0].m_total_resources);
+    EXPECT_EQ(1U, occupancy[0].m_unused_resources);
+
+    EXPECT_EQ(64U, occupancy[1].m_symbols);
+    EXPECT_EQ(1U, occupancy[1].m_total_resources);
+    EXPECT_EQ(1U, occupancy[1].m_unused_resources);
+
+    // The pool of the maximum values is created up front but unused
+    EXPECT_EQ(1024U, occupancy[2].m_symbols);
+    EXPECT_EQ(0U, occupancy[2].m_total_resources);
+}
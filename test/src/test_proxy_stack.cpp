@@ -4,6 +4,7 @@
 // http://www.steinwurf.com/licensing
 
 #include <cstdint>
+#include <memory>
 #include <gtest/gtest.h>
 #include <fifi/binary8.hpp>
 
@@ -32,6 +33,7 @@ namespace kodo
         public:
             typedef fifi::binary8 field_type;
             typedef field_type::value_type value_type;
+            typedef std::allocator<uint8_t> allocator_type;
         };
 
         /// This stack is the proxy stack i.e. the stack which is
@@ -7,6 +7,7 @@
 ///       kodo::rank_symbol_decoding_status_updater
 
 #include <cstdint>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <kodo/rank_symbol_decoding_status_updater.hpp>
@@ -41,6 +42,12 @@ namespace kodo
                 m_symbols = the_factory.symbols();
             }
 
+            uint8_t* arena_allocate(uint32_t size)
+            {
+                m_arena.push_back(std::vector<uint8_t>(size, 0));
+                return m_arena.back().data();
+            }
+
             void decode(uint8_t *payload)
             {
                 m_payload = payload;
@@ -65,6 +72,8 @@ namespace kodo
             uint32_t m_rank;
             uint32_t m_remote_rank;
             uint32_t m_symbols;
+
+            std::vector<std::vector<uint8_t> > m_arena;
         };
 
         // Instantiate a stack containing the
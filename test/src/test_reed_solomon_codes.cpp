@@ -3,12 +3,15 @@
 // See accompanying file LICENSE.rst or
 // http://www.steinwurf.com/licensing
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <kodo/reed_solomon/reed_solomon_codes.hpp>
 
 #include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_encode_batch_api.hpp"
 
 namespace
 {
@@ -21,6 +24,56 @@ namespace
     using encoder8 = encoder<fifi::binary8>;
 
     using decoder8 = decoder<fifi::binary8>;
+
+    template<class Field>
+    using erasure_decoder =
+        kodo::reed_solomon_erasure_decoder<Field, kodo::disable_trace>;
+
+    using erasure_decoder8 = erasure_decoder<fifi::binary8>;
+
+    /// Encodes a block, drops the systematic symbols in lost and
+    /// decodes from the remaining systematic symbols and the first
+    /// repair symbols
+    template<class Encoder, class Decoder>
+    void run_erasure_pattern(typename Encoder::factory& encoder_factory,
+                             typename Decoder::factory& decoder_factory,
+                             const std::vector<uint32_t>& lost)
+    {
+        auto encoder = encoder_factory.build();
+        auto decoder = decoder_factory.build();
+
+        std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+        encoder->set_symbols(sak::storage(data_in));
+
+        std::vector<uint8_t> payload(encoder->payload_size());
+
+        for(uint32_t i = 0; !decoder->is_complete(); ++i)
+        {
+            ASSERT_TRUE(i < 2 * encoder->symbols());
+
+            encoder->encode(&payload[0]);
+
+            if(std::find(lost.begin(), lost.end(), i) != lost.end())
+                continue;
+
+            decoder->decode(&payload[0]);
+
+            // The missing symbols are only rebuilt once k symbols
+            // have been received
+            if(i + 1 < encoder->symbols() + lost.size())
+            {
+                EXPECT_FALSE(decoder->is_complete());
+            }
+        }
+
+        EXPECT_EQ(0U, decoder->repair_symbols());
+
+        std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+        decoder->copy_symbols(sak::storage(data_out));
+
+        EXPECT_TRUE(std::equal(data_out.begin(), data_out.end(),
+                               data_in.begin()));
+    }
 }
 
 TEST(TestReedSolomonCodes, test_basic_api)
@@ -34,3 +87,74 @@ TEST(TestReedSolomonCodes, test_basic_api)
 
     run_test_basic_api<encoder8,decoder8>(255, 1600);
 }
+
+TEST(TestReedSolomonCodes, test_encode_batch_api)
+{
+    run_test_encode_batch_api<encoder8,decoder8>(32, 8000, 16);
+    run_test_encode_batch_api<encoder8,erasure_decoder8>(100, 160, 7);
+}
+
+TEST(TestReedSolomonCodes, test_erasure_decoder_basic_api)
+{
+    run_test_basic_api<encoder8,erasure_decoder8>(255, 1600);
+}
+
+TEST(TestReedSolomonCodes, test_erasure_decoder_patterns)
+{
+    uint32_t symbols = 16;
+    uint32_t symbol_size = 160;
+
+    encoder8::factory encoder_factory(symbols, symbol_size);
+    erasure_decoder8::factory decoder_factory(symbols, symbol_size);
+
+    auto cache = decoder_factory.pattern_cache();
+    EXPECT_EQ(32U, decoder_factory.cache_capacity());
+
+    // No losses needs no decoding matrix
+    run_erasure_pattern<encoder8,erasure_decoder8>(
+        encoder_factory, decoder_factory, {});
+    EXPECT_EQ(0U, cache->size());
+
+    run_erasure_pattern<encoder8,erasure_decoder8>(
+        encoder_factory, decoder_factory, {0, 5, 15});
+    EXPECT_EQ(1U, cache->size());
+    EXPECT_EQ(0U, cache->hits());
+
+    // The same pattern is served from the cache
+    run_erasure_pattern<encoder8,erasure_decoder8>(
+        encoder_factory, decoder_factory, {0, 5, 15});
+    EXPECT_EQ(1U, cache->size());
+    EXPECT_EQ(1U, cache->hits());
+
+    // Losing repair symbols changes the rows used
+    run_erasure_pattern<encoder8,erasure_decoder8>(
+        encoder_factory, decoder_factory, {3, 16});
+    EXPECT_EQ(2U, cache->size());
+
+    // All systematic symbols lost
+    std::vector<uint32_t> lost;
+    for(uint32_t i = 0; i < symbols; ++i)
+        lost.push_back(i);
+
+    run_erasure_pattern<encoder8,erasure_decoder8>(
+        encoder_factory, decoder_factory, lost);
+    EXPECT_EQ(3U, cache->size());
+
+    // The least recently used patterns are evicted
+    decoder_factory.set_cache_capacity(1);
+    EXPECT_EQ(1U, cache->size());
+
+    run_erasure_pattern<encoder8,erasure_decoder8>(
+        encoder_factory, decoder_factory, {0, 5, 15});
+    EXPECT_EQ(1U, cache->hits());
+    EXPECT_EQ(1U, cache->size());
+
+    // A different number of symbols is a different pattern
+    encoder_factory.set_symbols(8);
+    decoder_factory.set_symbols(8);
+
+    run_erasure_pattern<encoder8,erasure_decoder8>(
+        encoder_factory, decoder_factory, {0, 5});
+    EXPECT_EQ(1U, cache->hits());
+    EXPECT_EQ(1U, cache->size());
+}
@@ -39,6 +39,11 @@ namespace kodo
                 m_decode(payload);
             }
 
+            void decode(const uint8_t *payload)
+            {
+                m_decode_const(payload);
+            }
+
             bool is_complete()
             {
                 return m_is_complete();
@@ -56,6 +61,7 @@ namespace kodo
 
             stub::call<void()> m_initialize;
             stub::call<void(uint8_t*)> m_decode;
+            stub::call<void(const uint8_t*)> m_decode_const;
             stub::call<bool()> m_is_complete;
             stub::call<bool()> m_has_partial_symbol;
             stub::call<void()> m_restore_partial_symbol;
@@ -132,6 +138,33 @@ TEST(TestRestorePartialSymbolDecoder, restore)
     EXPECT_EQ(stack.m_decode.calls(), 3U);
 }
 
+/// Tests that the partial symbol is also restored when a const
+/// payload completes the decoding
+TEST(TestRestorePartialSymbolDecoder, restore_const_decode)
+{
+    kodo::dummy_factory factory;
+    kodo::dummy_stack stack;
+
+    stack.initialize(factory);
+
+    stack.m_is_complete.set_return(false);
+    stack.m_has_partial_symbol.set_return(true);
+
+    // dummy variables
+    const uint8_t* pointer = (const uint8_t*)0xdeadbeef;
+
+    stack.decode(pointer);
+    EXPECT_EQ(stack.m_restore_partial_symbol.calls(), 0U);
+
+    stack.m_is_complete.set_return(true);
+
+    stack.decode(pointer);
+    stack.decode(pointer);
+    EXPECT_EQ(stack.m_restore_partial_symbol.calls(), 1U);
+    EXPECT_EQ(stack.m_decode_const.calls(), 3U);
+    EXPECT_EQ(stack.m_decode.calls(), 0U);
+}
+
 /// Test that we can wrap an stack with the
 /// wrap_restore_partial_symbol_decoder layer we won't actually do
 /// anything but check that it compiles, because the
@@ -85,3 +85,38 @@ TEST(TestRfc5052PartitioningScheme, partition_size)
         ASSERT_TRUE(partitioning.symbols(i-1) >= partitioning.symbols(i));
     }
 }
+
+TEST(TestRfc5052PartitioningScheme, partition_large_object)
+{
+    // An object larger than 4 GB must give offsets and sizes beyond
+    // the range of 32 bit integers
+    uint32_t max_symbols = 64;
+    uint32_t max_symbol_size = 1400;
+    uint64_t object_size = 10ULL * 1024 * 1024 * 1024 + 12345;
+
+    kodo::rfc5052_partitioning_scheme partitioning(
+        max_symbols, max_symbol_size, object_size);
+
+    EXPECT_EQ(object_size, partitioning.object_size());
+    EXPECT_EQ((object_size - 1) / max_symbol_size + 1,
+              partitioning.total_symbols());
+    EXPECT_TRUE(partitioning.total_block_size() >= object_size);
+
+    uint32_t blocks = partitioning.blocks();
+    ASSERT_TRUE(blocks > 0);
+
+    // The blocks must be contiguous and cover the whole object
+    uint64_t offset = 0;
+    for(uint32_t i = 0; i < blocks; ++i)
+    {
+        ASSERT_EQ(offset, partitioning.byte_offset(i));
+        offset += partitioning.block_size(i);
+    }
+
+    EXPECT_EQ(partitioning.total_block_size(), offset);
+
+    uint32_t last = blocks - 1;
+    EXPECT_TRUE(partitioning.byte_offset(last) > (1ULL << 32));
+    EXPECT_EQ(object_size,
+              partitioning.byte_offset(last) + partitioning.bytes_used(last));
+}
@@ -15,6 +15,7 @@
 #include <kodo/reed_solomon/transpose_vandermonde_matrix.hpp>
 #include <kodo/reed_solomon/vandermonde_matrix.hpp>
 #include <kodo/reed_solomon/systematic_vandermonde_matrix.hpp>
+#include <kodo/reed_solomon/shared_systematic_vandermonde_matrix.hpp>
 #include <kodo/finite_field_math.hpp>
 #include <kodo/finite_field_info.hpp>
 #include <kodo/final_layer.hpp>
@@ -74,6 +75,19 @@ namespace kodo
         public:
             using factory = basic_factory<systematic_vandermonde_stack>;
         };
+
+        template<class Field>
+        class shared_systematic_vandermonde_stack : public
+            shared_systematic_vandermonde_matrix<
+            finite_field_math<typename fifi::default_field<Field>::type,
+            finite_field_info<Field,
+            final_layer
+            > > >
+        {
+        public:
+            using factory =
+                basic_factory<shared_systematic_vandermonde_stack>;
+        };
     }
 }
 
@@ -148,6 +162,92 @@ TEST(TestVandermondeMatrix, test_matrix_values)
         runner.run(symbols, test_rs8_10_systematic);
     }
 
+    {
+        typedef api_construct_matrix<
+            kodo::shared_systematic_vandermonde_stack<field_type> > test;
+
+        test runner(symbols, symbol_size);
+        runner.run(symbols, test_rs8_10_systematic);
+    }
+
+}
+
+/// Checks that the lazily computed rows match the eliminated
+/// systematic matrix
+template<class Field>
+void test_shared_matrix(uint32_t symbols)
+{
+    typedef typename Field::value_type value_type;
+
+    typename kodo::systematic_vandermonde_stack<Field>::factory
+        factory(symbols, 10);
+
+    typename kodo::shared_systematic_vandermonde_stack<Field>::factory
+        shared_factory(symbols, 10);
+
+    auto expected = factory.construct_matrix(symbols);
+    auto matrix = shared_factory.construct_matrix(symbols);
+
+    ASSERT_EQ(expected->rows(), matrix->rows());
+    ASSERT_EQ(expected->columns(), matrix->columns());
+    ASSERT_EQ(expected->row_size(), matrix->row_size());
+
+    for(uint32_t i = 0; i < matrix->rows(); ++i)
+    {
+        for(uint32_t j = 0; j < symbols; ++j)
+        {
+            value_type value = expected->element(i, j);
+            ASSERT_EQ(value, matrix->element(i, j));
+        }
+    }
+}
+
+TEST(TestVandermondeMatrix, test_shared_matrix_values)
+{
+    test_shared_matrix<fifi::binary4>(1);
+    test_shared_matrix<fifi::binary4>(7);
+    test_shared_matrix<fifi::binary4>(14);
+
+    test_shared_matrix<fifi::binary8>(1);
+    test_shared_matrix<fifi::binary8>(32);
+    test_shared_matrix<fifi::binary8>(rand_symbols(254));
+}
+
+TEST(TestVandermondeMatrix, test_shared_matrix_lazy)
+{
+    typedef kodo::shared_systematic_vandermonde_stack<fifi::binary16>
+        stack_type;
+
+    uint32_t symbols = 600;
+
+    stack_type::factory factory_a(symbols, 10);
+    stack_type::factory factory_b(symbols, 10);
+
+    // The matrix is shared between factories
+    auto matrix = factory_a.construct_matrix(symbols);
+    EXPECT_EQ(matrix, factory_b.construct_matrix(symbols));
+    EXPECT_NE(matrix, factory_a.construct_matrix(symbols - 1));
+
+    EXPECT_EQ(65535U, matrix->rows());
+    EXPECT_EQ(symbols, matrix->columns());
+
+    uint32_t built = matrix->built_rows();
+
+    // The systematic rows are unit vectors
+    EXPECT_EQ(1U, matrix->element(3, 3));
+    EXPECT_EQ(0U, matrix->element(3, 4));
+
+    // Only the requested rows are computed
+    const uint8_t* row = matrix->row(60000);
+    EXPECT_EQ(row, matrix->row(60000));
+    EXPECT_EQ(built + 2, matrix->built_rows());
+
+    // The repair row combines all the source symbols, since any
+    // k columns of an MDS generator matrix are independent
+    for(uint32_t j = 0; j < symbols; ++j)
+    {
+        EXPECT_NE(0U, matrix->element(60000, j));
+    }
 }
 
 
@@ -0,0 +1,152 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_scatter_payload_decoder.cpp Unit test for the
+///       scatter_payload_decoder layer
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <stub/call.hpp>
+
+#include <kodo/scatter_payload_decoder.hpp>
+
+namespace kodo
+{
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+        // Dummy layer satisfying the dependencies of
+        // scatter_payload_decoder
+        class dummy_layer
+        {
+        public:
+
+            uint32_t symbols() const
+            {
+                return m_symbols();
+            }
+
+            bool is_symbol_missing(uint32_t index) const
+            {
+                return m_is_symbol_missing(index);
+            }
+
+            uint32_t next_symbol_missing(uint32_t index) const
+            {
+                return m_next_symbol_missing(index);
+            }
+
+            uint32_t next_symbol_uncoded(uint32_t index) const
+            {
+                return m_next_symbol_uncoded(index);
+            }
+
+            uint8_t* symbol(uint32_t index)
+            {
+                return m_symbol(index);
+            }
+
+            void decode(uint8_t* symbol_data, uint8_t* header)
+            {
+                m_decode(symbol_data, header);
+            }
+
+            stub::call<uint32_t()> m_symbols;
+            stub::call<bool(uint32_t)> m_is_symbol_missing;
+            stub::call<uint32_t(uint32_t)> m_next_symbol_missing;
+            stub::call<uint32_t(uint32_t)> m_next_symbol_uncoded;
+            stub::call<uint8_t*(uint32_t)> m_symbol;
+            stub::call<void(uint8_t*,uint8_t*)> m_decode;
+        };
+
+        // Test stack
+        class dummy_stack : public scatter_payload_decoder<dummy_layer>
+        { };
+    }
+}
+
+/// Test that the receive buffer is the first missing symbol if the
+/// next systematic symbol is not missing
+TEST(TestScatterPayloadDecoder, receive_buffer)
+{
+    kodo::dummy_stack stack;
+
+    std::vector<uint8_t> data(10);
+
+    stack.m_symbols.set_return(5U);
+    stack.m_is_symbol_missing.set_return(false);
+    stack.m_next_symbol_missing.set_return({3U, 5U});
+    stack.m_symbol.set_return(&data[6]);
+
+    EXPECT_EQ(&data[6], stack.receive_buffer());
+    EXPECT_TRUE((bool) stack.m_symbol.expect_calls().with(3U));
+
+    // No symbols are missing
+    EXPECT_TRUE(stack.receive_buffer() == 0);
+    EXPECT_EQ(1U, stack.m_symbol.calls());
+
+    EXPECT_TRUE((bool) stack.m_next_symbol_missing.expect_calls()
+                    .with(0U)
+                    .with(0U));
+
+    EXPECT_TRUE((bool) stack.m_is_symbol_missing.expect_calls()
+                    .with(0U)
+                    .with(0U));
+}
+
+/// Test that the receive buffer follows the last uncoded symbol
+/// received, also when the symbols before it are missing
+TEST(TestScatterPayloadDecoder, receive_buffer_next_systematic)
+{
+    kodo::dummy_stack stack;
+
+    std::vector<uint8_t> data(10);
+    std::vector<uint8_t> header(4);
+
+    stack.m_symbols.set_return(5U);
+    stack.m_is_symbol_missing.set_return(true);
+    stack.m_symbol.set_return(&data[6]);
+
+    // Symbol 1 is lost and symbol 2 is received
+    stack.m_next_symbol_uncoded.set_return(2U);
+    stack.decode_scatter(&data[0], header.data());
+
+    EXPECT_TRUE((bool) stack.m_next_symbol_uncoded.expect_calls()
+                    .with(0U));
+
+    EXPECT_EQ(&data[6], stack.receive_buffer());
+
+    EXPECT_TRUE((bool) stack.m_is_symbol_missing.expect_calls().with(3U));
+    EXPECT_TRUE((bool) stack.m_symbol.expect_calls().with(3U));
+    EXPECT_EQ(0U, stack.m_next_symbol_missing.calls());
+
+    // A coded symbol leaves the expected symbol unchanged
+    stack.m_next_symbol_uncoded.set_return(5U);
+    stack.decode_scatter(&data[0], header.data());
+
+    EXPECT_EQ(&data[6], stack.receive_buffer());
+    EXPECT_TRUE((bool) stack.m_symbol.expect_calls().with(3U).with(3U));
+}
+
+/// Test that the symbol data and header are decoded as they are
+TEST(TestScatterPayloadDecoder, decode_scatter)
+{
+    kodo::dummy_stack stack;
+
+    std::vector<uint8_t> symbol_data(10);
+    std::vector<uint8_t> header(4);
+
+    stack.m_symbols.set_return(5U);
+    stack.m_next_symbol_uncoded.set_return(5U);
+
+    stack.decode_scatter(symbol_data.data(), header.data());
+
+    EXPECT_TRUE((bool) stack.m_decode.expect_calls()
+                    .with(symbol_data.data(), header.data()));
+}
@@ -17,6 +17,8 @@
 #include "kodo_unit_test/helper_test_initialize_api.hpp"
 #include "kodo_unit_test/helper_test_systematic_api.hpp"
 #include "kodo_unit_test/helper_test_mix_uncoded_api.hpp"
+#include "kodo_unit_test/helper_test_encode_batch_api.hpp"
+#include "kodo_unit_test/helper_test_const_decode_api.hpp"
 
 /// Define the stacks we will test
 namespace
@@ -26,6 +28,14 @@ namespace
 
     template<class Field>
     using decoder = kodo::seed_rlnc_decoder<Field, kodo::disable_trace>;
+
+    template<class Field>
+    using fast_encoder =
+        kodo::fast_seed_rlnc_encoder<Field, kodo::disable_trace>;
+
+    template<class Field>
+    using fast_decoder =
+        kodo::fast_seed_rlnc_decoder<Field, kodo::disable_trace>;
 }
 
 /// Tests the basic API functionality this mean basic encoding
@@ -70,3 +80,37 @@ TEST(TestSeedRlncCodes, test_reuse_incomplete_api)
 {
     test_reuse_incomplete<encoder,decoder>();
 }
+
+/// Tests the basic API functionality of the seed codes using the
+/// counter based generator
+TEST(TestSeedRlncCodes, test_fast_basic_api)
+{
+    test_basic_api<fast_encoder,fast_decoder>();
+}
+
+/// Tests that the fast seed codes can be safely reused
+TEST(TestSeedRlncCodes, test_fast_initialize_api)
+{
+    test_initialize<fast_encoder,fast_decoder>();
+}
+
+/// Tests the fast seed codes with systematic packets
+TEST(TestSeedRlncCodes, test_fast_systematic_api)
+{
+    test_systematic<fast_encoder,fast_decoder>();
+}
+
+/// Tests that encoding batches of payloads gives the same payloads as
+/// encoding them one at a time.
+TEST(TestSeedRlncCodes, test_encode_batch_api)
+{
+    test_encode_batch_api<encoder,decoder>();
+    test_encode_batch_api<fast_encoder,fast_decoder>();
+}
+
+/// Tests that decoding a const payload leaves it unchanged
+TEST(TestSeedRlncCodes, test_const_decode_api)
+{
+    test_const_decode_api<encoder,decoder>();
+    test_const_decode_api<fast_encoder,fast_decoder>();
+}
@@ -51,6 +51,56 @@ namespace kodo
         public:
             using factory = pool_factory<sparse_uniform_generator_stack_pool>;
         };
+
+        /// Codec layer where every third symbol, starting from
+        /// symbol 1, is not a pivot
+        template<class SuperCoder>
+        class fixed_pivot_codec_layer : public SuperCoder
+        {
+        public:
+
+            /// @copydoc layer::is_symbol_pivot(uint32_t) const
+            bool is_symbol_pivot(uint32_t index) const
+            {
+                assert(index < SuperCoder::symbols());
+                return index % 3 != 1;
+            }
+        };
+
+        // Sparse uniform generator with known pivots
+        template<class Field>
+        class sparse_uniform_generator_fixed_pivot_stack : public
+            sparse_uniform_generator<
+            fixed_pivot_codec_layer<
+            coefficient_info<
+            fake_symbol_storage<
+            storage_block_length<
+            storage_block_size<
+            finite_field_info<Field,
+            final_layer
+            > > > > > > >
+        {
+        public:
+            using factory =
+                basic_factory<sparse_uniform_generator_fixed_pivot_stack>;
+        };
+
+        // Fast sparse uniform generator
+        template<class Field>
+        class fast_sparse_uniform_generator_stack : public
+            fast_sparse_uniform_generator<
+            fake_codec_layer<
+            coefficient_info<
+            fake_symbol_storage<
+            storage_block_length<
+            storage_block_size<
+            finite_field_info<Field,
+            final_layer
+            > > > > > > >
+        {
+        public:
+            using factory = basic_factory<fast_sparse_uniform_generator_stack>;
+        };
     }
 }
 
@@ -182,6 +232,10 @@ TEST(TestCoefficientGenerator, sparse_uniform_generator_stack)
     run_test<
         kodo::sparse_uniform_generator_stack_pool,
         api_generate>(symbols, symbol_size);
+
+    run_test<
+        kodo::fast_sparse_uniform_generator_stack,
+        api_generate>(symbols, symbol_size);
 }
 
 
@@ -199,4 +253,75 @@ TEST(TestCoefficientGenerator, density_sparse_uniform_generator_stack)
     run_test<
         kodo::sparse_uniform_generator_stack_pool,
         api_density>(symbols, symbol_size);
+
+    run_test<
+        kodo::fast_sparse_uniform_generator_stack,
+        api_density>(symbols, symbol_size);
+}
+
+/// Generates two vectors with the sparse_uniform_generator from a fixed
+/// seed and compares the coefficients with the expected ones
+/// @param partial True to use generate_partial()
+/// @param expected The expected coefficients of the two vectors
+template<class Field>
+void check_known_sparse_vectors(
+    bool partial, const std::vector<std::vector<uint32_t> >& expected)
+{
+    typedef kodo::sparse_uniform_generator_fixed_pivot_stack<Field>
+        stack_type;
+
+    typename stack_type::factory factory(20, 100);
+    auto coder = factory.build();
+
+    coder->set_density(0.4);
+    coder->seed(1234);
+
+    std::vector<uint8_t> vector(coder->coefficient_vector_size());
+
+    for (const auto& values : expected)
+    {
+        if (partial)
+            coder->generate_partial(&vector[0]);
+        else
+            coder->generate(&vector[0]);
+
+        ASSERT_EQ(20U, values.size());
+
+        for (uint32_t i = 0; i < values.size(); ++i)
+        {
+            EXPECT_EQ(values[i], (uint32_t) fifi::get_value<Field>(
+                reinterpret_cast<const typename Field::value_type*>(
+                    &vector[0]), i)) << "index " << i;
+        }
+    }
+}
+
+/// The sparse_uniform_generator is used by the seed codes, so a seed
+/// must give the coefficients drawn by earlier versions, which drew a
+/// value right after each nonzero position and skipped the positions
+/// of non-pivots in generate_partial()
+TEST(TestCoefficientGenerator, sparse_uniform_generator_known_answer)
+{
+    check_known_sparse_vectors<fifi::binary>(false,
+        {{1,0,0,0,0,0,0,0,0,0,1,1,1,1,0,0,0,1,0,1},
+         {1,1,0,0,0,1,0,0,1,1,0,1,0,0,1,1,0,1,0,1}});
+
+    check_known_sparse_vectors<fifi::binary8>(false,
+        {{0x7f,0,0,0,0,0,0,0,0,0x27,0x33,0,0,0,0xe0,0x5c,0x80,0,0,0xb6},
+         {0,0x1a,0,0x81,0,0x06,0,0xe2,0x5e,0,0,0,0xfc,0x1e,0,0xa7,0,0x8a,
+          0,0}});
+
+    check_known_sparse_vectors<fifi::binary16>(false,
+        {{0x7f67,0,0,0,0,0,0,0,0,0x2690,0x32d2,0,0,0,0xe03d,0x5b9a,0x8041,
+          0,0,0xb673},
+         {0,0x1927,0,0x80ca,0,0x05ac,0,0xe1f4,0x5d69,0,0,0,0xfcb5,0x1e11,
+          0,0xa6c1,0,0x89c4,0,0}});
+
+    check_known_sparse_vectors<fifi::binary>(true,
+        {{1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,1,1,0},
+         {1,0,0,0,0,0,1,0,0,1,0,1,1,0,0,0,0,0,1,0}});
+
+    check_known_sparse_vectors<fifi::binary8>(true,
+        {{0x7f,0,0,0,0,0,0,0,0,0,0,0,0,0,0x27,0x33,0,0,0,0},
+         {0,0,0xe0,0x5c,0,0x80,0,0,0,0xb6,0,0,0x1a,0,0,0x81,0,0,0x06,0}});
 }
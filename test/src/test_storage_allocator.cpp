@@ -0,0 +1,236 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_storage_allocator.cpp Unit tests for the storage_allocator
+///       layer and the allocators which may be used with it
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <kodo/storage_allocator.hpp>
+#include <kodo/huge_page_allocator.hpp>
+#include <kodo/numa_local_allocator.hpp>
+#include <kodo/final_layer.hpp>
+#include <kodo/rlnc/full_rlnc_codes.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+#include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_recoding_api.hpp"
+
+namespace
+{
+    template<class Field>
+    using huge_page_encoder = kodo::full_rlnc_encoder<
+        Field, kodo::disable_trace, kodo::huge_page_allocator<uint8_t> >;
+
+    template<class Field>
+    using huge_page_decoder = kodo::full_rlnc_decoder<
+        Field, kodo::disable_trace, kodo::huge_page_allocator<uint8_t> >;
+
+    template<class Field>
+    using numa_local_encoder = kodo::full_rlnc_encoder<
+        Field, kodo::disable_trace, kodo::numa_local_allocator<uint8_t> >;
+
+    template<class Field>
+    using numa_local_decoder = kodo::full_rlnc_decoder<
+        Field, kodo::disable_trace, kodo::numa_local_allocator<uint8_t> >;
+
+    /// Standard allocator counting the buffers it allocates
+    template<class T>
+    class counting_allocator : public std::allocator<T>
+    {
+    public:
+
+        template<class U>
+        struct rebind
+        {
+            typedef counting_allocator<U> other;
+        };
+
+        counting_allocator()
+        { }
+
+        template<class U>
+        counting_allocator(const counting_allocator<U>&)
+        { }
+
+        T* allocate(std::size_t n)
+        {
+            ++m_allocations;
+            ++m_allocated;
+            return std::allocator<T>::allocate(n);
+        }
+
+        void deallocate(T* data, std::size_t n)
+        {
+            --m_allocated;
+            std::allocator<T>::deallocate(data, n);
+        }
+
+        /// The number of buffers allocated in total
+        static uint32_t m_allocations;
+
+        /// The number of buffers currently allocated
+        static uint32_t m_allocated;
+    };
+
+    template<class T>
+    uint32_t counting_allocator<T>::m_allocations = 0;
+
+    template<class T>
+    uint32_t counting_allocator<T>::m_allocated = 0;
+
+    /// Allocates a buffer, writes all of it and releases it again
+    template<class Allocator>
+    uint8_t* check_allocate(Allocator& allocator, uint32_t size)
+    {
+        uint8_t* data = allocator.allocate(size);
+        EXPECT_TRUE(data != 0);
+
+        for(uint32_t i = 0; i < size; ++i)
+        {
+            data[i] = (uint8_t) i;
+        }
+
+        for(uint32_t i = 0; i < size; ++i)
+        {
+            EXPECT_EQ((uint8_t) i, data[i]);
+        }
+
+        return data;
+    }
+}
+
+/// Tests that the final_layer uses the standard allocator and that
+/// the storage_allocator layer replaces it
+TEST(TestStorageAllocator, allocator_type)
+{
+    EXPECT_TRUE((std::is_same<kodo::final_layer::allocator_type,
+                 std::allocator<uint8_t> >::value));
+
+    typedef kodo::storage_allocator<
+        kodo::huge_page_allocator<uint8_t>, kodo::final_layer> stack;
+
+    EXPECT_TRUE((std::is_same<stack::allocator_type,
+                 kodo::huge_page_allocator<uint8_t> >::value));
+
+    typedef kodo::full_rlnc_decoder<fifi::binary8, kodo::disable_trace,
+        kodo::numa_local_allocator<uint8_t> > decoder;
+
+    EXPECT_TRUE((std::is_same<decoder::allocator_type,
+                 kodo::numa_local_allocator<uint8_t> >::value));
+}
+
+/// Tests that small buffers and buffers spanning several huge pages
+/// can be allocated and that the large buffers are aligned to a huge
+/// page
+TEST(TestStorageAllocator, huge_page_allocator)
+{
+    typedef kodo::huge_page_allocator<uint8_t> allocator_type;
+    allocator_type allocator;
+
+    uint32_t small_size = 1000;
+    uint32_t large_size = allocator_type::huge_page_size * 2 + 1000;
+
+    uint8_t* small = check_allocate(allocator, small_size);
+    uint8_t* large = check_allocate(allocator, large_size);
+
+    uintptr_t address = reinterpret_cast<uintptr_t>(large);
+    EXPECT_EQ(0U, address % allocator_type::huge_page_size);
+
+    allocator.deallocate(small, small_size);
+    allocator.deallocate(large, large_size);
+}
+
+/// Tests that small and large buffers can be allocated on the node
+/// of the calling thread
+TEST(TestStorageAllocator, numa_local_allocator)
+{
+    typedef kodo::numa_local_allocator<uint8_t> allocator_type;
+    allocator_type allocator;
+
+    uint32_t small_size = 100;
+    uint32_t large_size = 1000000;
+
+    uint8_t* small = check_allocate(allocator, small_size);
+    uint8_t* large = check_allocate(allocator, large_size);
+
+    allocator.deallocate(small, small_size);
+    allocator.deallocate(large, large_size);
+}
+
+/// Tests encoding and decoding with the buffers allocated by the
+/// allocators
+TEST(TestStorageAllocator, test_basic_api)
+{
+    test_basic_api<huge_page_encoder, huge_page_decoder>();
+    test_basic_api<numa_local_encoder, numa_local_decoder>();
+}
+
+/// Tests recoding, where the recoding stack uses the allocator of the
+/// decoder
+TEST(TestStorageAllocator, test_recoding_relay)
+{
+    test_recoding_relay<huge_page_encoder, huge_page_decoder>();
+    test_recoding_relay<numa_local_encoder, numa_local_decoder>();
+}
+
+/// Tests that the buffers of a coder are allocated in one arena, and
+/// that the coefficient vectors moved out of the arena when their
+/// alignment grows are allocated with the same allocator
+TEST(TestStorageAllocator, arena_allocations)
+{
+    typedef counting_allocator<uint8_t> allocator_type;
+
+    typedef kodo::full_rlnc_encoder<fifi::binary8, kodo::disable_trace,
+        allocator_type> encoder_type;
+
+    typedef kodo::full_rlnc_decoder<fifi::binary8, kodo::disable_trace,
+        allocator_type> decoder_type;
+
+    uint32_t symbols = 16;
+    uint32_t symbol_size = 1400;
+
+    allocator_type::m_allocations = 0;
+
+    {
+        encoder_type::factory encoder_factory(symbols, symbol_size);
+        auto encoder = encoder_factory.build();
+
+        EXPECT_EQ(1U, allocator_type::m_allocations);
+        EXPECT_EQ(1U, allocator_type::m_allocated);
+    }
+
+    EXPECT_EQ(0U, allocator_type::m_allocated);
+
+    allocator_type::m_allocations = 0;
+
+    {
+        decoder_type::factory decoder_factory(symbols, symbol_size);
+        auto decoder = decoder_factory.build();
+
+        // The arena of the decoder and of its recoding stack
+        EXPECT_EQ(2U, allocator_type::m_allocations);
+
+        uint32_t alignment = decoder_factory.coefficient_vector_alignment();
+        decoder_factory.set_coefficient_vector_alignment(alignment * 64);
+
+        // The recycled decoder moves its coefficient vectors
+        decoder.reset();
+        decoder = decoder_factory.build();
+
+        EXPECT_EQ(3U, allocator_type::m_allocations);
+
+        uintptr_t address = reinterpret_cast<uintptr_t>(
+            decoder->coefficient_vector_data(0));
+        EXPECT_EQ(0U, address % (alignment * 64));
+    }
+
+    EXPECT_EQ(0U, allocator_type::m_allocated);
+}
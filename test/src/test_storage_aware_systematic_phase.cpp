@@ -7,6 +7,7 @@
 ///       kodo::storage_aware_systematic_phase layer
 
 #include <cstdint>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <kodo/storage_aware_systematic_phase.hpp>
@@ -38,6 +39,14 @@ namespace kodo
                 m_is_symbol_uncoded.resize(m_symbols, false);
             }
 
+            uint8_t* arena_allocate(uint32_t size)
+            {
+                m_arena.push_back(std::vector<uint8_t>(size, 0));
+                return m_arena.back().data();
+            }
+
+            std::vector<std::vector<uint8_t> > m_arena;
+
             void encode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
             {
                 (void) symbol_data;
@@ -7,6 +7,7 @@
 ///       kodo::symbol_decoding_status_counter
 
 #include <cstdint>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <kodo/symbol_decoding_status_tracker.hpp>
@@ -43,7 +44,15 @@ namespace kodo
                 m_symbols = the_factory.symbols();
             }
 
+            uint8_t* arena_allocate(uint32_t size)
+            {
+                m_arena.push_back(std::vector<uint8_t>(size, 0));
+                return m_arena.back().data();
+            }
+
             uint32_t m_symbols;
+
+            std::vector<std::vector<uint8_t> > m_arena;
         };
 
         // Small helper struct which provides the API needed by the
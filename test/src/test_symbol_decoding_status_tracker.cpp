@@ -7,6 +7,7 @@
 ///       kodo::symbol_decoding_status_tracker
 
 #include <cstdint>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <kodo/symbol_decoding_status_tracker.hpp>
@@ -43,7 +44,15 @@ namespace kodo
                 m_symbols = the_factory.symbols();
             }
 
+            uint8_t* arena_allocate(uint32_t size)
+            {
+                m_arena.push_back(std::vector<uint8_t>(size, 0));
+                return m_arena.back().data();
+            }
+
             uint32_t m_symbols;
+
+            std::vector<std::vector<uint8_t> > m_arena;
         };
 
         // Small helper struct which provides the API needed by the
@@ -150,3 +159,76 @@ TEST(TestSymbolDecodingStatusTracker, api)
 
 
 }
+
+/// Test the scans for the next symbol with a given status across
+/// several words of the bitsets
+TEST(TestSymbolDecodingStatusTracker, scan)
+{
+    kodo::test_stack stack;
+
+    kodo::dummy_factory factory;
+    factory.m_symbols = 200;
+
+    stack.construct(factory);
+    stack.initialize(factory);
+
+    uint32_t symbols = stack.symbols();
+
+    // Nothing but missing symbols
+    EXPECT_EQ(0U, stack.next_symbol_missing(0));
+    EXPECT_EQ(199U, stack.next_symbol_missing(199));
+    EXPECT_EQ(symbols, stack.next_symbol_missing(200));
+    EXPECT_EQ(symbols, stack.next_symbol_seen(0));
+    EXPECT_EQ(symbols, stack.next_symbol_uncoded(0));
+    EXPECT_EQ(symbols, stack.next_symbol_pivot(0));
+    EXPECT_EQ(symbols, stack.previous_symbol_pivot(199));
+
+    stack.set_symbol_seen(3);
+    stack.set_symbol_seen(64);
+    stack.set_symbol_uncoded(130);
+    stack.set_symbol_seen(199);
+
+    EXPECT_EQ(3U, stack.next_symbol_seen(0));
+    EXPECT_EQ(3U, stack.next_symbol_seen(3));
+    EXPECT_EQ(64U, stack.next_symbol_seen(4));
+    EXPECT_EQ(199U, stack.next_symbol_seen(65));
+    EXPECT_EQ(symbols, stack.next_symbol_seen(200));
+
+    EXPECT_EQ(130U, stack.next_symbol_uncoded(0));
+    EXPECT_EQ(symbols, stack.next_symbol_uncoded(131));
+
+    EXPECT_EQ(3U, stack.next_symbol_pivot(0));
+    EXPECT_EQ(64U, stack.next_symbol_pivot(4));
+    EXPECT_EQ(130U, stack.next_symbol_pivot(65));
+    EXPECT_EQ(199U, stack.next_symbol_pivot(131));
+
+    EXPECT_EQ(199U, stack.previous_symbol_pivot(199));
+    EXPECT_EQ(130U, stack.previous_symbol_pivot(198));
+    EXPECT_EQ(64U, stack.previous_symbol_pivot(129));
+    EXPECT_EQ(3U, stack.previous_symbol_pivot(63));
+    EXPECT_EQ(symbols, stack.previous_symbol_pivot(2));
+
+    EXPECT_EQ(0U, stack.next_symbol_missing(0));
+    EXPECT_EQ(4U, stack.next_symbol_missing(3));
+    EXPECT_EQ(65U, stack.next_symbol_missing(64));
+    EXPECT_EQ(symbols, stack.next_symbol_missing(199));
+
+    // Re-initializing with fewer symbols clears the status and the
+    // scans stop at the new number of symbols
+    factory.m_symbols = 70;
+    stack.initialize(factory);
+
+    EXPECT_EQ(70U, stack.symbols());
+    EXPECT_EQ(70U, stack.next_symbol_seen(0));
+    EXPECT_EQ(70U, stack.next_symbol_pivot(0));
+    EXPECT_EQ(69U, stack.next_symbol_missing(69));
+    EXPECT_EQ(70U, stack.next_symbol_missing(70));
+
+    for(uint32_t i = 0; i < stack.symbols(); ++i)
+    {
+        stack.set_symbol_uncoded(i);
+    }
+
+    EXPECT_EQ(70U, stack.next_symbol_missing(0));
+    EXPECT_EQ(69U, stack.previous_symbol_pivot(69));
+}
@@ -5,7 +5,9 @@
 
 /// @file test_symbol_storage_xyz.cpp Unit tests for the symbol storage
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -1526,6 +1528,81 @@ namespace
         factory_type m_factory;
 
     };
+
+    /// Tests: Re-initializing a coder for generations of different
+    ///        sizes. Only the part of the storage used by the
+    ///        previous generation is reset, so a larger generation
+    ///        following a smaller one must still start out with no
+    ///        symbols set and, for deep storage, zeroed memory.
+    template<class Coder>
+    struct reinitialize_generation_sizes
+    {
+        typedef typename Coder::factory factory_type;
+
+        reinitialize_generation_sizes(uint32_t max_symbols,
+                                      uint32_t max_symbol_size)
+            : m_factory(max_symbols, max_symbol_size)
+        { }
+
+        void run()
+        {
+            uint32_t max_symbols = m_factory.max_symbols();
+            uint32_t max_symbol_size = m_factory.max_symbol_size();
+
+            auto coder = m_factory.build();
+            fill_and_reinitialize(coder, 1, 1);
+
+            fill_and_reinitialize(coder, max_symbols, max_symbol_size);
+            fill_and_reinitialize(coder, (max_symbols + 1) / 2,
+                                  max_symbol_size);
+            fill_and_reinitialize(coder, max_symbols,
+                                  (max_symbol_size + 1) / 2);
+            fill_and_reinitialize(coder, max_symbols, max_symbol_size);
+        }
+
+        /// Initializes the coder for a generation, checks that it is
+        /// clean and sets all its symbols
+        template<class CoderPointer>
+        void fill_and_reinitialize(CoderPointer& coder, uint32_t symbols,
+                                   uint32_t symbol_size)
+        {
+            m_factory.set_symbols(symbols);
+            m_factory.set_symbol_size(symbol_size);
+
+            coder->initialize(m_factory);
+
+            EXPECT_EQ(symbols, coder->symbols());
+            EXPECT_EQ(0U, coder->symbols_initialized());
+
+            for(uint32_t i = 0; i < coder->symbols(); ++i)
+            {
+                EXPECT_FALSE(coder->is_symbol_initialized(i));
+            }
+
+            if(kodo::has_deep_symbol_storage<Coder>::value)
+            {
+                std::vector<uint8_t> data_out(coder->block_size(), 0xff);
+                coder->copy_symbols(sak::storage(data_out));
+
+                EXPECT_TRUE(std::all_of(data_out.begin(), data_out.end(),
+                    [](uint8_t value) { return value == 0; }));
+            }
+
+            m_data = random_vector(coder->block_size());
+            coder->set_symbols(sak::storage(m_data));
+
+            EXPECT_EQ(symbols, coder->symbols_initialized());
+        }
+
+    private:
+
+        // The factory
+        factory_type m_factory;
+
+        // The data of the current generation
+        std::vector<uint8_t> m_data;
+
+    };
 }
 
 
@@ -1585,6 +1662,8 @@ void run_deep_stack_tests()
     // Other tests
     run_test<Stack, set_partial_data>(
         symbols, symbol_size);
+    run_test<Stack, reinitialize_generation_sizes>(
+        symbols, symbol_size);
 
 }
 
@@ -1641,6 +1720,8 @@ void run_const_shallow_stack_tests()
         symbols, symbol_size);
     run_test<Stack, api_const_shallow_swap_storage_status>(
         symbols, symbol_size);
+    run_test<Stack, reinitialize_generation_sizes>(
+        symbols, symbol_size);
 
 }
 
@@ -1697,6 +1778,8 @@ void run_mutable_shallow_stack_tests()
         symbols, symbol_size);
     run_test<Stack, api_mutable_shallow_swap_storage_status>(
         symbols, symbol_size);
+    run_test<Stack, reinitialize_generation_sizes>(
+        symbols, symbol_size);
 
 
 }
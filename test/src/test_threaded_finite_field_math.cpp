@@ -0,0 +1,210 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_threaded_finite_field_math.cpp Unit tests for the
+///       kodo::threaded_finite_field_math layer and the thread_pool
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/thread_pool.hpp>
+#include <kodo/threaded_finite_field_math.hpp>
+#include <kodo/rlnc/shallow_threaded_full_rlnc_encoder.hpp>
+#include <kodo/rlnc/shallow_threaded_full_rlnc_decoder.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+/// Checks that every task of a job is run exactly once
+TEST(TestThreadedFiniteFieldMath, thread_pool)
+{
+    for(uint32_t threads = 1; threads <= 4; ++threads)
+    {
+        kodo::thread_pool pool(threads);
+        EXPECT_EQ(threads, pool.threads());
+
+        for(uint32_t tasks = 0; tasks < 50; ++tasks)
+        {
+            std::vector< std::atomic<uint32_t> > runs(tasks);
+
+            for(auto& r : runs)
+                r = 0;
+
+            pool.run(tasks, [&runs](uint32_t task) { ++runs[task]; });
+
+            for(auto& r : runs)
+                EXPECT_EQ(1U, r.load());
+        }
+    }
+}
+
+/// Encodes and decodes symbols large enough to be split across the
+/// threads and checks the decoded data
+template<class Field>
+void test_threaded_coders(uint32_t symbols, uint32_t symbol_size,
+                          uint32_t threads)
+{
+    typedef kodo::shallow_threaded_full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::shallow_threaded_full_rlnc_decoder<Field> decoder_type;
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+
+    EXPECT_EQ(1U, encoder_factory.threads());
+    EXPECT_EQ(1U, decoder_factory.threads());
+
+    encoder_factory.set_threads(threads);
+    decoder_factory.set_threads(threads);
+
+    EXPECT_EQ(threads, encoder_factory.threads());
+    EXPECT_EQ(threads, decoder_factory.threads());
+
+    auto encoder = encoder_factory.build();
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+
+    encoder->set_symbols(sak::storage(data_in));
+    decoder->set_symbols(sak::storage(data_out));
+
+    encoder->set_systematic_off();
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    while(!decoder->is_complete())
+    {
+        encoder->encode(&payload[0]);
+        decoder->decode(&payload[0]);
+    }
+
+    EXPECT_EQ(data_in, data_out);
+}
+
+TEST(TestThreadedFiniteFieldMath, coders)
+{
+    test_threaded_coders<fifi::binary>(8, 65536, 4);
+    test_threaded_coders<fifi::binary8>(8, 65536, 4);
+    test_threaded_coders<fifi::binary8>(4, 100000, 3);
+    test_threaded_coders<fifi::binary16>(8, 65536, 2);
+
+    // Symbols too small to be split
+    test_threaded_coders<fifi::binary8>(16, 1600, 4);
+}
+
+/// Encodes batches of symbols large enough for the tiles to be split
+/// across the threads and checks the decoded data
+template<class Field>
+void test_threaded_encode_batch(uint32_t symbols, uint32_t symbol_size,
+                                uint32_t threads, uint32_t batch_size)
+{
+    typedef kodo::shallow_threaded_full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::shallow_threaded_full_rlnc_decoder<Field> decoder_type;
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+
+    encoder_factory.set_threads(threads);
+
+    auto encoder = encoder_factory.build();
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+
+    encoder->set_symbols(sak::storage(data_in));
+    decoder->set_symbols(sak::storage(data_out));
+
+    encoder->set_systematic_off();
+
+    std::vector<std::vector<uint8_t> > payloads(batch_size);
+    std::vector<uint8_t*> batch(batch_size);
+
+    for(uint32_t i = 0; i < batch_size; ++i)
+    {
+        payloads[i].resize(encoder->payload_size());
+        batch[i] = &payloads[i][0];
+    }
+
+    while(!decoder->is_complete())
+    {
+        encoder->encode_batch(&batch[0], batch_size, 0);
+
+        for(uint32_t i = 0; i < batch_size && !decoder->is_complete(); ++i)
+        {
+            decoder->decode(batch[i]);
+        }
+    }
+
+    EXPECT_EQ(data_in, data_out);
+}
+
+TEST(TestThreadedFiniteFieldMath, encode_batch)
+{
+    test_threaded_encode_batch<fifi::binary>(8, 65536, 4, 4);
+    test_threaded_encode_batch<fifi::binary8>(8, 100000, 3, 5);
+    test_threaded_encode_batch<fifi::binary16>(6, 65536, 2, 3);
+}
+
+/// Checks that the threaded multiply_add_n() and multiply_subtract_n()
+/// give the same result as the single source operations, using the
+/// source pointers reserved for each task
+TEST(TestThreadedFiniteFieldMath, multiply_add_n)
+{
+    typedef fifi::binary8 field_type;
+    typedef kodo::shallow_threaded_full_rlnc_decoder<field_type> decoder_type;
+    typedef field_type::value_type value_type;
+
+    uint32_t symbols = 6;
+    uint32_t symbol_size = 100000;
+
+    typename decoder_type::factory factory(symbols, symbol_size);
+    factory.set_threads(4);
+
+    auto decoder = factory.build();
+
+    std::vector<std::vector<uint8_t> > sources(symbols);
+    std::vector<const value_type*> source_pointers;
+    std::vector<value_type> coefficients;
+
+    for(auto& source : sources)
+    {
+        source = random_vector(symbol_size);
+        source_pointers.push_back(&source[0]);
+        coefficients.push_back(rand_nonzero(255));
+    }
+
+    std::vector<uint8_t> dest = random_vector(symbol_size);
+
+    // Run twice so the reserved source pointers are reused
+    for(uint32_t run = 0; run < 2; ++run)
+    {
+        std::vector<uint8_t> expected = dest;
+
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            decoder->multiply_add(&expected[0], source_pointers[i],
+                                  coefficients[i], symbol_size);
+        }
+
+        decoder->multiply_add_n(&dest[0], &source_pointers[0],
+                                &coefficients[0], symbols, symbol_size);
+
+        EXPECT_EQ(expected, dest);
+
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            decoder->multiply_subtract(&expected[0], source_pointers[i],
+                                       coefficients[i], symbol_size);
+        }
+
+        decoder->multiply_subtract_n(&dest[0], &source_pointers[0],
+                                     &coefficients[0], symbols, symbol_size);
+
+        EXPECT_EQ(expected, dest);
+    }
+}
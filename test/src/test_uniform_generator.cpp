@@ -54,6 +54,24 @@ namespace kodo
         public:
             using factory = basic_factory<uniform_generator_stack_pool>;
         };
+
+        // Fast uniform generator
+        template<class Field>
+        class fast_uniform_generator_stack :
+            public fast_uniform_generator<
+                   pivot_aware_generator<
+                   fake_codec_layer<
+                   coefficient_info<
+                   fake_symbol_storage<
+                   storage_block_length<
+                   storage_block_size<
+                   finite_field_info<Field,
+                   final_layer
+                   > > > > > > > >
+        {
+        public:
+            using factory = basic_factory<fast_uniform_generator_stack>;
+        };
     }
 }
 
@@ -72,3 +90,15 @@ TEST(TestCoefficientGenerator, test_uniform_generator_stack)
         kodo::uniform_generator_stack_pool,
         api_generate>(symbols, symbol_size);
 }
+
+/// Run the tests typical coefficients stack
+TEST(TestCoefficientGenerator, test_fast_uniform_generator_stack)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    // API tests:
+    run_test<
+        kodo::fast_uniform_generator_stack,
+        api_generate>(symbols, symbol_size);
+}
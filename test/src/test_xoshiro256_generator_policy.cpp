@@ -0,0 +1,102 @@
+// Copyright Steinwurf ApS 2011.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_xoshiro256_generator_policy.cpp Unit tests for the
+///       xoshiro256_generator_policy
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/xoshiro256_generator_policy.hpp>
+
+/// Checks that the values only depend on the seed
+TEST(TestXoshiro256GeneratorPolicy, seed)
+{
+    kodo::xoshiro256_generator_policy policy;
+
+    // Sizes which are not a multiple of the word size are filled
+    std::vector<uint8_t> a(21, 0);
+    std::vector<uint8_t> b(21, 0);
+    std::vector<uint8_t> c(21, 0);
+
+    policy.seed(7);
+    policy.generate(&a[0], (uint32_t) a.size());
+
+    policy.seed(7);
+    policy.generate(&b[0], (uint32_t) b.size());
+
+    policy.seed(8);
+    policy.generate(&c[0], (uint32_t) c.size());
+
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+
+    // The last partial word is filled too
+    EXPECT_NE(std::vector<uint8_t>(a.begin() + 16, a.end()),
+              std::vector<uint8_t>(5, 0));
+}
+
+/// Checks that the values are within the range and all values of a
+/// small range are drawn
+TEST(TestXoshiro256GeneratorPolicy, generate_value)
+{
+    kodo::xoshiro256_generator_policy policy;
+
+    std::vector<uint32_t> counts(11, 0);
+
+    for (uint32_t i = 0; i < 11000; ++i)
+    {
+        uint8_t value = policy.generate_value<uint8_t>(5, 15);
+        ASSERT_GE(value, 5);
+        ASSERT_LE(value, 15);
+        ++counts[value - 5];
+    }
+
+    for (uint32_t count : counts)
+    {
+        EXPECT_GT(count, 800U);
+        EXPECT_LT(count, 1200U);
+    }
+
+    EXPECT_EQ(3U, policy.generate_value<uint32_t>(3, 3));
+
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        uint32_t value = policy.generate_value<uint32_t>(1, 4294967290U);
+        ASSERT_GE(value, 1U);
+        ASSERT_LE(value, 4294967290U);
+    }
+}
+
+/// Checks the number of bits set in the masks for different densities
+TEST(TestXoshiro256GeneratorPolicy, generate_mask)
+{
+    kodo::xoshiro256_generator_policy policy;
+
+    double densities[] = { 0.01, 0.2, 0.5, 0.9, 1.0 };
+    uint32_t count = 10001;
+
+    for (double density : densities)
+    {
+        std::vector<uint8_t> mask((count + 7) / 8, 0xff);
+        policy.generate_mask(&mask[0], count, density);
+
+        uint32_t set = 0;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            set += (mask[i / 8] >> (i % 8)) & 1;
+        }
+
+        double expected = density * count;
+        EXPECT_NEAR(expected, set, 5 * std::sqrt(expected) + 1);
+
+        // The bits after the last one are zero
+        EXPECT_EQ(0, mask.back() >> (count % 8));
+    }
+}